@@ -433,6 +433,11 @@ void Agent::executeScript() {
             AvatarData::fromFrame(frame->data, *scriptedAvatar);
         });
 
+        static const FrameType AVATAR_SKELETON_FRAME_TYPE = Frame::registerFrameType(AvatarData::SKELETON_FRAME_NAME);
+        Frame::registerFrameHandler(AVATAR_SKELETON_FRAME_TYPE, [scriptedAvatar](Frame::ConstPointer frame) {
+            AvatarData::fromSkeletonFrame(frame->data, *scriptedAvatar);
+        });
+
         using namespace recording;
         static const FrameType AUDIO_FRAME_TYPE = Frame::registerFrameType(AudioConstants::getAudioFrameName());
         Frame::registerFrameHandler(AUDIO_FRAME_TYPE, [this, &player, &scriptedAvatar](Frame::ConstPointer frame) {
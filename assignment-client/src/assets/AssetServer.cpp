@@ -25,6 +25,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QTimer>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -38,6 +39,7 @@
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
 #include "SendAssetTask.h"
+#include "UploadAssetChunkTask.h"
 #include "UploadAssetTask.h"
 
 static const uint8_t MIN_CORES_FOR_MULTICORE = 4;
@@ -308,7 +310,8 @@ AssetServer::AssetServer(ReceivedMessage& message) :
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation },
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload,
+                                              PacketType::AssetUploadChunk, PacketType::AssetMappingOperation },
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::queueRequests));
 
 #ifdef Q_OS_WIN
@@ -364,6 +367,8 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_UPLOADS_SUBDIR = "uploads";
+static const int ABANDONED_UPLOADS_CHECK_INTERVAL_MS = 60 * 60 * 1000;
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -425,6 +430,23 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    QDir uploadsDirectory = _resourcesDirectory;
+    if (!_resourcesDirectory.mkpath(ASSET_UPLOADS_SUBDIR) || !uploadsDirectory.cd(ASSET_UPLOADS_SUBDIR)) {
+        qCCritical(asset_server) << "Unable to create upload directory for asset-server files. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+    _partialUploads = std::make_shared<PartialAssetUploads>(uploadsDirectory, _filesDirectory);
+
+    // The asset server can run for weeks, so keep removing uploads that were abandoned since it started
+    QTimer* abandonedUploadsTimer = new QTimer(this);
+    connect(abandonedUploadsTimer, &QTimer::timeout, this, [this] {
+        _partialUploads->removeAbandonedUploads();
+    });
+    abandonedUploadsTimer->setInterval(ABANDONED_UPLOADS_CHECK_INTERVAL_MS);
+    abandonedUploadsTimer->setTimerType(Qt::CoarseTimer);
+    abandonedUploadsTimer->start();
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -471,6 +493,8 @@ void AssetServer::completeSetup() {
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGetInfo));
     packetReceiver.registerListener(PacketType::AssetUpload,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
+    packetReceiver.registerListener(PacketType::AssetUploadChunk,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUploadChunk));
     packetReceiver.registerListener(PacketType::AssetMappingOperation,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetMappingOperation));
 
@@ -512,6 +536,9 @@ void AssetServer::replayRequests() {
             case PacketType::AssetUpload:
                 handleAssetUpload(request.first, request.second);
                 break;
+            case PacketType::AssetUploadChunk:
+                handleAssetUploadChunk(request.first, request.second);
+                break;
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
@@ -877,39 +904,54 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
 }
 
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (canWriteToAssetServer(*message, senderNode, PacketType::AssetUploadReply)) {
+        qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
+
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        _transferTaskPool.start(task);
+    }
+}
+
+void AssetServer::handleAssetUploadChunk(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (canWriteToAssetServer(*message, senderNode, PacketType::AssetUploadChunkReply)) {
+        auto task = new UploadAssetChunkTask(message, senderNode, _partialUploads, _filesizeLimit);
+        _transferTaskPool.start(task);
+    }
+}
+
+bool AssetServer::canWriteToAssetServer(ReceivedMessage& message, const SharedNodePointer& senderNode, PacketType replyType) {
     bool canWriteToAssetServer = true;
     if (senderNode) {
         canWriteToAssetServer = senderNode->getCanWriteToAssetServer();
     }
 
-
-    if (canWriteToAssetServer) {
-        qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
-
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
-        _transferTaskPool.start(task);
-    } else {
+    if (!canWriteToAssetServer) {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
         // so return a packet with error that indicates that
 
-        auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
+        auto permissionErrorPacket = NLPacket::create(replyType, -1, true);
 
         MessageID messageID;
-        message->readPrimitive(&messageID);
+        message.readPrimitive(&messageID);
 
         // write the message ID and a permission denied error
         permissionErrorPacket->writePrimitive(messageID);
         permissionErrorPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+        if (replyType == PacketType::AssetUploadChunkReply) {
+            // nothing of the upload was received
+            permissionErrorPacket->writePrimitive(uint64_t(0));
+        }
 
         // send off the packet
         auto nodeList = DependencyManager::get<NodeList>();
         if (senderNode) {
             nodeList->sendPacket(std::move(permissionErrorPacket), *senderNode);
         } else {
-            nodeList->sendPacket(std::move(permissionErrorPacket), message->getSenderSockAddr());
+            nodeList->sendPacket(std::move(permissionErrorPacket), message.getSenderSockAddr());
         }
     }
+    return canWriteToAssetServer;
 }
 
 void AssetServer::sendStatsPacket() {
@@ -69,6 +69,7 @@ struct AssetMeta {
 };
 
 class BakeAssetTask;
+class PartialAssetUploads;
 
 class AssetServer : public ThreadedAssignment {
     Q_OBJECT
@@ -87,6 +88,7 @@ private slots:
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetUploadChunk(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void sendStatsPacket() override;
@@ -94,6 +96,8 @@ private slots:
 private:
     void replayRequests();
 
+    bool canWriteToAssetServer(ReceivedMessage& message, const SharedNodePointer& senderNode, PacketType replyType);
+
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleGetAllMappingOperation(NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
@@ -153,6 +157,8 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    std::shared_ptr<PartialAssetUploads> _partialUploads;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
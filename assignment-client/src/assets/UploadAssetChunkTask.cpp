@@ -0,0 +1,71 @@
+//
+//  UploadAssetChunkTask.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadAssetChunkTask.h"
+
+#include <NodeList.h>
+#include <NLPacket.h>
+
+#include "ClientServerUtils.h"
+
+UploadAssetChunkTask::UploadAssetChunkTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
+                                           std::shared_ptr<PartialAssetUploads> partialUploads, uint64_t filesizeLimit) :
+    _receivedMessage(receivedMessage),
+    _senderNode(senderNode),
+    _partialUploads(partialUploads),
+    _filesizeLimit(filesizeLimit)
+{
+}
+
+void UploadAssetChunkTask::run() {
+    MessageID messageID;
+    _receivedMessage->readPrimitive(&messageID);
+
+    auto uploadID = QUuid::fromRfc4122(_receivedMessage->read(NUM_BYTES_RFC4122_UUID));
+    auto expectedHash = _receivedMessage->read(AssetUtils::SHA256_HASH_LENGTH);
+
+    uint64_t size;
+    _receivedMessage->readPrimitive(&size);
+
+    uint64_t offset;
+    _receivedMessage->readPrimitive(&offset);
+
+    auto chunk = _receivedMessage->readWithoutCopy(_receivedMessage->getBytesLeftToRead());
+
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadChunkReply, -1, true);
+    replyPacket->writePrimitive(messageID);
+
+    if (size > _filesizeLimit) {
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+        replyPacket->writePrimitive(uint64_t(0));
+    } else {
+        uint64_t bytesReceived { 0 };
+        QByteArray hash;
+        auto error = _partialUploads->receiveChunk(uploadID, expectedHash, size, offset, chunk, bytesReceived, hash);
+
+        replyPacket->writePrimitive(error);
+        replyPacket->writePrimitive(bytesReceived);
+        if (error == AssetUtils::AssetServerError::NoError && bytesReceived == size) {
+            if (_senderNode) {
+                qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hash.toHex() << ")";
+            } else {
+                qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hash.toHex() << ")";
+            }
+            replyPacket->write(hash);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+    } else {
+        nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
+    }
+}
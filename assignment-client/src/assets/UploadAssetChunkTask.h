@@ -0,0 +1,39 @@
+//
+//  UploadAssetChunkTask.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UploadAssetChunkTask_h
+#define hifi_UploadAssetChunkTask_h
+
+#include <memory>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include <PartialAssetUploads.h>
+
+#include "ReceivedMessage.h"
+
+class Node;
+
+class UploadAssetChunkTask : public QRunnable {
+public:
+    UploadAssetChunkTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                         std::shared_ptr<PartialAssetUploads> partialUploads, uint64_t filesizeLimit);
+
+    void run() override;
+
+private:
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    QSharedPointer<Node> _senderNode;
+    std::shared_ptr<PartialAssetUploads> _partialUploads;
+    uint64_t _filesizeLimit;
+};
+
+#endif // hifi_UploadAssetChunkTask_h
@@ -348,6 +348,8 @@ AvatarAudioStream* AudioMixerClientData::getAvatarAudioStream() {
 }
 
 void AudioMixerClientData::removeAgentAvatarAudioStream() {
+    _sourceBlocks.erase(getAvatarAudioStream());
+
     auto it = std::remove_if(_audioStreams.begin(), _audioStreams.end(), [](const SharedStreamPointer& stream){
         return stream->getStreamIdentifier().isNull();
     });
@@ -543,7 +545,9 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
 
     if (newStream) {
         // whenever a stream is added, push it to the concurrent vector of streams added this frame
-        addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), matchingStream->getStreamIdentifier(), matchingStream.get()));
+        const SourceBlock* sourceBlock = &_sourceBlocks[matchingStream.get()];
+        addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), matchingStream->getStreamIdentifier(),
+                                           matchingStream.get(), sourceBlock));
     }
 }
 
@@ -556,6 +560,9 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
 
+        // decode and prepare this stream's frame once, for every listener that will mix it
+        prepareSourceBlock(*stream, _sourceBlocks[stream.get()]);
+
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
 
         // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
@@ -568,6 +575,7 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
             emit injectorStreamFinished(stream->getStreamIdentifier());
 
             // erase the stream to drop our ref to the shared pointer and remove it
+            _sourceBlocks.erase(stream.get());
             it = _audioStreams.erase(it);
         } else {
             ++it;
@@ -577,6 +585,39 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
     return (int)_audioStreams.size();
 }
 
+const AudioMixerClientData::SourceBlock* AudioMixerClientData::getSourceBlock(const PositionalAudioStream* stream) const {
+    auto it = _sourceBlocks.find(stream);
+    return it != _sourceBlocks.end() ? &it->second : nullptr;
+}
+
+void AudioMixerClientData::prepareSourceBlock(const PositionalAudioStream& stream, SourceBlock& block) {
+    block.trailingLoudness = stream.getLastPopOutputTrailingLoudness();
+    block.gain = 1.0f;
+    block.hasSamples = false;
+    block.isSilent = !stream.lastPopSucceeded() || stream.getLastPopOutputLoudness() == 0.0f;
+
+    if (!stream.lastPopSucceeded()) {
+        // in an injector, just go silent - the injector has likely ended
+        // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
+        if (stream.getLastPopOutput().isNull() || stream.getType() == PositionalAudioStream::Injector) {
+            return;
+        }
+
+        // calculate its fade factor, which depends on how many times it's already been repeated.
+        float fadeFactor = calculateRepeatedFrameFadeFactor(stream.getConsecutiveNotMixedCount() - 1);
+        if (fadeFactor <= 0.0f) {
+            return;
+        }
+        block.gain = fadeFactor;
+    }
+
+    // grab the frame from the ring buffer
+    AudioRingBuffer::ConstIterator streamPopOutput = stream.getLastPopOutput();
+    streamPopOutput.readSamples(block.samples, stream.isStereo() ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
+                                                                 : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    block.hasSamples = true;
+}
+
 void AudioMixerClientData::parseStopInjectorPacket(QSharedPointer<ReceivedMessage> packet) {
     auto streamID = QUuid::fromRfc4122(packet->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
@@ -585,6 +626,7 @@ void AudioMixerClientData::parseStopInjectorPacket(QSharedPointer<ReceivedMessag
     });
 
     if (it != std::end(_audioStreams)) {
+        _sourceBlocks.erase(it->get());
         _audioStreams.erase(it);
         emit injectorStreamFinished(streamID);
     }
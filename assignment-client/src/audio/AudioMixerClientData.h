@@ -13,6 +13,7 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <unordered_map>
 
 #if !defined(Q_MOC_RUN)
 // Work around https://bugreports.qt.io/browse/QTBUG-80990
@@ -22,6 +23,7 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioConstants.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -35,13 +37,24 @@
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
 public:
+    // The frame of a source stream that listeners mix, prepared once per frame by the client that owns the stream
+    // so that the mixing of every listener can read it without going back to the stream's ring buffer
+    struct SourceBlock {
+        alignas(16) int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        float trailingLoudness { 0.0f };
+        float gain { 1.0f }; // fade for a repeated frame, when the last pop failed
+        bool hasSamples { false }; // false when listeners should only flush their HRTF with a silent block
+        bool isSilent { true }; // the stream has nothing new to mix this frame
+    };
+
     struct AddedStream {
         NodeIDStreamID nodeIDStreamID;
         PositionalAudioStream* positionalStream;
+        const SourceBlock* sourceBlock;
 
-        AddedStream(QUuid nodeID, Node::LocalID localNodeID,
-                    StreamID streamID, PositionalAudioStream* positionalStream) :
-            nodeIDStreamID(nodeID, localNodeID, streamID), positionalStream(positionalStream) {};
+        AddedStream(QUuid nodeID, Node::LocalID localNodeID, StreamID streamID,
+                    PositionalAudioStream* positionalStream, const SourceBlock* sourceBlock) :
+            nodeIDStreamID(nodeID, localNodeID, streamID), positionalStream(positionalStream), sourceBlock(sourceBlock) {};
     };
 
     using ConcurrentAddedStreams = tbb::concurrent_vector<AddedStream>;
@@ -56,6 +69,7 @@ public:
     int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
+    const SourceBlock* getSourceBlock(const PositionalAudioStream* stream) const;
     AvatarAudioStream* getAvatarAudioStream();
 
     void removeAgentAvatarAudioStream();
@@ -121,13 +135,18 @@ public:
         NodeIDStreamID nodeStreamID;
         std::unique_ptr<AudioHRTF> hrtf;
         PositionalAudioStream* positionalStream;
+        const SourceBlock* sourceBlock;
         bool ignoredByListener { false };
         bool ignoringListener { false };
 
-        MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
-            nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
-        MixableStream(QUuid nodeID, Node::LocalID localNodeID, StreamID streamID, PositionalAudioStream* positionalStream) :
-            nodeStreamID(nodeID, localNodeID, streamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
+        MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream,
+                      const SourceBlock* sourceBlock) :
+            nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream),
+            sourceBlock(sourceBlock) {};
+        MixableStream(QUuid nodeID, Node::LocalID localNodeID, StreamID streamID, PositionalAudioStream* positionalStream,
+                      const SourceBlock* sourceBlock) :
+            nodeStreamID(nodeID, localNodeID, streamID), hrtf(new AudioHRTF), positionalStream(positionalStream),
+            sourceBlock(sourceBlock) {};
     };
 
     using MixableStreamsVector = std::vector<MixableStream>;
@@ -179,6 +198,10 @@ private:
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
+    // the source block for each of our streams, node based so listeners can hold on to pointers to the blocks
+    std::unordered_map<const PositionalAudioStream*, SourceBlock> _sourceBlocks;
+    void prepareSourceBlock(const PositionalAudioStream& stream, SourceBlock& block);
+
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
 
     void setGainForAvatar(QUuid nodeID, float gain);
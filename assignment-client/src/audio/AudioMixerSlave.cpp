@@ -196,14 +196,16 @@ void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerD
 
                     if (ignoredByListener || ignoringListener) {
                         streams.skipped.emplace_back(node->getUUID(), node->getLocalID(),
-                                                    stream->getStreamIdentifier(), stream.get());
+                                                    stream->getStreamIdentifier(), stream.get(),
+                                                    nodeData->getSourceBlock(stream.get()));
 
                         // pre-populate ignored and ignoring flags for this stream
                         streams.skipped.back().ignoredByListener = ignoredByListener;
                         streams.skipped.back().ignoringListener = ignoringListener;
                     } else {
                         streams.active.emplace_back(node->getUUID(), node->getLocalID(),
-                                                     stream->getStreamIdentifier(), stream.get());
+                                                     stream->getStreamIdentifier(), stream.get(),
+                                                     nodeData->getSourceBlock(stream.get()));
                     }
                 }
             }
@@ -217,13 +219,13 @@ void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerD
             bool ignoringListener = contains(ignoringNodeIDs, newStream.nodeIDStreamID.nodeID);
 
             if (ignoredByListener || ignoringListener) {
-                streams.skipped.emplace_back(newStream.nodeIDStreamID, newStream.positionalStream);
+                streams.skipped.emplace_back(newStream.nodeIDStreamID, newStream.positionalStream, newStream.sourceBlock);
 
                 // pre-populate ignored and ignoring flags for this stream
                 streams.skipped.back().ignoredByListener = ignoredByListener;
                 streams.skipped.back().ignoringListener = ignoringListener;
             } else {
-                streams.active.emplace_back(newStream.nodeIDStreamID, newStream.positionalStream);
+                streams.active.emplace_back(newStream.nodeIDStreamID, newStream.positionalStream, newStream.sourceBlock);
             }
         }
     }
@@ -235,8 +237,7 @@ bool shouldBeRemoved(const MixableStream& stream, const AudioMixerSlave::SharedD
 };
 
 bool shouldBeInactive(MixableStream& stream) {
-    return (!stream.positionalStream->lastPopSucceeded() ||
-            stream.positionalStream->getLastPopOutputLoudness() == 0.0f);
+    return stream.sourceBlock->isSilent;
 };
 
 bool shouldBeSkipped(MixableStream& stream, const Node& listener,
@@ -287,7 +288,8 @@ bool shouldBeSkipped(MixableStream& stream, const Node& listener,
 };
 
 float approximateVolume(const MixableStream& stream, const AvatarAudioStream* listenerAudioStream) {
-    if (stream.positionalStream->getLastPopOutputTrailingLoudness() == 0.0f) {
+    float trailingLoudness = stream.sourceBlock->trailingLoudness;
+    if (trailingLoudness == 0.0f) {
         return 0.0f;
     }
 
@@ -303,7 +305,7 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
         gain *= stream.hrtf->getGainAdjustment();
     }
 
-    return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
+    return trailingLoudness * gain;
 };
 
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
@@ -357,15 +359,19 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         }
 
         if (!shouldBeInactive(stream)) {
+            // the HRTF parameters of a silent source are left alone while it is inactive,
+            // catch them up now so that its first block does not interpolate from stale ones
+            if (!isThrottling) {
+                updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
+                                     listenerData->getMasterInjectorGain());
+            }
             streams.active.push_back(move(stream));
             ++stats.inactiveToActive;
             return true;
         }
 
-        if (!isThrottling) {
-            updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
-                                 listenerData->getMasterInjectorGain());
-        }
+        // the HRTF tail of this source was flushed when it went silent, there is nothing else to do for it
+        ++stats.hrtfSilentSkips;
         return false;
     });
 
@@ -512,64 +518,41 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
     const int HRTF_DATASET_INDEX = 1;
 
-    if (!streamToAdd->lastPopSucceeded()) {
-        bool forceSilentBlock = true;
-
-        if (!streamToAdd->getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
-
-            // in an injector, just go silent - the injector has likely ended
-            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
-            if (!isInjector) {
-                // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd->getConsecutiveNotMixedCount() - 1);
-                if (fadeFactor > 0.0f) {
-                    // apply the fadeFactor to the gain
-                    gain *= fadeFactor;
-                    forceSilentBlock = false;
-                }
-            }
-        }
+    // the source block was decoded and prepared once for all listeners by the client that owns the stream
+    const auto& sourceBlock = *mixableStream.sourceBlock;
 
-        if (forceSilentBlock) {
-            // call renderSilent with a forced silent block to reduce artifacts
-            // (this is not done for stereo streams since they do not go through the HRTF)
-            if (!streamToAdd->isStereo() && !isEcho) {
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    if (!sourceBlock.hasSamples) {
+        // call renderSilent with a forced silent block to reduce artifacts
+        // (this is not done for stereo streams since they do not go through the HRTF)
+        if (!streamToAdd->isStereo() && !isEcho) {
+            static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+            mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-                ++stats.hrtfRenders;
-            }
-
-            return;
+            ++stats.hrtfRenders;
         }
+
+        return;
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
+    // apply the fade of a repeated frame
+    gain *= sourceBlock.gain;
 
     if (streamToAdd->isStereo()) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
-
         // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixStereo(sourceBlock.samples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
         // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixMono(sourceBlock.samples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
     } else {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+        mixableStream.hrtf->render(sourceBlock.samples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         ++stats.hrtfRenders;
     }
@@ -26,6 +26,7 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
+    int hrtfSilentSkips { 0 };
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
@@ -17,10 +17,14 @@
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
+// a recipient's batch is sent early once it gets this big
+const int MAX_PENDING_MESSAGES_BYTES = 64 * 1024;
 
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
@@ -35,39 +39,96 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto killedNodeID = killedNode->getUUID();
+    for (const auto& channel : _subscriberChannels.take(killedNodeID)) {
+        auto itr = _channelSubscribers.find(channel);
+        if (itr != _channelSubscribers.end()) {
+            itr->remove(killedNodeID);
+            if (itr->isEmpty()) {
+                _channelSubscribers.erase(itr);
+            }
+        }
     }
+    _pendingMessages.remove(killedNodeID);
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
     auto senderUUID = senderNode->getUUID();
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-
     auto nodeList = DependencyManager::get<NodeList>();
 
-    auto itr = _allSubscribers.find(senderUUID);
-    if (itr == _allSubscribers.end()) {
-        _allSubscribers[senderUUID] = 1;
-    } else if (*itr >= _maxMessagesPerSecond) {
+    while (receivedMessage->getBytesLeftToRead() > 0) {
+        QString channel, message;
+        QByteArray data;
+        QUuid senderID;
+        bool isText;
+        MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+
+        auto itr = _allSubscribers.find(senderUUID);
+        if (itr == _allSubscribers.end()) {
+            _allSubscribers[senderUUID] = 1;
+        } else if (*itr >= _maxMessagesPerSecond) {
+            break;
+        } else {
+            *itr += 1;
+        }
+
+        // encode the message once, then queue it for each subscriber that can be sent to
+        QByteArray encodedMessage = MessagesClient::encodeMessage(channel, isText, isText ? message.toUtf8() : data, senderID);
+
+        ChannelStats& channelStats = _channelStats[channel];
+        channelStats.messagesIn++;
+        channelStats.bytesIn += encodedMessage.size();
+
+        auto subscribers = _channelSubscribers.find(channel);
+        if (subscribers == _channelSubscribers.end()) {
+            continue;
+        }
+        for (const auto& subscriberID : *subscribers) {
+            auto node = nodeList->nodeWithUUID(subscriberID);
+            if (!node || !node->getActiveSocket()) {
+                continue;
+            }
+
+            QByteArray& pendingMessages = _pendingMessages[subscriberID];
+            pendingMessages.append(encodedMessage);
+            channelStats.messagesOut++;
+            channelStats.bytesOut += encodedMessage.size();
+
+            if (pendingMessages.size() >= MAX_PENDING_MESSAGES_BYTES) {
+                sendPendingMessagesToNode(subscriberID, pendingMessages);
+            }
+        }
+    }
+
+    if (!_sendPendingMessagesQueued && !_pendingMessages.isEmpty()) {
+        // the messages that arrive before the event loop comes back around go out together
+        _sendPendingMessagesQueued = true;
+        QMetaObject::invokeMethod(this, &MessagesMixer::sendPendingMessages, Qt::QueuedConnection);
+    }
+}
+
+void MessagesMixer::sendPendingMessages() {
+    _sendPendingMessagesQueued = false;
+    for (auto itr = _pendingMessages.begin(); itr != _pendingMessages.end(); ++itr) {
+        sendPendingMessagesToNode(itr.key(), itr.value());
+    }
+    _pendingMessages.clear();
+}
+
+void MessagesMixer::sendPendingMessagesToNode(const QUuid& nodeID, QByteArray& pendingMessages) {
+    if (pendingMessages.isEmpty()) {
         return;
-    } else {
-        *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto node = nodeList->nodeWithUUID(nodeID);
+    if (node && node->getActiveSocket()) {
+        auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+        packetList->write(pendingMessages);
         nodeList->sendPacketList(std::move(packetList), *node);
-    });
+        _packetListsOut++;
+    }
+    pendingMessages.clear();
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -75,14 +136,26 @@ void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> mess
     QString channel = QString::fromUtf8(message->getMessage());
 
     _channelSubscribers[channel] << senderUUID;
+    _subscriberChannels[senderUUID] << channel;
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
+    auto itr = _channelSubscribers.find(channel);
+    if (itr != _channelSubscribers.end()) {
+        itr->remove(senderUUID);
+        if (itr->isEmpty()) {
+            _channelSubscribers.erase(itr);
+        }
+    }
+    auto channels = _subscriberChannels.find(senderUUID);
+    if (channels != _subscriberChannels.end()) {
+        channels->remove(channel);
+        if (channels->isEmpty()) {
+            _subscriberChannels.erase(channels);
+        }
     }
 }
 
@@ -99,6 +172,38 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // per channel throughput since the last stats packet
+    quint64 now = usecTimestampNow();
+    float elapsedSeconds = _statsStartTime == 0 ? 0.0f : (float)(now - _statsStartTime) / (float)USECS_PER_SECOND;
+    auto perSecond = [&](quint64 count) {
+        return elapsedSeconds > 0.0f ? (double)count / elapsedSeconds : 0.0;
+    };
+
+    QJsonObject channelsObject;
+    quint64 totalMessagesOut = 0;
+    for (auto itr = _channelStats.cbegin(); itr != _channelStats.cend(); ++itr) {
+        const ChannelStats& channelStats = itr.value();
+        QJsonObject channelObject;
+        channelObject["subscribers"] = _channelSubscribers.value(itr.key()).size();
+        channelObject["messages_in_per_second"] = perSecond(channelStats.messagesIn);
+        channelObject["inbound_kbps"] = perSecond(channelStats.bytesIn) / BYTES_PER_KILOBIT;
+        channelObject["messages_out_per_second"] = perSecond(channelStats.messagesOut);
+        channelObject["outbound_kbps"] = perSecond(channelStats.bytesOut) / BYTES_PER_KILOBIT;
+        channelsObject[itr.key()] = channelObject;
+        totalMessagesOut += channelStats.messagesOut;
+    }
+    statsObject["channels"] = channelsObject;
+
+    QJsonObject fanOutObject;
+    fanOutObject["messages_out_per_second"] = perSecond(totalMessagesOut);
+    fanOutObject["packets_out_per_second"] = perSecond(_packetListsOut);
+    fanOutObject["messages_per_packet"] = _packetListsOut > 0 ? (double)totalMessagesOut / _packetListsOut : 0.0;
+    statsObject["fan_out"] = fanOutObject;
+
+    _channelStats.clear();
+    _packetListsOut = 0;
+    _statsStartTime = now;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -39,10 +39,30 @@ private slots:
     void stopMaxMessagesProcessor();
     void processMaxMessagesContainer();
 
+    void sendPendingMessages();
+
 private:
+    void sendPendingMessagesToNode(const QUuid& nodeID, QByteArray& pendingMessages);
+
+    struct ChannelStats {
+        quint64 messagesIn { 0 };
+        quint64 bytesIn { 0 };
+        quint64 messagesOut { 0 };
+        quint64 bytesOut { 0 };
+    };
+
     QHash<QString, QSet<QUuid>> _channelSubscribers;
+    QHash<QUuid, QSet<QString>> _subscriberChannels;
     QHash<QUuid, int> _allSubscribers;
 
+    // messages already encoded for each recipient, sent together once the current batch of packets is handled
+    QHash<QUuid, QByteArray> _pendingMessages;
+    bool _sendPendingMessagesQueued { false };
+
+    QHash<QString, ChannelStats> _channelStats;
+    quint64 _packetListsOut { 0 };
+    quint64 _statsStartTime { 0 };
+
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
     int _maxMessagesPerSecond { 0 };
 
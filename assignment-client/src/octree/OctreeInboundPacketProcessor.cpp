@@ -16,6 +16,7 @@
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 
 #include "OctreeServer.h"
 #include "OctreeServerConsts.h"
@@ -23,6 +24,9 @@
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
 
+// how many decoded edits are applied per write lock, so the send threads get a look in during bulk edits
+const int MAX_EDITS_PER_WRITE_LOCK = 64;
+
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
     _receivedPacketCount(0),
@@ -42,6 +46,11 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalEditBatches = 0;
+    _totalBatchedEdits = 0;
+    _totalWriteLockSections = 0;
+    _totalDecodeStageTime = 0;
+    _totalApplyStageTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -225,6 +234,147 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
+void OctreeInboundPacketProcessor::processPackets(std::list<NodeSharedReceivedMessagePair>& packets) {
+    auto tree = _myServer->getOctree();
+
+    // runs of edits the tree can decode off the lock are batched, everything else goes through processPacket() in order
+    std::vector<NodeSharedReceivedMessagePair*> decodablePackets;
+    auto flushDecodablePackets = [&] {
+        if (!decodablePackets.empty()) {
+            processDecodableEditPackets(decodablePackets);
+            decodablePackets.clear();
+            midProcess();
+        }
+    };
+
+    for (auto& packetPair : packets) {
+        if (tree->canDecodeEditPacketType(packetPair.second->getType())) {
+            decodablePackets.push_back(&packetPair);
+        } else {
+            flushDecodablePackets();
+            processPacket(packetPair.second, packetPair.first);
+            midProcess();
+        }
+        _lastWindowProcessedPackets++;
+    }
+    flushDecodablePackets();
+}
+
+void OctreeInboundPacketProcessor::processDecodableEditPackets(const std::vector<NodeSharedReceivedMessagePair*>& packets) {
+    if (_shuttingDown) {
+        qDebug() << "OctreeInboundPacketProcessor::processDecodableEditPackets() while shutting down... ignoring incoming packets";
+        return;
+    }
+
+    struct DecodedPacket {
+        unsigned short int sequence { 0 };
+        quint64 transitTime { 0 };
+        std::vector<OctreeDecodedEditPointer> edits;
+        quint64 processTime { 0 };
+        quint64 lockWaitTime { 0 };
+    };
+
+    auto tree = _myServer->getOctree();
+    const size_t numPackets = packets.size();
+    std::vector<DecodedPacket> decodedPackets(numPackets);
+
+    for (size_t i = 0; i < numPackets; ++i) {
+        ReceivedMessage& message = *packets[i]->second;
+        DecodedPacket& decodedPacket = decodedPackets[i];
+        _receivedPacketCount++;
+
+        message.readPrimitive(&decodedPacket.sequence);
+
+        quint64 sentAt;
+        message.readPrimitive(&sentAt);
+        quint64 arrivedAt = usecTimestampNow();
+        decodedPacket.transitTime = sentAt > arrivedAt ? 0 : arrivedAt - sentAt;
+    }
+
+    // stage one: decode every edit record in every packet, a packet per task since records have to be read in order
+    quint64 startDecode = usecTimestampNow();
+    auto decodePacket = [&](size_t i) {
+        ReceivedMessage& message = *packets[i]->second;
+        DecodedPacket& decodedPacket = decodedPackets[i];
+        quint64 startPacket = usecTimestampNow();
+
+        qint64 position = message.getPosition();
+        while (position < message.getSize()) {
+            auto editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + position);
+            int maxSize = (int)(message.getSize() - position);
+
+            OctreeDecodedEditPointer decodedEdit;
+            int editDataBytesRead = tree->decodeEditPacketData(message, editData, maxSize, decodedEdit);
+            if (editDataBytesRead <= 0 || !decodedEdit) {
+                break;
+            }
+            decodedPacket.edits.push_back(std::move(decodedEdit));
+            position += editDataBytesRead;
+        }
+        message.seek(position);
+        decodedPacket.processTime += usecTimestampNow() - startPacket;
+    };
+    if (numPackets > 1) {
+        tbb::parallel_for((size_t)0, numPackets, decodePacket);
+    } else {
+        decodePacket(0);
+    }
+    quint64 endDecode = usecTimestampNow();
+
+    // stage two: apply the edits in packet order, a bounded number per write lock
+    size_t packetIndex = 0;
+    size_t editIndex = 0;
+    uint64_t editsApplied = 0;
+    uint64_t writeLockSections = 0;
+    while (packetIndex < numPackets) {
+        quint64 startProcess = 0, startLock = usecTimestampNow();
+        size_t lockPacketIndex = packetIndex;
+        tree->withWriteLock([&] {
+            startProcess = usecTimestampNow();
+            int editsThisLock = 0;
+            while (packetIndex < numPackets && editsThisLock < MAX_EDITS_PER_WRITE_LOCK) {
+                DecodedPacket& decodedPacket = decodedPackets[packetIndex];
+                if (editIndex < decodedPacket.edits.size()) {
+                    quint64 startEdit = usecTimestampNow();
+                    tree->processDecodedEdit(*packets[packetIndex]->second, *decodedPacket.edits[editIndex],
+                                             packets[packetIndex]->first);
+                    decodedPacket.processTime += usecTimestampNow() - startEdit;
+                    ++editIndex;
+                    ++editsThisLock;
+                } else {
+                    ++packetIndex;
+                    editIndex = 0;
+                }
+            }
+            editsApplied += editsThisLock;
+        });
+        decodedPackets[lockPacketIndex].lockWaitTime += startProcess - startLock;
+        ++writeLockSections;
+    }
+    quint64 endApply = usecTimestampNow();
+
+    _totalEditBatches++;
+    _totalBatchedEdits += editsApplied;
+    _totalWriteLockSections += writeLockSections;
+    _totalDecodeStageTime += endDecode - startDecode;
+    _totalApplyStageTime += endApply - endDecode;
+
+    if (_myServer->wantsDebugReceiving()) {
+        qDebug() << "PROCESSING THREAD: batched" << numPackets << "edit packets," << editsApplied << "edits in"
+            << writeLockSections << "write locks - decode:" << (endDecode - startDecode) << "usecs apply:"
+            << (endApply - endDecode) << "usecs";
+    }
+
+    for (size_t i = 0; i < numPackets; ++i) {
+        const DecodedPacket& decodedPacket = decodedPackets[i];
+        // the sending node may have been killed while its packets were queued
+        const SharedNodePointer& sendingNode = packets[i]->first;
+        const QUuid& nodeUUID = sendingNode ? sendingNode->getUUID() : DEFAULT_NODE_ID_REF;
+        trackInboundPacket(nodeUUID, decodedPacket.sequence, decodedPacket.transitTime,
+                           (int)decodedPacket.edits.size(), decodedPacket.processTime, decodedPacket.lockWaitTime);
+    }
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
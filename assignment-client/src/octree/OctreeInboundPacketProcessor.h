@@ -70,6 +70,15 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    // the batched edit pipeline: decoding on worker threads, then applying under short write lock sections
+    quint64 getTotalEditBatches() const { return _totalEditBatches; }
+    quint64 getAverageDecodeStageTimePerBatch() const
+                { return _totalEditBatches == 0 ? 0 : _totalDecodeStageTime / _totalEditBatches; }
+    quint64 getAverageApplyStageTimePerBatch() const
+                { return _totalEditBatches == 0 ? 0 : _totalApplyStageTime / _totalEditBatches; }
+    float getAverageEditsPerWriteLock() const
+                { return _totalWriteLockSections == 0 ? 0.0f : (float)_totalBatchedEdits / (float)_totalWriteLockSections; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -79,6 +88,7 @@ public:
 protected:
 
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets) override;
 
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
@@ -86,6 +96,7 @@ protected:
 
 private:
     int sendNackPackets();
+    void processDecodableEditPackets(const std::vector<NodeSharedReceivedMessagePair*>& packets);
 
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
@@ -99,6 +110,12 @@ private:
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+
+    std::atomic<uint64_t> _totalEditBatches { 0 };
+    std::atomic<uint64_t> _totalBatchedEdits { 0 };
+    std::atomic<uint64_t> _totalWriteLockSections { 0 };
+    std::atomic<uint64_t> _totalDecodeStageTime { 0 };
+    std::atomic<uint64_t> _totalApplyStageTime { 0 };
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
@@ -706,6 +706,17 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("            Average Filter Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageFilterTime).rightJustified(COLUMN_WIDTH, ' '));
 
+        statsString += QString("              Total Edit Batches: %1 batches\r\n")
+            .arg(locale.toString((uint)_octreeInboundPacketProcessor->getTotalEditBatches()).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("   Average Parallel Decode/Batch: %1 usecs\r\n")
+            .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageDecodeStageTimePerBatch())
+                .rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("        Average Apply Time/Batch: %1 usecs\r\n")
+            .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageApplyStageTimePerBatch())
+                .rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString().sprintf("        Average Edits/Write Lock: %f edits\r\n",
+                                         (double)_octreeInboundPacketProcessor->getAverageEditsPerWriteLock());
+
 
         int senderNumber = 0;
         NodeToSenderStatsMap allSenderStats = _octreeInboundPacketProcessor->getSingleSenderStats();
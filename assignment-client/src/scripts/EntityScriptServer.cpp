@@ -576,6 +576,12 @@ void EntityScriptServer::sendStatsPacket() {
     const auto scriptEngine = _entitiesScriptEngine;
     if (scriptEngine) {
         numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
+
+        auto timerStats = scriptEngine->getTimerStats();
+        scriptEngineStats["active_timers"] = timerStats["activeTimers"].toInt();
+        scriptEngineStats["timers_fired"] = timerStats["timersFired"].toDouble();
+        scriptEngineStats["timer_average_latency_ms"] = timerStats["averageLatency"].toDouble();
+        scriptEngineStats["timer_max_latency_ms"] = timerStats["maxLatency"].toDouble();
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
     statsObject["script_engine_stats"] = scriptEngineStats;
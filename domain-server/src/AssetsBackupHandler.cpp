@@ -378,12 +378,13 @@ void AssetsBackupHandler::deleteBackup(const QString& backupName) {
     qDebug() << "Deleted asset backup:" << backupName;
 }
 
-void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+std::pair<bool, QString> AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     if (operationInProgress()) {
-        qCWarning(asset_backup) << "There is a backup/restore in progress.";
-        return;
+        QString errorStr("There is a backup/restore in progress.");
+        qCWarning(asset_backup) << errorStr;
+        return { false, errorStr };
     }
 
     const auto it = find_if(begin(_backups), end(_backups), [&](const AssetServerBackup& backup) {
@@ -391,7 +392,7 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
     });
     if (it == end(_backups)) {
         qCDebug(asset_backup) << "Could not find backup" << backupName << "to consolidate.";
-        return;
+        return { true, QString() };
     }
 
     for (const auto& mapping : it->mappings) {
@@ -417,6 +418,7 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         }
     }
 
+    return { true, QString() };
 }
 
 void AssetsBackupHandler::refreshMappings() {
@@ -40,7 +40,7 @@ public:
     void createBackup(const QString& backupName, QuaZip& zip) override;
     std::pair<bool, QString> recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) override;
     void deleteBackup(const QString& backupName) override;
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override;
+    std::pair<bool, QString> consolidateBackup(const QString& backupName, QuaZip& zip) override;
     bool isCorruptedBackup(const QString& backupName) override;
 
     bool operationInProgress() { return getRecoveryStatus().first; }
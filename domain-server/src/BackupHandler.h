@@ -32,7 +32,7 @@ public:
     virtual void createBackup(const QString& backupName, QuaZip& zip) = 0;
     virtual std::pair<bool, QString> recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) = 0;
     virtual void deleteBackup(const QString& backupName) = 0;
-    virtual void consolidateBackup(const QString& backupName, QuaZip& zip) = 0;
+    virtual std::pair<bool, QString> consolidateBackup(const QString& backupName, QuaZip& zip) = 0;
     virtual bool isCorruptedBackup(const QString& backupName) = 0;
 };
 using BackupHandlerPointer = std::unique_ptr<BackupHandlerInterface>;
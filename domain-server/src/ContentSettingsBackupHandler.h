@@ -32,7 +32,7 @@ public:
 
     void deleteBackup(const QString& backupName) override {}
 
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    std::pair<bool, QString> consolidateBackup(const QString& backupName, QuaZip& zip) override { return { true, QString() }; }
 
     bool isCorruptedBackup(const QString& backupName) override { return false; }
 
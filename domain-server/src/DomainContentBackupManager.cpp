@@ -544,6 +544,12 @@ void DomainContentBackupManager::removeOldBackupVersions(const BackupRule& rule)
                 QFile backupFile(fileInfo);
                 if (!backupFile.remove()) {
                     qCDebug(domain_server) << "Failed to remove old backup: " << backupFile.fileName();
+                    continue;
+                }
+
+                // Let the handlers release what only this backup referenced, as deleteBackup does
+                for (auto& handler : _backupHandlers) {
+                    handler->deleteBackup(matchingFiles[i].fileName());
                 }
             }
         }
@@ -676,7 +682,15 @@ void DomainContentBackupManager::consolidateBackupInternal(QString fileName) {
     }
 
     for (auto& handler : _backupHandlers) {
-        handler->consolidateBackup(fileName, zip);
+        bool success;
+        QString errorStr;
+        std::tie(success, errorStr) = handler->consolidateBackup(fileName, zip);
+        if (!success) {
+            zip.close();
+            QFile::remove(copyFilePath);
+            markFailure(errorStr);
+            return;
+        }
     }
 
     zip.close();
@@ -12,6 +12,7 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
 #include <iostream>
@@ -325,7 +326,7 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _contentManager.reset(new DomainContentBackupManager(getContentBackupDir(), _settingsManager));
 
     connect(_contentManager.get(), &DomainContentBackupManager::started, _contentManager.get(), [this](){
-        _contentManager->addBackupHandler(BackupHandlerPointer(new EntitiesBackupHandler(getEntitiesFilePath(), getEntitiesReplacementFilePath())));
+        _contentManager->addBackupHandler(BackupHandlerPointer(new EntitiesBackupHandler(getEntitiesFilePath(), getEntitiesReplacementFilePath(), getContentBackupDir())));
         _contentManager->addBackupHandler(BackupHandlerPointer(new AssetsBackupHandler(getContentBackupDir(), isAssetServerEnabled())));
         _contentManager->addBackupHandler(BackupHandlerPointer(new ContentSettingsBackupHandler(_settingsManager)));
     });
@@ -1119,6 +1120,9 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
     sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
 
+    // other nodes hear about changes to this node (sockets, permissions) through the domain list change log
+    refreshDomainListRecord(sendingNode);
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
     if (!nodeData->hasCheckedIn()) {
@@ -1134,6 +1138,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
+    // a node whose interests changed needs the full list, the deltas only cover nodes it was already interested in
+    quint64 lastDomainListVersion = nodeRequestData.lastDomainListVersion;
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        lastDomainListVersion = 0;
+    }
+
     // update the NodeInterestSet in case there have been any changes
     nodeData->setNodeInterestSet(safeInterestSet);
 
@@ -1143,7 +1153,8 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         lastDomainListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1221,11 +1232,106 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    // record the add so nodes already in the domain pick it up in their next domain list
+    refreshDomainListRecord(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::refreshDomainListRecord(const SharedNodePointer& node) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    QByteArray record;
+    QDataStream recordStream(&record, QIODevice::WriteOnly);
+    recordStream << *node.data();
+
+    if (record != nodeData->getDomainListRecord()) {
+        nodeData->setDomainListRecord(record);
+        recordDomainListChange(node, false);
+    }
+}
+
+void DomainServer::recordDomainListChange(const SharedNodePointer& node, bool removed) {
+    // enough history to cover a few seconds of churn in a large domain; nodes that fall further behind get a full list
+    const size_t MAX_DOMAIN_LIST_CHANGES = 4096;
+
+    _domainListChanges.push_back({ ++_domainListVersion, node->getUUID(), node->getType(), removed });
+    while (_domainListChanges.size() > MAX_DOMAIN_LIST_CHANGES) {
+        _oldestDomainListDeltaVersion = _domainListChanges.front().version;
+        _domainListChanges.pop_front();
+    }
+}
+
+bool DomainServer::canSendDomainListDelta(quint64 lastDomainListVersion) const {
+    // zero means the node has never applied a complete list from us
+    return lastDomainListVersion != 0 && lastDomainListVersion >= _oldestDomainListDeltaVersion
+        && lastDomainListVersion <= _domainListVersion;
+}
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, quint64 lastDomainListVersion) {
+    // more removals than this in one delta are left to the DomainServerRemovedNode packets and a full list
+    const int MAX_DOMAIN_LIST_DELTA_REMOVALS = 16;
+
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // figure out which nodes go in this list before writing the header, since the header carries the count
+    bool isDelta = !newConnection && canSendDomainListDelta(lastDomainListVersion);
+    std::vector<SharedNodePointer> listedNodes;
+    QList<QUuid> removedNodeIDs;
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    if (nodeInterestSet.size() > 0 && nodeData->isAuthenticated()) {
+        if (isDelta) {
+            // walk the changes since the version this node last saw, keeping only the latest change for each node
+            auto firstChange = std::upper_bound(_domainListChanges.begin(), _domainListChanges.end(), lastDomainListVersion,
+                [](quint64 version, const DomainListChange& change) {
+                    return version < change.version;
+                });
+
+            QHash<QUuid, const DomainListChange*> latestChanges;
+            for (auto it = firstChange; it != _domainListChanges.end(); ++it) {
+                latestChanges[it->nodeID] = &(*it);
+            }
+
+            for (const DomainListChange* change : latestChanges) {
+                if (change->nodeID == node->getUUID() || !nodeInterestSet.contains(change->nodeType)) {
+                    continue;
+                }
+
+                SharedNodePointer otherNode = change->removed ? SharedNodePointer() : limitedNodeList->nodeWithUUID(change->nodeID);
+                if (otherNode) {
+                    listedNodes.push_back(otherNode);
+                } else {
+                    removedNodeIDs.push_back(change->nodeID);
+                }
+            }
+
+            if (removedNodeIDs.size() > MAX_DOMAIN_LIST_DELTA_REMOVALS) {
+                isDelta = false;
+                listedNodes.clear();
+                removedNodeIDs.clear();
+            }
+        }
+
+        if (!isDelta) {
+            // if this authenticated node has any interest types, send back those nodes as well
+            limitedNodeList->eachNode([this, node, &listedNodes](const SharedNodePointer& otherNode) {
+                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    listedNodes.push_back(otherNode);
+                }
+            });
+        }
+    }
+
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
@@ -1233,8 +1339,6 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
@@ -1246,35 +1350,30 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+
+    // the version this list brings the node up to, the version it is a delta from (zero for a full list),
+    // and how many nodes the whole list holds so the node can tell when it has all of it
+    extendedHeaderStream << _domainListVersion;
+    extendedHeaderStream << (isDelta ? lastDomainListVersion : quint64(0));
+    extendedHeaderStream << quint32(listedNodes.size());
+    extendedHeaderStream << removedNodeIDs;
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
-
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    for (const auto& otherNode : listedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -3258,6 +3357,11 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
             }
         }
 
+        // only nodes that made it into a domain list need their removal in the change log
+        if (!nodeData->getDomainListRecord().isEmpty()) {
+            recordDomainListChange(node, true);
+        }
+
         // cleanup the connection secrets that we set up for this node (on the other nodes)
         foreach (const QUuid& otherNodeSessionUUID, nodeData->getSessionSecretHash().keys()) {
             SharedNodePointer otherNode = DependencyManager::get<LimitedNodeList>()->nodeWithUUID(otherNodeSessionUUID);
@@ -13,6 +13,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -186,7 +188,12 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection, quint64 lastDomainListVersion = 0);
+
+    void refreshDomainListRecord(const SharedNodePointer& node);
+    void recordDomainListChange(const SharedNodePointer& node, bool removed);
+    bool canSendDomainListDelta(quint64 lastDomainListVersion) const;
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -249,6 +256,18 @@ private:
     
     std::unique_ptr<HTTPSManager> _httpsManager;
 
+    // versioned log of the node adds, updates and removals that change what goes into a domain list, so that a node
+    // that tells us the last version it saw only needs to hear about what changed since then
+    struct DomainListChange {
+        quint64 version;
+        QUuid nodeID;
+        NodeType_t nodeType;
+        bool removed;
+    };
+    std::deque<DomainListChange> _domainListChanges;
+    quint64 _domainListVersion { 0 };
+    quint64 _oldestDomainListDeltaVersion { 0 }; // the oldest last-seen version the change log can still serve
+
     QHash<QUuid, SharedAssignmentPointer> _allAssignments;
     QQueue<SharedAssignmentPointer> _unfulfilledAssignments;
     TransactionHash _pendingAssignmentCredits;
@@ -75,6 +75,10 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the serialized node as other nodes last heard about it in their domain lists
+    const QByteArray& getDomainListRecord() const { return _domainListRecord; }
+    void setDomainListRecord(const QByteArray& domainListRecord) { _domainListRecord = domainListRecord; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -102,6 +106,8 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    QByteArray _domainListRecord;
 };
 
 #endif // hifi_DomainServerNodeData_h
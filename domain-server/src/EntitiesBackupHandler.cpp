@@ -12,6 +12,11 @@
 #include "EntitiesBackupHandler.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
 
 #if !defined(__clang__) && defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -25,26 +30,119 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <AssetUtils.h>
+#include <ContentDefinedChunker.h>
+#include <Gzip.h>
 #include <OctreeDataUtils.h>
 
-EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
+static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static const QString ENTITIES_CHUNKS_FILENAME = "models.chunks.json";
+static const QString ENTITIES_CHUNKS_DIR { "/entities/" };
+
+static bool readChunkList(QuaZip& zip, QStringList& chunkHashes, int& size) {
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open" << ENTITIES_CHUNKS_FILENAME << "in backup";
+        return false;
+    }
+
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(zipFile.readAll(), &error);
+    zipFile.close();
+    if (!document.isObject()) {
+        qCritical() << "Could not parse" << ENTITIES_CHUNKS_FILENAME << "in backup:" << error.errorString();
+        return false;
+    }
+
+    auto jsonObject = document.object();
+    size = jsonObject["size"].toInt(-1);
+    for (const auto& chunk : jsonObject["chunks"].toArray()) {
+        auto hash = chunk.toString();
+        if (!AssetUtils::isValidHash(hash)) {
+            qCritical() << "Invalid entities chunk in backup:" << hash;
+            return false;
+        }
+        chunkHashes.push_back(hash);
+    }
+    return size >= 0;
+}
+
+EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath,
+                                             const QString& backupDirectory) :
     _entitiesFilePath(entitiesFilePath),
-    _entitiesReplacementFilePath(entitiesReplacementFilePath)
+    _entitiesReplacementFilePath(entitiesReplacementFilePath),
+    _chunksDirectory(backupDirectory + ENTITIES_CHUNKS_DIR)
 {
+    QDir chunksDir { _chunksDirectory };
+    chunksDir.mkpath(".");
+
+    for (const auto& chunkName : chunksDir.entryList(QDir::Files)) {
+        if (AssetUtils::isValidHash(chunkName)) {
+            _chunksOnDisk.insert(chunkName);
+        }
+    }
 }
 
-static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+void EntitiesBackupHandler::loadBackup(const QString& backupName, QuaZip& zip) {
+    if (!zip.setCurrentFile(ENTITIES_CHUNKS_FILENAME)) {
+        // Older backups and consolidated ones hold the whole entities file
+        return;
+    }
+
+    QStringList chunkHashes;
+    int size;
+    if (!readChunkList(zip, chunkHashes, size)) {
+        qCritical() << "Failed to load entities chunks of backup" << backupName;
+        _corruptedBackups.insert(backupName);
+        return;
+    }
+    _backupChunks[backupName] = chunkHashes;
+}
+
+void EntitiesBackupHandler::loadingComplete() {
+    deleteUnusedChunks();
+}
 
 void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QFile entitiesFile { _entitiesFilePath };
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
+        auto entityData = entitiesFile.readAll();
+
+        QByteArray jsonData;
+        QStringList chunkHashes;
+        if (gunzip(entityData, jsonData) && writeChunks(jsonData, chunkHashes)) {
+            QJsonArray chunks;
+            for (const auto& hash : chunkHashes) {
+                chunks.push_back(hash);
+            }
+            QJsonObject jsonObject {
+                { "size", jsonData.size() },
+                { "chunks", chunks }
+            };
+
+            QuaZipFile zipFile { &zip };
+            if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_CHUNKS_FILENAME, _entitiesFilePath))) {
+                qCritical().nospace() << "Failed to open " << ENTITIES_CHUNKS_FILENAME << " for writing in zip";
+                return;
+            }
+            zipFile.write(QJsonDocument(jsonObject).toJson(QJsonDocument::Compact));
+            zipFile.close();
+            if (zipFile.getZipError() != UNZ_OK) {
+                qCritical().nospace() << "Failed to zip " << ENTITIES_CHUNKS_FILENAME << ": " << zipFile.getZipError();
+                return;
+            }
+            _backupChunks[backupName] = chunkHashes;
+            return;
+        }
+
+        qWarning() << "Could not back up entities as chunks, storing the whole entities file";
+
         QuaZipFile zipFile { &zip };
         if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
             qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
         if (zipFile.write(entityData) != entityData.size()) {
             qCritical() << "Failed to write entities file to backup";
             zipFile.close();
@@ -57,26 +155,47 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
     }
 }
 
-std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) {
-    if (!zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
-        QString errorStr("Failed to find " + ENTITIES_BACKUP_FILENAME + " while recovering backup");
-        qWarning() << errorStr;
-        return { false, errorStr };
+std::pair<bool, QString> EntitiesBackupHandler::readEntities(QuaZip& zip, QByteArray& data) {
+    if (zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
+        QuaZipFile zipFile { &zip };
+        if (!zipFile.open(QIODevice::ReadOnly)) {
+            QString errorStr("Failed to open " + ENTITIES_BACKUP_FILENAME + " in backup");
+            qCritical() << errorStr;
+            return { false, errorStr };
+        }
+        data = zipFile.readAll();
+
+        zipFile.close();
+
+        if (zipFile.getZipError() != UNZ_OK) {
+            QString errorStr("Failed to unzip " + ENTITIES_BACKUP_FILENAME + ": " + zipFile.getZipError());
+            qCritical() << errorStr;
+            return { false, errorStr };
+        }
+        return { true, QString() };
     }
-    QuaZipFile zipFile { &zip };
-    if (!zipFile.open(QIODevice::ReadOnly)) {
-        QString errorStr("Failed to open " + ENTITIES_BACKUP_FILENAME + " in backup");
-        qCritical() << errorStr;
-        return { false, errorStr };
+
+    if (zip.setCurrentFile(ENTITIES_CHUNKS_FILENAME)) {
+        QStringList chunkHashes;
+        int size;
+        if (!readChunkList(zip, chunkHashes, size) || !readChunks(chunkHashes, data) || data.size() != size) {
+            QString errorStr("Failed to read the entities chunks of the backup");
+            qCritical() << errorStr;
+            return { false, errorStr };
+        }
+        return { true, QString() };
     }
-    auto rawData = zipFile.readAll();
 
-    zipFile.close();
+    QString errorStr("Failed to find " + ENTITIES_BACKUP_FILENAME + " while recovering backup");
+    qWarning() << errorStr;
+    return { false, errorStr };
+}
 
-    if (zipFile.getZipError() != UNZ_OK) {
-        QString errorStr("Failed to unzip " + ENTITIES_BACKUP_FILENAME + ": " + zipFile.getZipError());
-        qCritical() << errorStr;
-        return { false, errorStr };
+std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) {
+    QByteArray rawData;
+    auto result = readEntities(zip, rawData);
+    if (!result.first) {
+        return result;
     }
 
     OctreeUtils::RawEntityData data;
@@ -95,3 +214,118 @@ std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& bac
     }
     return { true, QString() };
 }
+
+void EntitiesBackupHandler::deleteBackup(const QString& backupName) {
+    _backupChunks.erase(backupName);
+    _corruptedBackups.erase(backupName);
+    deleteUnusedChunks();
+}
+
+std::pair<bool, QString> EntitiesBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+    auto it = _backupChunks.find(backupName);
+    if (it == _backupChunks.end()) {
+        // The backup already holds the whole entities file, or has no entities
+        return { true, QString() };
+    }
+
+    QByteArray jsonData;
+    QByteArray entityData;
+    if (!readChunks(it->second, jsonData) || !gzip(jsonData, entityData)) {
+        QString errorStr("Failed to put back together the entities of the backup");
+        qCritical() << errorStr << backupName;
+        return { false, errorStr };
+    }
+
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME))) {
+        QString errorStr("Failed to open " + ENTITIES_BACKUP_FILENAME + " for writing in zip");
+        qCritical() << errorStr;
+        return { false, errorStr };
+    }
+    if (zipFile.write(entityData) != entityData.size()) {
+        QString errorStr("Failed to write entities file to backup");
+        qCritical() << errorStr;
+        zipFile.close();
+        return { false, errorStr };
+    }
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        QString errorStr("Failed to zip " + ENTITIES_BACKUP_FILENAME + ": " + QString::number(zipFile.getZipError()));
+        qCritical() << errorStr;
+        return { false, errorStr };
+    }
+    return { true, QString() };
+}
+
+bool EntitiesBackupHandler::isCorruptedBackup(const QString& backupName) {
+    return _corruptedBackups.find(backupName) != _corruptedBackups.end();
+}
+
+bool EntitiesBackupHandler::writeChunks(const QByteArray& data, QStringList& chunkHashes) {
+    int offset = 0;
+    while (offset < data.size()) {
+        int length = ContentDefinedChunker::nextChunkLength(data.constData() + offset, data.size() - offset);
+        auto chunk = QByteArray::fromRawData(data.constData() + offset, length);
+        offset += length;
+
+        QString hash = AssetUtils::hashData(chunk).toHex();
+        chunkHashes.push_back(hash);
+        if (_chunksOnDisk.find(hash) != _chunksOnDisk.end()) {
+            continue;
+        }
+
+        QByteArray compressedChunk;
+        if (!gzip(chunk, compressedChunk)) {
+            qCritical() << "Failed to compress entities chunk" << hash;
+            return false;
+        }
+
+        // Written whole or not at all, so that a chunk on disk can always be trusted to match its name
+        QSaveFile file { _chunksDirectory + hash };
+        if (!file.open(QIODevice::WriteOnly) || file.write(compressedChunk) != compressedChunk.size() || !file.commit()) {
+            qCritical() << "Failed to write entities chunk" << file.fileName() << file.errorString();
+            return false;
+        }
+        _chunksOnDisk.insert(hash);
+    }
+    return true;
+}
+
+bool EntitiesBackupHandler::readChunks(const QStringList& chunkHashes, QByteArray& data) {
+    for (const auto& hash : chunkHashes) {
+        QFile file { _chunksDirectory + hash };
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Could not open entities chunk" << file.fileName();
+            return false;
+        }
+
+        QByteArray chunk;
+        if (!gunzip(file.readAll(), chunk) || QString(AssetUtils::hashData(chunk).toHex()) != hash) {
+            qCritical() << "Entities chunk is corrupted:" << file.fileName();
+            return false;
+        }
+        data.append(chunk);
+    }
+    return true;
+}
+
+void EntitiesBackupHandler::deleteUnusedChunks() {
+    if (!_corruptedBackups.empty()) {
+        qWarning() << "Some entities backups did not load properly, not deleting unused chunks for safety.";
+        return;
+    }
+
+    std::set<QString> usedChunks;
+    for (const auto& backup : _backupChunks) {
+        usedChunks.insert(backup.second.begin(), backup.second.end());
+    }
+
+    auto it = _chunksOnDisk.begin();
+    while (it != _chunksOnDisk.end()) {
+        if (usedChunks.find(*it) == usedChunks.end() && QFile::remove(_chunksDirectory + *it)) {
+            it = _chunksOnDisk.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -12,18 +12,26 @@
 #ifndef hifi_EntitiesBackupHandler_h
 #define hifi_EntitiesBackupHandler_h
 
+#include <map>
+#include <set>
+
+#include <QStringList>
+
 #include "BackupHandler.h"
 
+// Entities are backed up as chunks of the decompressed entities file, stored once each under the backup directory and
+// named by their hash, so that backups of mostly unchanged content only add the chunks that differ.  Each skeleton
+// backup holds a list of its chunks; the entities file is only put back together when recovering or consolidating.
 class EntitiesBackupHandler : public BackupHandlerInterface {
 public:
-    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath);
+    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath, const QString& backupDirectory);
 
     std::pair<bool, float> isAvailable(const QString& backupName) override { return { true, 1.0f }; }
     std::pair<bool, float> getRecoveryStatus() override { return { false, 1.0f }; }
 
-    void loadBackup(const QString& backupName, QuaZip& zip) override {}
+    void loadBackup(const QString& backupName, QuaZip& zip) override;
 
-    void loadingComplete() override {}
+    void loadingComplete() override;
 
     // Create a skeleton backup
     void createBackup(const QString& backupName, QuaZip& zip) override;
@@ -32,16 +40,28 @@ public:
     std::pair<bool, QString> recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) override;
 
     // Delete a skeleton backup
-    void deleteBackup(const QString& backupName) override {}
+    void deleteBackup(const QString& backupName) override;
 
     // Create a full backup
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    std::pair<bool, QString> consolidateBackup(const QString& backupName, QuaZip& zip) override;
 
-    bool isCorruptedBackup(const QString& backupName) override { return false; }
+    bool isCorruptedBackup(const QString& backupName) override;
 
 private:
+    // Reads the entities of a backup, either from the chunks it lists or from a full entities file in the archive
+    std::pair<bool, QString> readEntities(QuaZip& zip, QByteArray& data);
+
+    bool writeChunks(const QByteArray& data, QStringList& chunkHashes);
+    bool readChunks(const QStringList& chunkHashes, QByteArray& data);
+    void deleteUnusedChunks();
+
     QString _entitiesFilePath;
     QString _entitiesReplacementFilePath;
+    QString _chunksDirectory;
+
+    std::map<QString, QStringList> _backupChunks;
+    std::set<QString> _corruptedBackups;
+    std::set<QString> _chunksOnDisk;
 };
 
 #endif /* hifi_EntitiesBackupHandler_h */
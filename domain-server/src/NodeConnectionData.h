@@ -35,6 +35,7 @@ public:
     quint32 connectReason;
     quint64 previousConnectionUpTime;
     QByteArray protocolVersion;
+    quint64 lastDomainListVersion { 0 }; // version of the last complete domain list the node applied, list requests only
 };
 
 
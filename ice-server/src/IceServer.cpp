@@ -11,10 +11,15 @@
 
 #include "IceServer.h"
 
+#include <algorithm>
+
 #include <openssl/x509.h>
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -28,12 +33,50 @@
 
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
+const int LOG_STATS_INTERVAL_MSECS = 60 * 1000;
+
+// an unchanged heartbeat from a domain is trusted without another RSA verification for this long
+const quint64 VERIFIED_HEARTBEAT_CACHE_USECS = 60 * USECS_PER_SECOND;
+
+// heartbeats and queries past this many from a single sender in one CLEAR_INACTIVE_PEERS_INTERVAL_MSECS are dropped
+const int MAX_PACKETS_PER_SENDER_PER_INTERVAL = 20;
+
+class HeartbeatVerifier : public QRunnable {
+public:
+    HeartbeatVerifier(std::shared_ptr<RSA> publicKey, QByteArray signedPlaintext, QByteArray signature,
+                      std::function<void(bool)> finished) :
+        _publicKey(std::move(publicKey)),
+        _signedPlaintext(std::move(signedPlaintext)),
+        _signature(std::move(signature)),
+        _finished(std::move(finished)) {}
+
+    void run() override {
+        auto hashedPlaintext = QCryptographicHash::hash(_signedPlaintext, QCryptographicHash::Sha256);
+        int verificationResult = RSA_verify(NID_sha256,
+                                            reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                            hashedPlaintext.size(),
+                                            reinterpret_cast<const unsigned char*>(_signature.constData()),
+                                            _signature.size(),
+                                            _publicKey.get());
+
+        // this is the only success case
+        _finished(verificationResult == 1);
+    }
+
+private:
+    // shared so that the key outlives its removal from _domainPublicKeys while we are still verifying with it
+    std::shared_ptr<RSA> _publicKey;
+    QByteArray _signedPlaintext;
+    QByteArray _signature;
+    std::function<void(bool)> _finished;
+};
 
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
     _serverSocket(0, false),
-    _activePeers()
+    _activePeers(),
+    _statsStartUsecs(usecTimestampNow())
 {
     // start the ice-server socket
     qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
@@ -51,6 +94,12 @@ IceServer::IceServer(int argc, char* argv[]) :
     connect(inactivePeerTimer, &QTimer::timeout, this, &IceServer::clearInactivePeers);
     inactivePeerTimer->start(CLEAR_INACTIVE_PEERS_INTERVAL_MSECS);
 
+    QTimer* statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &IceServer::logStats);
+    statsTimer->start(LOG_STATS_INTERVAL_MSECS);
+
+    _verificationPool.setMaxThreadCount(std::max(QThread::idealThreadCount(), 1));
+
     // handle public keys when they arrive from the QNetworkAccessManager
     auto& networkAccessManager = NetworkAccessManager::getInstance();
     connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IceServer::publicKeyReplyFinished);
@@ -74,22 +123,15 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     // make sure that this packet at least looks like something we can read
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
         
+        if (isRateLimited(nlPacket->getSenderSockAddr())) {
+            return;
+        }
+
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
+            processHeartbeat(*nlPacket);
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
+            ++_queries;
+
             QDataStream heartbeatStream(nlPacket.get());
             
             // this is a node hoping to connect to a heartbeating peer - do we have the heartbeating peer?
@@ -125,85 +167,139 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     }
 }
 
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
+bool IceServer::isRateLimited(const HifiSockAddr& senderSockAddr) {
+    int& packetCount = _packetsThisInterval[senderSockAddr];
+    if (packetCount >= MAX_PACKETS_PER_SENDER_PER_INTERVAL) {
+        ++_packetsRateLimited;
+        return true;
+    }
 
-    // pull the UUID, public and private sock addrs for this peer
-    QUuid senderUUID;
-    HifiSockAddr publicSocket, localSocket;
-    QByteArray signature;
+    ++packetCount;
+    return false;
+}
+
+void IceServer::processHeartbeat(NLPacket& packet) {
+    Heartbeat heartbeat;
+    heartbeat.senderSockAddr = packet.getSenderSockAddr();
+    heartbeat.receivedUsecs = usecTimestampNow();
 
+    // pull the UUID, public and private sock addrs for this peer
     QDataStream heartbeatStream(&packet);
-    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
+    heartbeatStream >> heartbeat.domainID >> heartbeat.publicSocket >> heartbeat.localSocket;
 
-    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
-    heartbeatStream >> signature;
+    // take a deep copy of the signed plaintext, the packet is gone by the time a worker verifies it
+    heartbeat.signedPlaintext = QByteArray(packet.getPayload(), heartbeatStream.device()->pos());
+    heartbeatStream >> heartbeat.signature;
 
-    // make sure this is a verified heartbeat before performing any more processing
-    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
-        // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+    // make sure we're not already waiting for a public key for this domain-server
+    if (_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+        denyHeartbeat(heartbeat);
+        return;
+    }
 
-        if (!matchingPeer) {
-            // if we don't have this sender we need to create them now
-            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+    // a heartbeat identical to one we recently verified with the current key needs no RSA work
+    if (isCachedHeartbeat(heartbeat)) {
+        ++_heartbeatsCached;
+        acceptHeartbeat(heartbeat);
+        return;
+    }
 
-            qDebug() << "Added a new network peer" << *matchingPeer;
-        } else {
-            // we already had the peer so just potentially update their sockets
-            matchingPeer->setPublicSocket(publicSocket);
-            matchingPeer->setLocalSocket(localSocket);
-        }
+    // check if we have a public key for this domain ID - if we do not then fire off the request for it
+    auto it = _domainPublicKeys.find(heartbeat.domainID);
+    if (it == _domainPublicKeys.end()) {
+        requestDomainPublicKey(heartbeat.domainID);
+        denyHeartbeat(heartbeat);
+        return;
+    }
 
-        // update our last heard microstamp for this network peer to now
-        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
-        
-        return matchingPeer;
-    } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
+    if (_pendingVerifications.contains(heartbeat.domainID)) {
+        // this domain already has a heartbeat being verified, which will be answered on its own
+        // the domain-server keeps heartbeating so there is no need to queue up another verification behind it
+        ++_heartbeatsCoalesced;
+        return;
     }
+
+    verifyHeartbeat(heartbeat, it->second);
 }
 
-bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
-
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+bool IceServer::isCachedHeartbeat(const Heartbeat& heartbeat) const {
+    auto it = _verifiedHeartbeats.find(heartbeat.domainID);
+    return it != _verifiedHeartbeats.end()
+        && (heartbeat.receivedUsecs - it->verifiedUsecs) < VERIFIED_HEARTBEAT_CACHE_USECS
+        && it->signedPlaintext == heartbeat.signedPlaintext
+        && it->signature == heartbeat.signature;
+}
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
-            }
+void IceServer::verifyHeartbeat(const Heartbeat& heartbeat, RSASharedPtr publicKey) {
+    _pendingVerifications.insert(heartbeat.domainID);
+
+    auto verifier = new HeartbeatVerifier(std::move(publicKey), heartbeat.signedPlaintext, heartbeat.signature,
+                                          [this, heartbeat](bool verified) {
+        QMetaObject::invokeMethod(this, [this, heartbeat, verified] {
+            heartbeatVerified(heartbeat, verified);
+        }, Qt::QueuedConnection);
+    });
+    _verificationPool.start(verifier);
+}
+
+void IceServer::heartbeatVerified(const Heartbeat& heartbeat, bool verified) {
+    _pendingVerifications.remove(heartbeat.domainID);
+
+    quint64 verificationUsecs = usecTimestampNow() - heartbeat.receivedUsecs;
+    _totalVerificationUsecs += verificationUsecs;
+    _maxVerificationUsecs = std::max(_maxVerificationUsecs, verificationUsecs);
+
+    if (verified) {
+        ++_heartbeatsVerified;
+        _verifiedHeartbeats[heartbeat.domainID] = { heartbeat.signedPlaintext, heartbeat.signature, usecTimestampNow() };
+        acceptHeartbeat(heartbeat);
+    } else {
+        qDebug() << "Failed to verify heartbeat for" << heartbeat.domainID << "- re-requesting public key from API.";
+
+        // we could not verify this heartbeat (stale public key, bad actor)
+        // ask the metaverse API for the right public key, unless that is already underway
+        _verifiedHeartbeats.remove(heartbeat.domainID);
+        if (!_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+            requestDomainPublicKey(heartbeat.domainID);
         }
+        denyHeartbeat(heartbeat);
+    }
+}
+
+void IceServer::acceptHeartbeat(const Heartbeat& heartbeat) {
+    // make sure we have this sender in our peer hash
+    SharedNetworkPeer matchingPeer = _activePeers.value(heartbeat.domainID);
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+    if (!matchingPeer) {
+        // if we don't have this sender we need to create them now
+        matchingPeer = QSharedPointer<NetworkPeer>::create(heartbeat.domainID, heartbeat.publicSocket, heartbeat.localSocket);
+        _activePeers.insert(heartbeat.domainID, matchingPeer);
+
+        qDebug() << "Added a new network peer" << *matchingPeer;
+    } else {
+        // we already had the peer so just potentially update their sockets
+        matchingPeer->setPublicSocket(heartbeat.publicSocket);
+        matchingPeer->setLocalSocket(heartbeat.localSocket);
     }
 
-    return false;
+    // update our last heard microstamp for this network peer to now
+    matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
+
+    // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+    matchingPeer->activateMatchingOrNewSymmetricSocket(heartbeat.senderSockAddr);
+
+    // we have an active and verified heartbeating peer
+    // send them an ACK packet so they know that they are being heard and ready for ICE
+    static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+    _serverSocket.writePacket(*ackPacket, heartbeat.senderSockAddr);
+}
+
+void IceServer::denyHeartbeat(const Heartbeat& heartbeat) {
+    ++_heartbeatsDenied;
+
+    // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+    static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+    _serverSocket.writePacket(*deniedPacket, heartbeat.senderSockAddr);
 }
 
 void IceServer::requestDomainPublicKey(const QUuid& domainID) {
@@ -262,7 +358,10 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    _domainPublicKeys[domainID] = RSASharedPtr(rsaPublicKey, RSA_free);
+
+                    // heartbeats verified with the previous key have to be verified again
+                    _verifiedHeartbeats.remove(domainID);
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -299,6 +398,9 @@ void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const HifiSoc
 }
 
 void IceServer::clearInactivePeers() {
+    // this also runs our rate limiting interval
+    _packetsThisInterval.clear();
+
     NetworkPeerHash::iterator peerItem = _activePeers.begin();
 
     while (peerItem != _activePeers.end()) {
@@ -309,6 +411,7 @@ void IceServer::clearInactivePeers() {
 
             // if we had a public key for this domain, remove it now
             _domainPublicKeys.erase(peer->getUUID());
+            _verifiedHeartbeats.remove(peer->getUUID());
 
             // remove the peer object
             peerItem = _activePeers.erase(peerItem);
@@ -318,3 +421,35 @@ void IceServer::clearInactivePeers() {
         }
     }
 }
+
+void IceServer::logStats() {
+    quint64 now = usecTimestampNow();
+    float elapsedSeconds = (float)(now - _statsStartUsecs) / USECS_PER_SECOND;
+    quint64 heartbeats = _heartbeatsVerified + _heartbeatsCached + _heartbeatsDenied + _heartbeatsCoalesced;
+
+    if (heartbeats > 0 || _queries > 0 || _packetsRateLimited > 0) {
+        float averageVerificationMsecs = _heartbeatsVerified > 0 ?
+            (float)_totalVerificationUsecs / _heartbeatsVerified / USECS_PER_MSEC : 0.0f;
+
+        qDebug() << "ice-server stats -" << _activePeers.size() << "active peers,"
+            << heartbeats / elapsedSeconds << "heartbeats/s,"
+            << _queries / elapsedSeconds << "queries/s |"
+            << "verified:" << _heartbeatsVerified
+            << "cached:" << _heartbeatsCached
+            << "denied:" << _heartbeatsDenied
+            << "coalesced:" << _heartbeatsCoalesced
+            << "rate limited:" << _packetsRateLimited
+            << "| verification latency avg:" << averageVerificationMsecs << "ms"
+            << "max:" << (float)_maxVerificationUsecs / USECS_PER_MSEC << "ms";
+    }
+
+    _heartbeatsVerified = 0;
+    _heartbeatsCached = 0;
+    _heartbeatsDenied = 0;
+    _heartbeatsCoalesced = 0;
+    _packetsRateLimited = 0;
+    _queries = 0;
+    _totalVerificationUsecs = 0;
+    _maxVerificationUsecs = 0;
+    _statsStartUsecs = now;
+}
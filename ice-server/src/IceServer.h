@@ -12,8 +12,12 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
+#include <memory>
+#include <unordered_map>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 #include <QUdpSocket>
 
 #include <openssl/rsa.h>
@@ -35,14 +39,39 @@ public:
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
+    void logStats();
 private:
+    using RSASharedPtr = std::shared_ptr<RSA>;
+
+    struct Heartbeat {
+        QUuid domainID;
+        HifiSockAddr publicSocket;
+        HifiSockAddr localSocket;
+        HifiSockAddr senderSockAddr;
+        QByteArray signedPlaintext;
+        QByteArray signature;
+        quint64 receivedUsecs { 0 };
+    };
+
+    struct VerifiedHeartbeat {
+        QByteArray signedPlaintext;
+        QByteArray signature;
+        quint64 verifiedUsecs { 0 };
+    };
+
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
+    bool isRateLimited(const HifiSockAddr& senderSockAddr);
+
+    void processHeartbeat(NLPacket& packet);
+    bool isCachedHeartbeat(const Heartbeat& heartbeat) const;
+    void verifyHeartbeat(const Heartbeat& heartbeat, RSASharedPtr publicKey);
+    void heartbeatVerified(const Heartbeat& heartbeat, bool verified);
+    void acceptHeartbeat(const Heartbeat& heartbeat);
+    void denyHeartbeat(const Heartbeat& heartbeat);
+
     void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
     void requestDomainPublicKey(const QUuid& domainID);
 
     QUuid _id;
@@ -51,11 +80,30 @@ private:
     using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
     NetworkPeerHash _activePeers;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
+    using DomainPublicKeyHash = std::unordered_map<QUuid, RSASharedPtr>;
     DomainPublicKeyHash _domainPublicKeys;
 
     QSet<QUuid> _pendingPublicKeyRequests;
+
+    // RSA verification of heartbeats happens on this pool, the results are handled back on the main thread
+    QThreadPool _verificationPool;
+    QSet<QUuid> _pendingVerifications;
+
+    // the last heartbeat that was verified for each domain, identical heartbeats skip RSA verification
+    QHash<QUuid, VerifiedHeartbeat> _verifiedHeartbeats;
+
+    // packets received from each sender in the current rate limiting interval
+    QHash<HifiSockAddr, int> _packetsThisInterval;
+
+    quint64 _heartbeatsVerified { 0 };
+    quint64 _heartbeatsCached { 0 };
+    quint64 _heartbeatsDenied { 0 };
+    quint64 _heartbeatsCoalesced { 0 };
+    quint64 _packetsRateLimited { 0 };
+    quint64 _queries { 0 };
+    quint64 _totalVerificationUsecs { 0 };
+    quint64 _maxVerificationUsecs { 0 };
+    quint64 _statsStartUsecs { 0 };
 };
 
 #endif // hifi_IceServer_h
@@ -5696,6 +5696,7 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    _shapeManager.setDiskCacheDirectory("shape_cache");
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -314,21 +314,15 @@ MyAvatar::MyAvatar(QThread* thread) :
         if (recorder->isRecording()) {
             createRecordingIDs();
             setRecordingBasis();
+            _nextRecordingKeyframeTime = 0.0f;
+            _lastRecordedSkeletonFrame.clear();
         } else {
             clearRecordingBasis();
         }
     });
 
-    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
-    Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [=](Frame::ConstPointer frame) {
-        static AvatarData dummyAvatar;
-        AvatarData::fromFrame(frame->data, dummyAvatar);
-        if (getRecordingBasis()) {
-            dummyAvatar.setRecordingBasis(getRecordingBasis());
-        } else {
-            dummyAvatar.clearRecordingBasis();
-        }
-
+    static AvatarData dummyAvatar;
+    auto applyRecordedSkeleton = [=] {
         auto recordingInterface = DependencyManager::get<RecordingScriptingInterface>();
 
         if (recordingInterface->getPlayerUseSkeletonModel() && dummyAvatar.getSkeletonModelURL().isValid() &&
@@ -340,6 +334,28 @@ MyAvatar::MyAvatar(QThread* thread) :
         if (recordingInterface->getPlayerUseDisplayName() && dummyAvatar.getDisplayName() != getDisplayName()) {
             setDisplayName(dummyAvatar.getDisplayName());
         }
+    };
+
+    static const recording::FrameType AVATAR_SKELETON_FRAME_TYPE =
+        recording::Frame::registerFrameType(AvatarData::SKELETON_FRAME_NAME);
+    Frame::registerFrameHandler(AVATAR_SKELETON_FRAME_TYPE, [=](Frame::ConstPointer frame) {
+        AvatarData::fromSkeletonFrame(frame->data, dummyAvatar);
+        applyRecordedSkeleton();
+    });
+
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [=](Frame::ConstPointer frame) {
+        AvatarData::fromFrame(frame->data, dummyAvatar);
+        if (getRecordingBasis()) {
+            dummyAvatar.setRecordingBasis(getRecordingBasis());
+        } else {
+            dummyAvatar.clearRecordingBasis();
+        }
+
+        // Clips recorded as JSON carry the skeleton in every frame rather than in skeleton frames
+        if (AvatarData::frameHasSkeleton(frame->data)) {
+            applyRecordedSkeleton();
+        }
 
         setWorldPosition(dummyAvatar.getWorldPosition());
         setWorldOrientation(dummyAvatar.getWorldOrientation());
@@ -996,7 +1012,25 @@ void MyAvatar::simulate(float deltaTime, bool inView) {
     auto recorder = DependencyManager::get<recording::Recorder>();
     if (recorder->isRecording()) {
         static const recording::FrameType FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
-        recorder->recordFrame(FRAME_TYPE, toFrame(*this));
+        static const recording::FrameType SKELETON_FRAME_TYPE =
+            recording::Frame::registerFrameType(AvatarData::SKELETON_FRAME_NAME);
+
+        // The first frame of a recording is always a keyframe, so playback has the avatar entities from the start.
+        // Keyframes are spaced by recording time so that the frame rate doesn't change how often they come.
+        float recordingTime = recorder->position();
+        bool isKeyframe = recordingTime >= _nextRecordingKeyframeTime;
+        if (isKeyframe) {
+            _nextRecordingKeyframeTime = recordingTime + AvatarData::RECORDING_KEYFRAME_INTERVAL_SECS;
+        }
+
+        // The skeleton is recorded with every keyframe, so that seeks, loops and late-joining players pick it up within
+        // a keyframe interval, and in between only when it changes
+        QByteArray skeletonFrame = toSkeletonFrame(*this);
+        if (isKeyframe || skeletonFrame != _lastRecordedSkeletonFrame) {
+            recorder->recordFrame(SKELETON_FRAME_TYPE, skeletonFrame);
+            _lastRecordedSkeletonFrame = skeletonFrame;
+        }
+        recorder->recordFrame(FRAME_TYPE, toFrame(*this, isKeyframe));
     }
 
     locationChanged(true, true);
@@ -2939,6 +2939,9 @@ private:
     bool _prevShouldDrawHead;
     bool _rigEnabled { true };
 
+    float _nextRecordingKeyframeTime { 0.0f };
+    QByteArray _lastRecordedSkeletonFrame;
+
     bool _enableDebugDrawBaseOfSupport { false };
     bool _enableDebugDrawDefaultPose { false };
     bool _enableDebugDrawAnimPose { false };
@@ -70,7 +70,9 @@ public:
     void dump(const AnimPoseVec& poses) const;
 
     std::vector<int> lookUpJointIndices(const std::vector<QString>& jointNames) const;
-    const HFMCluster getClusterBindMatricesOriginalValues(const int meshIndex, const int clusterIndex) const { return _clusterBindMatrixOriginalValues[meshIndex][clusterIndex]; }
+    const HFMCluster& getClusterBindMatricesOriginalValues(const int meshIndex, const int clusterIndex) const { return _clusterBindMatrixOriginalValues[meshIndex][clusterIndex]; }
+    const std::vector<HFMCluster>& getClusterBindMatricesOriginalValues(const int meshIndex) const { return _clusterBindMatrixOriginalValues[meshIndex]; }
+    int getNumClusterBindMatrixMeshes() const { return (int)_clusterBindMatrixOriginalValues.size(); }
 
 protected:
     void buildSkeletonFromJoints(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets);
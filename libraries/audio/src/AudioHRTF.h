@@ -55,14 +55,14 @@ public:
     // numFrames: must be HRTF_BLOCK in this version
     // lpfDistance: distance filter adjustment (distance to 1kHz lowpass in meters)
     //
-    void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
+    void render(const int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                 float lpfDistance = LPF_DISTANCE_REF);
 
     //
     // Non-spatialized direct mix (accumulates into existing output)
     //
-    void mixMono(int16_t* input, float* output, float gain, int numFrames);
-    void mixStereo(int16_t* input, float* output, float gain, int numFrames);
+    void mixMono(const int16_t* input, float* output, float gain, int numFrames);
+    void mixStereo(const int16_t* input, float* output, float gain, int numFrames);
 
     //
     // Fast path when input is known to be silent and state as been flushed
@@ -53,6 +53,7 @@ quint64 DEFAULT_FILTERED_LOG_EXPIRY = 2 * USECS_PER_SECOND;
 using namespace std;
 
 const QString AvatarData::FRAME_NAME = "com.highfidelity.recording.AvatarData";
+const QString AvatarData::SKELETON_FRAME_NAME = "com.highfidelity.recording.AvatarSkeleton";
 
 static const int TRANSLATION_COMPRESSION_RADIX = 14;
 static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
@@ -2679,6 +2680,17 @@ JointData jointDataFromJsonValue(int version, const QJsonValue& json) {
     return result;
 }
 
+static void updateAvatarEntitiesFromJson(AvatarData& avatar, const QJsonArray& attachmentsJson) {
+    for (auto attachmentJson : attachmentsJson) {
+        if (attachmentJson.isObject()) {
+            QVariantMap entityData = attachmentJson.toObject().toVariantMap();
+            QUuid id = entityData.value("id").toUuid();
+            QByteArray data = QByteArray::fromBase64(entityData.value("properties").toByteArray());
+            avatar.updateAvatarEntity(id, data);
+        }
+    }
+}
+
 void AvatarData::avatarEntityDataToJson(QJsonObject& root) const {
     // overridden where needed
 }
@@ -2813,15 +2825,7 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 
     if (json.contains(JSON_AVATAR_ENTITIES) && json[JSON_AVATAR_ENTITIES].isArray()) {
-        QJsonArray attachmentsJson = json[JSON_AVATAR_ENTITIES].toArray();
-        for (auto attachmentJson : attachmentsJson) {
-            if (attachmentJson.isObject()) {
-                QVariantMap entityData = attachmentJson.toObject().toVariantMap();
-                QUuid id = entityData.value("id").toUuid();
-                QByteArray data = QByteArray::fromBase64(entityData.value("properties").toByteArray());
-                updateAvatarEntity(id, data);
-            }
-        }
+        updateAvatarEntitiesFromJson(*this, json[JSON_AVATAR_ENTITIES].toArray());
     }
 
     if (json.contains(JSON_AVATAR_JOINT_ARRAY)) {
@@ -2845,24 +2849,310 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 }
 
+// Binary recording frames start with a magic number that can't be confused with the "qbjs" tag of the binary JSON
+// frames written by older versions
+static const QByteArray AVATAR_FRAME_MAGIC = QByteArrayLiteral("HFAF");
+
+enum class BinaryAvatarFrameVersion : uint8_t {
+    Initial = 1
+};
+
+enum BinaryAvatarFrameFlags : uint8_t {
+    AvatarFrameIsKeyframe = 0x1,
+    AvatarFrameHasBasis = 0x2,
+    AvatarFrameHasRelative = 0x4,
+    AvatarFrameHasHead = 0x8
+};
+
+const float AvatarData::RECORDING_KEYFRAME_INTERVAL_SECS = 1.0f;
+
+static void writeTransform(QDataStream& stream, const Transform& transform) {
+    stream << transform.getTranslation() << transform.getRotation() << transform.getScale();
+}
+
+static Transform readTransform(QDataStream& stream) {
+    glm::vec3 translation;
+    glm::quat rotation;
+    glm::vec3 scale;
+    stream >> translation >> rotation >> scale;
+    return Transform(rotation, scale, translation);
+}
+
+// Carries the same state as toJson.  Joints are quantized the same way as in avatar data packets: six byte rotations
+// and fixed point translations relative to the largest translation, with joints in their default pose reduced to a bit.
+QByteArray AvatarData::toBinaryFrame(bool isKeyframe) const {
+    QByteArray frameData;
+    QDataStream stream(&frameData, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream.writeRawData(AVATAR_FRAME_MAGIC.constData(), AVATAR_FRAME_MAGIC.size());
+    stream << (uint8_t)BinaryAvatarFrameVersion::Initial;
+
+    auto recordingBasis = getRecordingBasis();
+    bool success;
+    Transform avatarTransform = getTransform(success);
+    if (!success) {
+        qCWarning(avatars) << "Warning -- AvatarData::toBinaryFrame couldn't get avatar transform";
+    }
+    avatarTransform.setScale(getDomainLimitedScale());
+    Transform relativeTransform = recordingBasis ? recordingBasis->relativeTransform(avatarTransform) : avatarTransform;
+    const HeadData* head = getHeadData();
+
+    uint8_t flags = 0;
+    if (isKeyframe) {
+        flags |= AvatarFrameIsKeyframe;
+    }
+    if (recordingBasis) {
+        flags |= AvatarFrameHasBasis;
+    }
+    if (!recordingBasis || !relativeTransform.isIdentity()) {
+        flags |= AvatarFrameHasRelative;
+    }
+    if (head) {
+        flags |= AvatarFrameHasHead;
+    }
+    stream << flags;
+
+    if (isKeyframe) {
+        QJsonObject entitiesRoot;
+        avatarEntityDataToJson(entitiesRoot);
+        stream << QJsonDocument(entitiesRoot[JSON_AVATAR_ENTITIES].toArray()).toBinaryData();
+    }
+
+    if (recordingBasis) {
+        writeTransform(stream, *recordingBasis);
+    }
+    if (flags & AvatarFrameHasRelative) {
+        writeTransform(stream, relativeTransform);
+    }
+    stream << getDomainLimitedScale();
+
+    // Skeleton pose
+    auto jointData = getRawJointData();
+    int numJoints = std::min(jointData.size(), (int)std::numeric_limits<uint16_t>::max());
+    stream << (uint16_t)numJoints;
+    if (numJoints > 0) {
+        int bitVectorSize = calcBitVectorSize(numJoints);
+        QByteArray bitVectors(2 * bitVectorSize, 0);
+        writeBitVector((uint8_t*)bitVectors.data(), numJoints, [&](int i) {
+            return jointData[i].rotationIsDefaultPose;
+        });
+        writeBitVector((uint8_t*)bitVectors.data() + bitVectorSize, numJoints, [&](int i) {
+            return jointData[i].translationIsDefaultPose;
+        });
+        stream.writeRawData(bitVectors.constData(), bitVectors.size());
+
+        float maxTranslationDimension = 0.001f;
+        for (int i = 0; i < numJoints; ++i) {
+            if (!jointData[i].translationIsDefaultPose) {
+                const glm::vec3& translation = jointData[i].translation;
+                maxTranslationDimension = glm::max(fabsf(translation.x), maxTranslationDimension);
+                maxTranslationDimension = glm::max(fabsf(translation.y), maxTranslationDimension);
+                maxTranslationDimension = glm::max(fabsf(translation.z), maxTranslationDimension);
+            }
+        }
+        stream << maxTranslationDimension;
+
+        unsigned char packed[6];
+        for (int i = 0; i < numJoints; ++i) {
+            if (!jointData[i].rotationIsDefaultPose) {
+                packOrientationQuatToSixBytes(packed, jointData[i].rotation);
+                stream.writeRawData((const char*)packed, sizeof(packed));
+            }
+        }
+        for (int i = 0; i < numJoints; ++i) {
+            if (!jointData[i].translationIsDefaultPose) {
+                packFloatVec3ToSignedTwoByteFixed(packed, jointData[i].translation / maxTranslationDimension,
+                    TRANSLATION_COMPRESSION_RADIX);
+                stream.writeRawData((const char*)packed, sizeof(packed));
+            }
+        }
+    }
+
+    if (head) {
+        head->toFrameData(stream);
+    }
+    return frameData;
+}
+
+void AvatarData::fromBinaryFrame(const QByteArray& frameData) {
+    QDataStream stream(frameData);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream.skipRawData(AVATAR_FRAME_MAGIC.size());
+
+    uint8_t version;
+    uint8_t flags;
+    stream >> version >> flags;
+    if (version > (uint8_t)BinaryAvatarFrameVersion::Initial) {
+        quint64 now = usecTimestampNow();
+        if (shouldLogError(now)) {
+            qCWarning(avatars) << "Unsupported avatar recording frame version" << version;
+        }
+        return;
+    }
+
+    QByteArray entitiesData;
+    if (flags & AvatarFrameIsKeyframe) {
+        stream >> entitiesData;
+    }
+
+    Transform basis;
+    Transform relativeTransform;
+    if (flags & AvatarFrameHasBasis) {
+        basis = readTransform(stream);
+    }
+    if (flags & AvatarFrameHasRelative) {
+        relativeTransform = readTransform(stream);
+    }
+    float scale;
+    stream >> scale;
+
+    uint16_t numJoints;
+    stream >> numJoints;
+    QVector<JointData> jointArray(numJoints);
+    if (numJoints > 0) {
+        int bitVectorSize = calcBitVectorSize(numJoints);
+        QByteArray bitVectors(2 * bitVectorSize, 0);
+        stream.readRawData(bitVectors.data(), bitVectors.size());
+        readBitVector((const uint8_t*)bitVectors.constData(), numJoints, [&](int i, bool isDefault) {
+            jointArray[i].rotationIsDefaultPose = isDefault;
+        });
+        readBitVector((const uint8_t*)bitVectors.constData() + bitVectorSize, numJoints, [&](int i, bool isDefault) {
+            jointArray[i].translationIsDefaultPose = isDefault;
+        });
+
+        float maxTranslationDimension;
+        stream >> maxTranslationDimension;
+
+        unsigned char packed[6];
+        for (auto& joint : jointArray) {
+            if (!joint.rotationIsDefaultPose && stream.readRawData((char*)packed, sizeof(packed)) == sizeof(packed)) {
+                unpackOrientationQuatFromSixBytes(packed, joint.rotation);
+            }
+        }
+        for (auto& joint : jointArray) {
+            if (!joint.translationIsDefaultPose && stream.readRawData((char*)packed, sizeof(packed)) == sizeof(packed)) {
+                unpackFloatVec3FromSignedTwoByteFixed(packed, joint.translation, TRANSLATION_COMPRESSION_RADIX);
+                joint.translation *= maxTranslationDimension;
+            }
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        quint64 now = usecTimestampNow();
+        if (shouldLogError(now)) {
+            qCWarning(avatars) << "Truncated avatar recording frame of" << frameData.size() << "bytes";
+        }
+        return;
+    }
+
+    // From here on this mirrors fromJson, less the skeleton model URL and display name, which are in skeleton frames
+    auto currentBasis = getRecordingBasis();
+    if (!currentBasis) {
+        currentBasis = std::make_shared<Transform>(basis);
+    }
+
+    glm::quat orientation;
+    if (flags & AvatarFrameHasRelative) {
+        auto worldTransform = currentBasis->worldTransform(relativeTransform);
+        setWorldPosition(worldTransform.getTranslation());
+        orientation = worldTransform.getRotation();
+    } else {
+        setWorldPosition(currentBasis->getTranslation());
+        orientation = currentBasis->getRotation();
+    }
+    setWorldOrientation(orientation);
+    updateAttitude(orientation);
+
+    // Do after avatar orientation because head look-at needs avatar orientation.
+    if (flags & AvatarFrameHasHead) {
+        if (!_headData) {
+            _headData = new HeadData(this);
+        }
+        _headData->fromFrameData(stream);
+    }
+
+    if (scale != 1.0f) {
+        setTargetScale(scale);
+    }
+
+    if (!getAttachmentData().isEmpty()) {
+        setAttachmentData(QVector<AttachmentData>());
+    }
+
+    if (!entitiesData.isEmpty()) {
+        updateAvatarEntitiesFromJson(*this, QJsonDocument::fromBinaryData(entitiesData).array());
+    }
+
+    setRawJointData(jointArray);
+}
+
 // Every frame will store both a basis for the recording and a relative transform
 // This allows the application to decide whether playback should be relative to an avatar's
 // transform at the start of playback, or relative to the transform of the recorded
 // avatar
-QByteArray AvatarData::toFrame(const AvatarData& avatar) {
-    QJsonObject root = avatar.toJson();
+QByteArray AvatarData::toFrame(const AvatarData& avatar, bool isKeyframe) {
 #ifdef WANT_JSON_DEBUG
     {
-        QJsonObject obj = root;
+        QJsonObject obj = avatar.toJson();
         obj.remove(JSON_AVATAR_JOINT_ARRAY);
         qCDebug(avatars).noquote() << QJsonDocument(obj).toJson(QJsonDocument::JsonFormat::Indented);
     }
 #endif
-    return QJsonDocument(root).toBinaryData();
+    return avatar.toBinaryFrame(isKeyframe);
 }
 
 
+bool AvatarData::frameHasSkeleton(const QByteArray& frameData) {
+    return !frameData.startsWith(AVATAR_FRAME_MAGIC);
+}
+
+QByteArray AvatarData::toSkeletonFrame(const AvatarData& avatar) {
+    QByteArray frameData;
+    QDataStream stream(&frameData, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << (uint8_t)BinaryAvatarFrameVersion::Initial;
+    stream << avatar.getSkeletonModelURL().toString().toUtf8() << avatar.getDisplayName().toUtf8();
+    return frameData;
+}
+
+void AvatarData::fromSkeletonFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    QDataStream stream(frameData);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    uint8_t version;
+    QByteArray bodyModelURL;
+    QByteArray displayName;
+    stream >> version >> bodyModelURL >> displayName;
+    if (stream.status() != QDataStream::Ok || version > (uint8_t)BinaryAvatarFrameVersion::Initial) {
+        quint64 now = usecTimestampNow();
+        if (result.shouldLogError(now)) {
+            qCWarning(avatars) << "Unreadable avatar recording skeleton frame of" << frameData.size() << "bytes";
+        }
+        return;
+    }
+
+    if (useFrameSkeleton && !bodyModelURL.isEmpty()) {
+        QString bodyModel = QString::fromUtf8(bodyModelURL);
+        if (bodyModel != result.getSkeletonModelURL().toString()) {
+            result.setSkeletonModelURL(bodyModel);
+        }
+    }
+
+    QString newDisplayName = QString::fromUtf8(displayName);
+    if (newDisplayName != result.getDisplayName()) {
+        result.setDisplayName(newDisplayName);
+    }
+}
+
 void AvatarData::fromFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    if (frameData.startsWith(AVATAR_FRAME_MAGIC)) {
+        result.fromBinaryFrame(frameData);
+        return;
+    }
+
+    // Recorded by a version that wrote frames as binary JSON
     QJsonDocument doc = QJsonDocument::fromBinaryData(frameData);
 
 #ifdef WANT_JSON_DEBUG
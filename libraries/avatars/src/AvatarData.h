@@ -598,9 +598,20 @@ public:
     virtual QString getName() const override { return QString("Avatar:") + _displayName; }
 
     static const QString FRAME_NAME;
+    static const QString SKELETON_FRAME_NAME;
+
+    // Recorded frames are written in a compact binary form.  The skeleton model URL and display name go in a separate
+    // skeleton frame, recorded with every keyframe and whenever they change.  Keyframes additionally carry the avatar
+    // entities, which rarely change during a recording.  Frames written as JSON by older versions carry
+    // everything and are still read.
+    static const float RECORDING_KEYFRAME_INTERVAL_SECS;
 
     static void fromFrame(const QByteArray& frameData, AvatarData& avatar, bool useFrameSkeleton = true);
-    static QByteArray toFrame(const AvatarData& avatar);
+    static QByteArray toFrame(const AvatarData& avatar, bool isKeyframe = true);
+    static bool frameHasSkeleton(const QByteArray& frameData);
+
+    static void fromSkeletonFrame(const QByteArray& frameData, AvatarData& avatar, bool useFrameSkeleton = true);
+    static QByteArray toSkeletonFrame(const AvatarData& avatar);
 
     AvatarData();
     virtual ~AvatarData();
@@ -1389,6 +1400,8 @@ public:
     virtual void avatarEntityDataToJson(QJsonObject& root) const;
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json, bool useFrameSkeleton = true);
+    QByteArray toBinaryFrame(bool isKeyframe) const;
+    void fromBinaryFrame(const QByteArray& frameData);
 
     glm::vec3 getClientGlobalPosition() const { return _globalPosition; }
     AABox getGlobalBoundingBox() const { return AABox(_globalPosition + _globalBoundingBoxOffset - _globalBoundingBoxDimensions, _globalBoundingBoxDimensions); }
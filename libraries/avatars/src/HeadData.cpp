@@ -13,11 +13,13 @@
 
 #include <mutex>
 
+#include <QtCore/QDataStream>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
 #include <QVector>
 
 #include <GLMHelpers.h>
+#include <StreamUtils.h>
 #include <shared/JSONHelpers.h>
 
 #include "AvatarData.h"
@@ -202,6 +204,102 @@ void HeadData::fromJson(const QJsonObject& json) {
     }
 }
 
+enum HeadFrameDataFlags : uint8_t {
+    HeadFrameHasRotation = 0x1,
+    HeadFrameHasLookAt = 0x2
+};
+
+void HeadData::toFrameData(QDataStream& stream) const {
+    glm::quat rawOrientation = getRawOrientation();
+    auto lookAt = getLookAtPosition();
+
+    uint8_t flags = 0;
+    if (rawOrientation != quat()) {
+        flags |= HeadFrameHasRotation;
+    }
+    if (lookAt != vec3()) {
+        flags |= HeadFrameHasLookAt;
+    }
+    stream << flags;
+
+    if (flags & HeadFrameHasRotation) {
+        unsigned char packedRotation[6];
+        packOrientationQuatToSixBytes(packedRotation, rawOrientation);
+        stream.writeRawData((const char*)packedRotation, sizeof(packedRotation));
+    }
+    if (flags & HeadFrameHasLookAt) {
+        stream << glm::inverse(_owningAvatar->getWorldOrientation()) * (lookAt - _owningAvatar->getWorldPosition());
+    }
+
+    // Only the nonzero blendshapes, as (index, value) pairs
+    int blendshapeCount = std::min(getNumSummedBlendshapeCoefficients(), (int)Blendshapes::BlendshapeCount);
+    QVector<QPair<uint8_t, float>> blendshapes;
+    for (int index = 0; index < blendshapeCount; ++index) {
+        float value = 0.0f;
+        if (index < _blendshapeCoefficients.size()) {
+            value += _blendshapeCoefficients[index];
+        }
+        if (index < _transientBlendshapeCoefficients.size()) {
+            value += _transientBlendshapeCoefficients[index];
+        }
+        if (value != 0.0f) {
+            blendshapes.push_back({ (uint8_t)index, value });
+        }
+    }
+    stream << (uint8_t)blendshapes.size();
+    for (const auto& blendshape : blendshapes) {
+        stream << blendshape.first << blendshape.second;
+    }
+}
+
+void HeadData::fromFrameData(QDataStream& stream) {
+    uint8_t flags;
+    stream >> flags;
+
+    glm::quat rotation;
+    if (flags & HeadFrameHasRotation) {
+        unsigned char packedRotation[6];
+        if (stream.readRawData((char*)packedRotation, sizeof(packedRotation)) != sizeof(packedRotation)) {
+            return;
+        }
+        unpackOrientationQuatFromSixBytes(packedRotation, rotation);
+    }
+    glm::vec3 relativeLookAt;
+    if (flags & HeadFrameHasLookAt) {
+        stream >> relativeLookAt;
+    }
+
+    uint8_t blendshapeCount;
+    stream >> blendshapeCount;
+    for (int i = 0; i < blendshapeCount && stream.status() == QDataStream::Ok; ++i) {
+        uint8_t index;
+        float value;
+        stream >> index >> value;
+        if (index >= (int)Blendshapes::BlendshapeCount) {
+            continue;
+        }
+        if (_blendshapeCoefficients.size() <= index) {
+            _blendshapeCoefficients.resize(index + 1);
+        }
+        if (_transientBlendshapeCoefficients.size() <= index) {
+            _transientBlendshapeCoefficients.resize(index + 1);
+        }
+        _blendshapeCoefficients[index] = value;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    // Same order as fromJson
+    if (glm::length2(relativeLookAt) > 0.01f) {
+        setLookAtPosition((_owningAvatar->getWorldOrientation() * relativeLookAt) + _owningAvatar->getWorldPosition());
+    }
+    if (flags & HeadFrameHasRotation) {
+        setHeadOrientation(rotation);
+    }
+}
+
 bool HeadData::getProceduralAnimationFlag(ProceduralAnimationType type) const {
     return _userProceduralAnimationFlags[(int)type];
 }
@@ -31,6 +31,7 @@ const float MIN_HEAD_ROLL = -50.0f;
 const float MAX_HEAD_ROLL = 50.0f;
 
 class AvatarData;
+class QDataStream;
 class QJsonObject;
 
 class HeadData {
@@ -102,6 +103,10 @@ public:
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json);
 
+    // Compact equivalents of toJson / fromJson, used by binary avatar recording frames
+    void toFrameData(QDataStream& stream) const;
+    void fromFrameData(QDataStream& stream);
+
 protected:
     // degrees
     float _baseYaw;
@@ -12,6 +12,8 @@
 
 #include "EntityItemProperties.h"
 
+#include <algorithm>
+
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -3044,7 +3046,10 @@ void EntityPropertyInfoFromScriptValue(const QScriptValue& object, EntityPropert
 OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItemID id, const EntityItemProperties& properties,
                 QByteArray& buffer, EntityPropertyFlags requestedProperties, EntityPropertyFlags& didntFitProperties) {
 
-    OctreePacketData ourDataPacket(false, buffer.size()); // create a packetData object to add out packet details too.
+    // Scripts can send thousands of edits a second, so each thread keeps one packetData to encode them all into rather
+    // than allocating a buffer the size of the packet for every edit
+    static thread_local OctreePacketData ourDataPacket;
+    ourDataPacket.changeSettings(false, buffer.size());
     OctreePacketData* packetData = &ourDataPacket; // we want a pointer to this so we can use our APPEND_ENTITY_PROPERTY macro
 
     bool success = true; // assume the best
@@ -3592,32 +3597,31 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     valid = true;
 
     // Entity Type...
-    QByteArray encodedType((const char*)dataAt, (bytesToRead - processedBytes));
-    ByteCountCoded<quint32> typeCoder = encodedType;
+    // decoded in place, rather than from a copy of the rest of the packet
+    ByteCountCoded<quint32> typeCoder;
+    int encodedTypeLength = (int)typeCoder.decode((const char*)dataAt, bytesToRead - processedBytes);
     quint32 entityTypeCode = typeCoder;
     properties.setType((EntityTypes::EntityType)entityTypeCode);
-    encodedType = typeCoder; // determine true bytesToRead
-    dataAt += encodedType.size();
-    processedBytes += encodedType.size();
+    dataAt += encodedTypeLength;
+    processedBytes += encodedTypeLength;
 
     // Update Delta - when was this item updated relative to last edit... this really should be 0
     // TODO: Should we get rid of this in this in edit packets, since this has to always be 0?
     // TODO: do properties need to handle lastupdated???
 
     // last updated is stored as ByteCountCoded delta from lastEdited
-    QByteArray encodedUpdateDelta((const char*)dataAt, (bytesToRead - processedBytes));
-    ByteCountCoded<quint64> updateDeltaCoder = encodedUpdateDelta;
-    encodedUpdateDelta = updateDeltaCoder; // determine true bytesToRead
-    dataAt += encodedUpdateDelta.size();
-    processedBytes += encodedUpdateDelta.size();
+    ByteCountCoded<quint64> updateDeltaCoder;
+    int encodedUpdateDeltaLength = (int)updateDeltaCoder.decode((const char*)dataAt, bytesToRead - processedBytes);
+    dataAt += encodedUpdateDeltaLength;
+    processedBytes += encodedUpdateDeltaLength;
 
     // TODO: Do we need this lastUpdated?? We don't seem to use it.
     //quint64 updateDelta = updateDeltaCoder;
     //quint64 lastUpdated = lastEdited + updateDelta; // don't adjust for clock skew since we already did that for lastEdited
 
     // Property Flags...
-    QByteArray encodedPropertyFlags((const char*)dataAt, (bytesToRead - processedBytes));
-    EntityPropertyFlags propertyFlags = encodedPropertyFlags;
+    EntityPropertyFlags propertyFlags;
+    propertyFlags.decode(dataAt, std::max(bytesToRead - processedBytes, 0));
     dataAt += propertyFlags.getEncodedLength();
     processedBytes += propertyFlags.getEncodedLength();
 
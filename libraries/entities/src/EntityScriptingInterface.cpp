@@ -743,9 +743,12 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     QVector<EntityPropertiesResult> resultProperties;
     if (_entityTree) {
         PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Obtaining Properties");
+        // The properties are copied under the tree lock, a chunk of entities at a time so that large queries
+        // don't hold off edits for long, and converted for the script after releasing it.
         int i = 0;
         const int lockAmount = 500;
         int size = entityIDs.size();
+        resultProperties.reserve(size);
         while (i < size) {
             _entityTree->withReadLock([&] {
                 for (int j = 0; j < lockAmount && i < size; ++i, ++j) {
@@ -1287,6 +1290,31 @@ RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionVecto
     return evalRayIntersectionWorker(ray, Octree::Lock, searchFilter, entityIdsToInclude, entityIdsToDiscard);
 }
 
+std::vector<RayToEntityIntersectionResult> EntityScriptingInterface::evalRayIntersectionVectors(std::vector<EntityTree::RayQuery>& queries) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    std::vector<RayToEntityIntersectionResult> results(queries.size());
+    if (_entityTree) {
+        bool accurate = true;
+        _entityTree->evalRayIntersections(queries, Octree::Lock, &accurate);
+        for (size_t i = 0; i < queries.size(); i++) {
+            const auto& query = queries[i];
+            auto& result = results[i];
+            result.accurate = accurate;
+            result.intersects = !query.entityID.isNull();
+            if (result.intersects) {
+                result.entityID = query.entityID;
+                result.distance = query.distance;
+                result.face = query.face;
+                result.surfaceNormal = query.surfaceNormal;
+                result.extraInfo = query.extraInfo;
+                result.intersection = query.origin + (query.direction * query.distance);
+            }
+        }
+    }
+    return results;
+}
+
 RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionWorker(const PickRay& ray,
         Octree::lockType lockType, PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard) const {
@@ -189,6 +189,8 @@ public:
 
     RayToEntityIntersectionResult evalRayIntersectionVector(const PickRay& ray, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
+    // Intersects several rays with entities in a single traversal of the tree, see EntityTree::evalRayIntersections
+    std::vector<RayToEntityIntersectionResult> evalRayIntersectionVectors(std::vector<EntityTree::RayQuery>& queries);
     ParabolaToEntityIntersectionResult evalParabolaIntersectionVector(const PickParabola& parabola, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
 
@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <cfloat>
+
 #include <QSet>
 #include <QVector>
 
@@ -90,6 +92,11 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool canDecodeEditPacketType(PacketType packetType) const override;
+    virtual int decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     OctreeDecodedEditPointer& decodedEdit) const override;
+    virtual void processDecodedEdit(ReceivedMessage& message, OctreeDecodedEdit& decodedEdit,
+                                    const SharedNodePointer& senderNode) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -100,6 +107,28 @@ public:
         BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    // A ray to intersect with entities as part of a batch, see evalRayIntersections
+    class RayQuery {
+    public:
+        // Inputs
+        glm::vec3 origin;
+        glm::vec3 direction;
+        QVector<EntityItemID> entityIdsToInclude;
+        QVector<EntityItemID> entityIdsToDiscard;
+        PickFilter searchFilter;
+
+        // Outputs
+        EntityItemID entityID;
+        float distance { FLT_MAX };
+        BoxFace face { UNKNOWN_FACE };
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+    };
+
+    // Same results as calling evalRayIntersection for each query, but the tree is locked and traversed once:
+    // each element is tested against all the rays that can still find a closer hit in it.
+    void evalRayIntersections(std::vector<RayQuery>& queries, Octree::lockType lockType = Octree::Lock, bool* accurateResult = nullptr);
+
     virtual EntityItemID evalParabolaIntersection(const PickParabola& parabola,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
         PickFilter searchFilter, OctreeElementPointer& element, glm::vec3& intersection,
@@ -197,6 +226,8 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+    virtual bool readFromParsedJSON(QVariantMap& entityDescription, const OctreeEntitiesFileParser& parser,
+                                    const QString& marketplaceID, const bool isImport) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
 
 
@@ -308,6 +339,15 @@ protected:
 
     bool isScriptInWhitelist(const QString& scriptURL);
 
+    void readHeaderFromMap(const QVariantMap& map);
+    QString getMyAvatarParentJointName(const QVariantMap& entityMap) const;
+    void setParentJointIndexFromName(EntityItemProperties& properties, const QString& parentJointName) const;
+    void entityPropertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                 EntityItemID& entityItemID, EntityItemProperties& properties) const;
+    void addEntityFromFile(const EntityItemID& entityItemID, const EntityItemProperties& properties, const bool isImport,
+                           QMap<QUuid, QVector<QUuid>>& cloneIDs, bool& success);
+    void setCloneIDsFromFile(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
 
@@ -374,6 +414,9 @@ protected:
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
     bool filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType) const;
+    void processDecodedEntityEdit(PacketType packetType, const EntityItemID& entityItemID, EntityItemProperties& properties,
+                                  bool validEditPacket, const EntityItemID& entityIDToClone,
+                                  const EntityItemPointer& entityToClone, const SharedNodePointer& senderNode);
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceWhitelist;
 
@@ -30,13 +30,21 @@ bool RecurseOctreeToJSONOperator::postRecursion(const OctreeElementPointer& elem
 }
 
 void RecurseOctreeToJSONOperator::processEntity(const EntityItemPointer& entity) {
-    if (_skipThoseWithBadParents && !entity->isParentIDValid()) {
-        return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+    if (skipsEntity(entity)) {
+        return;
     }
+    processProperties(entity->getProperties());
+}
+
+bool RecurseOctreeToJSONOperator::skipsEntity(const EntityItemPointer& entity) const {
+    // we weren't able to resolve a parent from _parentID, so don't save this entity.
+    return _skipThoseWithBadParents && !entity->isParentIDValid();
+}
 
+void RecurseOctreeToJSONOperator::processProperties(const EntityItemProperties& properties) {
     QScriptValue qScriptValues = _skipDefaults
-        ? EntityItemNonDefaultPropertiesToScriptValue(_engine, entity->getProperties())
-        : EntityItemPropertiesToScriptValue(_engine, entity->getProperties());
+        ? EntityItemNonDefaultPropertiesToScriptValue(_engine, properties)
+        : EntityItemPropertiesToScriptValue(_engine, properties);
 
     if (_comma) {
         _json += ',';
@@ -20,8 +20,13 @@ public:
 
     QString getJson() const { return _json; }
 
-private:
     void processEntity(const EntityItemPointer& entity);
+    bool skipsEntity(const EntityItemPointer& entity) const;
+    // Appends an entity from a copy of its properties, which lets callers take the copies under the tree lock and
+    // do the slower conversion to JSON after releasing it
+    void processProperties(const EntityItemProperties& properties);
+
+private:
 
     QScriptEngine* _engine;
     QScriptValue _toStringMethod;
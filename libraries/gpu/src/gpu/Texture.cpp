@@ -18,6 +18,9 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QThread>
+
+#include <tbb/parallel_for.h>
+
 #include <Trace.h>
 
 #include <ktx/KTX.h>
@@ -693,23 +696,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
 
     const uint sqOrder = order*order;
 
-    // allocate memory for calculations
-    output.resize(sqOrder);
-    std::vector<float> resultR(sqOrder);
-    std::vector<float> resultG(sqOrder);
-    std::vector<float> resultB(sqOrder);
-
-    // initialize values
-    float fWt = 0.0f;
-    for(uint i=0; i < sqOrder; i++) {
-        output[i] = glm::vec3(0.0f);
-        resultR[i] = 0.0f;
-        resultG[i] = 0;
-        resultB[i] = 0;
-    }
-    std::vector<float> shBuff(sqOrder);
-    std::vector<float> shBuffB(sqOrder);
-
     // We trade accuracy for speed by breaking the image into 32x32 parts
     // and approximating the distance for all the pixels in each part to be
     // the distance to the part's center.
@@ -720,23 +706,71 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
     int stride = width / numDivisionsPerSide;
     int halfStride = stride / 2;
 
-    // for each face of cube texture
-    for(int face=0; face < gpu::Texture::NUM_CUBE_FACES; face++) {
-        PROFILE_RANGE(render_gpu, "ProcessFace");
-
-        auto data = cubeTexture.accessStoredMipFace(0, face)->readData();
-        if (data == nullptr) {
-            continue;
+    // step between two texels for range [0, 1]
+    const float invWidth = 1.0f / float(width);
+    // initial negative bound for range [-1, 1]
+    const float negativeBound = -1.0f + invWidth;
+    // step between two texels for range [-1, 1]
+    const float invWidthBy2 = 2.0f / float(width);
+
+    std::function<glm::vec3(uint32)> unpackFunc;
+    if (target != gpu::BackendTarget::GLES32) {
+        auto mipFormat = cubeTexture.getStoredMipFormat();
+        switch (mipFormat.getSemantic()) {
+        case gpu::R11G11B10:
+            unpackFunc = glm::unpackF2x11_1x10;
+            break;
+        case gpu::RGB9E5:
+            unpackFunc = glm::unpackF3x9_E1x5;
+            break;
+        default:
+            assert(false);
+            break;
         }
+    }
+
+    // the faces are held for as long as their rows are processed
+    std::vector<gpu::Texture::PixelsPointer> faces(gpu::Texture::NUM_CUBE_FACES);
+    for (int face = 0; face < gpu::Texture::NUM_CUBE_FACES; face++) {
+        faces[face] = cubeTexture.accessStoredMipFace(0, face);
+    }
+
+    int rowsPerFace = 0;
+    for (int y = halfStride; y < width - halfStride; y += stride) {
+        rowsPerFace++;
+    }
+
+    // The coefficients of each row of parts, summed up in order afterwards so that the result doesn't depend on how
+    // the rows were spread over the threads
+    struct RowCoefficients {
+        float weight { 0.0f };
+        std::vector<float> resultR;
+        std::vector<float> resultG;
+        std::vector<float> resultB;
+    };
+    std::vector<RowCoefficients> rows(gpu::Texture::NUM_CUBE_FACES * rowsPerFace);
 
-        // step between two texels for range [0, 1]
-        float invWidth = 1.0f / float(width);
-        // initial negative bound for range [-1, 1]
-        float negativeBound = -1.0f + invWidth;
-        // step between two texels for range [-1, 1]
-        float invWidthBy2 = 2.0f / float(width);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, rows.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        std::vector<float> shBuff(sqOrder);
+        std::vector<float> shBuffB(sqOrder);
+
+        for (auto row = range.begin(); row < range.end(); row++) {
+            const int face = (int)row / rowsPerFace;
+            const int y = halfStride + ((int)row % rowsPerFace) * stride;
+
+            auto data = faces[face] ? faces[face]->readData() : nullptr;
+            if (data == nullptr) {
+                continue;
+            }
+
+            auto& rowCoefficients = rows[row];
+            auto& resultR = rowCoefficients.resultR;
+            auto& resultG = rowCoefficients.resultG;
+            auto& resultB = rowCoefficients.resultB;
+            resultR.resize(sqOrder, 0.0f);
+            resultG.resize(sqOrder, 0.0f);
+            resultB.resize(sqOrder, 0.0f);
 
-        for(int y=halfStride; y < width-halfStride; y += stride) {
             // texture coordinate V in range [-1 to 1]
             const float fV = negativeBound + float(y) * invWidthBy2;
 
@@ -787,8 +821,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                     dir.z = - 1.0f;
                     break;
                 }
-                default:
-                    return false;
                 }
 
                 // normalize direction
@@ -797,30 +829,15 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                 // scale factor depending on distance from center of the face
                 const float fDiffSolid = 4.0f / ((1.0f + fU*fU + fV*fV) *
                                             sqrtf(1.0f + fU*fU + fV*fV));
-                fWt += fDiffSolid;
+                rowCoefficients.weight += fDiffSolid;
 
                 // calculate coefficients of spherical harmonics for current direction
                 sphericalHarmonicsEvaluateDirection(shBuff.data(), order, dir);
 
-                // index of texel in texture
-
                 // get color from texture
                 glm::vec3 color{ 0.0f, 0.0f, 0.0f };
 
                 if (target != gpu::BackendTarget::GLES32) {
-                    auto mipFormat = cubeTexture.getStoredMipFormat();
-                    std::function<glm::vec3(uint32)> unpackFunc;
-                    switch (mipFormat.getSemantic()) {
-                    case gpu::R11G11B10:
-                        unpackFunc = glm::unpackF2x11_1x10;
-                        break;
-                    case gpu::RGB9E5:
-                        unpackFunc = glm::unpackF3x9_E1x5;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                    }
                     auto data32 = reinterpret_cast<const uint32*>(data);
                     for (int i = 0; i < stride; ++i) {
                         for (int j = 0; j < stride; ++j) {
@@ -839,7 +856,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                     }
                 }
 
-
                 // scale color and add to previously accumulated coefficients
                 // red
                 sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), color.r * fDiffSolid);
@@ -852,6 +868,20 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                 sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), shBuffB.data());
             }
         }
+    });
+
+    std::vector<float> resultR(sqOrder, 0.0f);
+    std::vector<float> resultG(sqOrder, 0.0f);
+    std::vector<float> resultB(sqOrder, 0.0f);
+    float fWt = 0.0f;
+    for (const auto& row : rows) {
+        if (row.resultR.empty()) {
+            continue;
+        }
+        fWt += row.weight;
+        sphericalHarmonicsAdd(resultR.data(), order, resultR.data(), row.resultR.data());
+        sphericalHarmonicsAdd(resultG.data(), order, resultG.data(), row.resultG.data());
+        sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), row.resultB.data());
     }
 
     // final scale for coefficients
@@ -861,6 +891,7 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
     sphericalHarmonicsScale(resultB.data(), order, resultB.data(), fNormProj);
 
     // save result
+    output.resize(sqOrder);
     for(uint i=0; i < sqOrder; i++) {
         output[i] = glm::vec3(resultR[i], resultG[i], resultB[i]);
     }
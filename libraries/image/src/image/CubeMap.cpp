@@ -16,6 +16,7 @@
 #include "RandomAndNoise.h"
 #include "BRDF.h"
 #include "ImageLogging.h"
+#include "TextureProcessing.h"
 
 #ifndef M_PI
 #define M_PI    3.14159265359
@@ -506,6 +507,15 @@ glm::vec4 CubeMap::fetchLod(const glm::vec3& dir, float lod) const {
 struct CubeMap::GGXSamples {
     float invTotalWeight;
     std::vector<glm::vec4> points;
+
+    // The points as separate arrays, along with the two mip levels each one is fetched from and the weight between
+    // them, so that a texel only has to turn them to world space and fetch
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<gpu::uint16> loLevels;
+    std::vector<gpu::uint16> hiLevels;
+    std::vector<float> lodFracs;
 };
 
 // All the GGX convolution code is inspired from:
@@ -567,16 +577,40 @@ void CubeMap::generateGGXSamples(GGXSamples& data, float roughness, const int re
     data.invTotalWeight = 1.0f / data.invTotalWeight;
 }
 
-void CubeMap::convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProcessing) const {
+void CubeMap::prepareGGXSamples(GGXSamples& data) const {
+    const auto sampleCount = data.points.size();
+    const float maxLod = (float)(_mips.size() - 1);
+
+    data.x.resize(sampleCount);
+    data.y.resize(sampleCount);
+    data.z.resize(sampleCount);
+    data.loLevels.resize(sampleCount);
+    data.hiLevels.resize(sampleCount);
+    data.lodFracs.resize(sampleCount);
+
+    for (size_t i = 0; i < sampleCount; ++i) {
+        const auto& point = data.points[i];
+        // Same as in fetchLod
+        float lod = glm::clamp<float>(point.w, 0.0f, maxLod);
+
+        data.x[i] = point.x;
+        data.y[i] = point.y;
+        data.z[i] = point.z;
+        data.loLevels[i] = (gpu::uint16)std::floor(lod);
+        data.hiLevels[i] = (gpu::uint16)std::ceil(lod);
+        data.lodFracs[i] = lod - (float)data.loLevels[i];
+    }
+}
+
+void CubeMap::generateMipGGXSamples(std::vector<GGXSamples>& mipSamples) const {
     // This should match the value in the getMipLevelFromRoughness function (LightAmbient.slh)
     static const float ROUGHNESS_1_MIP_RESOLUTION = 1.5f;
     static const size_t MAX_SAMPLE_COUNT = 4000;
 
     const auto mipCount = getMipCount();
-    GGXSamples params;
-
-    params.points.reserve(MAX_SAMPLE_COUNT);
+    mipSamples.resize(mipCount);
 
+    // The samples of every mip are made up front, as generateGGXSamples relies on rand() and can't run in parallel
     for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
         // This is the inverse code found in LightAmbient.slh in getMipLevelFromRoughness
         float levelAlpha = float(mipLevel) / (mipCount - ROUGHNESS_1_MIP_RESOLUTION);
@@ -591,19 +625,63 @@ void CubeMap::convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProc
         sampleCount = std::min(sampleCount, 2 * mipTotalPixelCount);
         sampleCount = std::min(MAX_SAMPLE_COUNT, sampleCount);
 
+        auto& params = mipSamples[mipLevel];
         params.points.resize(sampleCount);
         generateGGXSamples(params, mipRoughness, _width);
+        prepareGGXSamples(params);
+    }
+}
+
+void CubeMap::convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProcessing) const {
+    // Few enough rows that even the smaller mips are spread over several threads
+    static const int ROWS_PER_TILE = 4;
 
+    const auto mipCount = getMipCount();
+    std::vector<GGXSamples> mipSamples;
+    generateMipGGXSamples(mipSamples);
+
+    struct Tile {
+        gpu::uint16 mipLevel;
+        int face;
+        int rowBegin;
+        int rowEnd;
+    };
+
+    // All the mips and faces are convolved at once, rather than one face of one mip after the other, so that the
+    // threads stay busy through the small mips with many samples
+    std::vector<Tile> tiles;
+    for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
+        const int mipHeight = output.getMipHeight(mipLevel);
         for (int face = 0; face < 6; face++) {
-            convolveMipFaceForGGX(params, output, mipLevel, face, abortProcessing);
-            if (abortProcessing.load()) {
-                return;
+            for (int row = 0; row < mipHeight; row += ROWS_PER_TILE) {
+                tiles.push_back({ mipLevel, face, row, std::min(row + ROWS_PER_TILE, mipHeight) });
             }
         }
     }
+
+    std::vector<ConstMip> mips;
+    mips.reserve(mipCount);
+    for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
+        mips.emplace_back(mipLevel, this);
+    }
+
+    runInTextureProcessingArena([&] {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, tiles.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+            std::vector<float> directions;
+            for (auto i = range.begin(); i < range.end(); i++) {
+                if (abortProcessing.load()) {
+                    break;
+                }
+                const auto& tile = tiles[i];
+                convolveRowsForGGX(mipSamples[tile.mipLevel], mips, output, tile.mipLevel, tile.face, tile.rowBegin, tile.rowEnd,
+                                   directions);
+            }
+        });
+    });
 }
 
-void CubeMap::convolveMipFaceForGGX(const GGXSamples& samples, CubeMap& output, gpu::uint16 mipLevel, int face, const std::atomic<bool>& abortProcessing) const {
+void CubeMap::convolveRowsForGGX(const GGXSamples& samples, const std::vector<ConstMip>& mips, CubeMap& output,
+                                 gpu::uint16 mipLevel, int face, int rowBegin, int rowEnd, std::vector<float>& directions) const {
     const glm::vec3* faceNormals = FACE_NORMALS + face * 4;
     const glm::vec3 deltaYNormalLo = faceNormals[2] - faceNormals[0];
     const glm::vec3 deltaYNormalHi = faceNormals[3] - faceNormals[1];
@@ -611,50 +689,112 @@ void CubeMap::convolveMipFaceForGGX(const GGXSamples& samples, CubeMap& output,
     const auto outputLineStride = output.getMipLineStride(mipLevel);
     auto outputFacePixels = output.editFace(mipLevel, face);
 
-    tbb::parallel_for(tbb::blocked_range2d<int, int>(0, mipDimensions.y, 32, 0, mipDimensions.x, 32), [&](const tbb::blocked_range2d<int, int>& range) {
-        auto rowRange = range.rows();
-        auto colRange = range.cols();
-
-        for (auto y = rowRange.begin(); y < rowRange.end(); y++) {
-            if (abortProcessing.load()) {
-                break;
-            }
-
-            const float yAlpha = (y + 0.5f) / mipDimensions.y;
-            const glm::vec3 normalXLo = faceNormals[0] + deltaYNormalLo * yAlpha;
-            const glm::vec3 normalXHi = faceNormals[1] + deltaYNormalHi * yAlpha;
-            const glm::vec3 deltaXNormal = normalXHi - normalXLo;
+    for (auto y = rowBegin; y < rowEnd; y++) {
+        const float yAlpha = (y + 0.5f) / mipDimensions.y;
+        const glm::vec3 normalXLo = faceNormals[0] + deltaYNormalLo * yAlpha;
+        const glm::vec3 normalXHi = faceNormals[1] + deltaYNormalHi * yAlpha;
+        const glm::vec3 deltaXNormal = normalXHi - normalXLo;
 
-            for (auto x = colRange.begin(); x < colRange.end(); x++) {
-                const float xAlpha = (x + 0.5f) / mipDimensions.x;
-                // Interpolate normal for this pixel
-                const glm::vec3 normal = glm::normalize(normalXLo + deltaXNormal * xAlpha);
+        for (auto x = 0; x < mipDimensions.x; x++) {
+            const float xAlpha = (x + 0.5f) / mipDimensions.x;
+            // Interpolate normal for this pixel
+            const glm::vec3 normal = glm::normalize(normalXLo + deltaXNormal * xAlpha);
 
-                outputFacePixels[x + y * outputLineStride] = computeConvolution(normal, samples);
-            }
+            outputFacePixels[x + y * outputLineStride] = computeConvolution(normal, samples, mips, directions);
         }
-    });
+    }
 }
 
-glm::vec4 CubeMap::computeConvolution(const glm::vec3& N, const GGXSamples& samples) const {
+glm::vec4 CubeMap::computeConvolution(const glm::vec3& N, const GGXSamples& samples, const std::vector<ConstMip>& mips,
+                                      std::vector<float>& directions) {
     // from tangent-space vector to world-space
     glm::vec3 bitangent = std::abs(N.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
     glm::vec3 tangent = glm::normalize(glm::cross(bitangent, N));
     bitangent = glm::cross(N, tangent);
 
-    const size_t sampleCount = samples.points.size();
+    const size_t sampleCount = samples.x.size();
+    const float* sampleX = samples.x.data();
+    const float* sampleY = samples.y.data();
+    const float* sampleZ = samples.z.data();
+
+    directions.resize(3 * sampleCount);
+    float* directionX = directions.data();
+    float* directionY = directionX + sampleCount;
+    float* directionZ = directionY + sampleCount;
+
+    // Now back to world space, all the samples in one go, which the compiler turns into SIMD code
+    for (size_t i = 0; i < sampleCount; ++i) {
+        directionX[i] = tangent.x * sampleX[i] + bitangent.x * sampleY[i] + N.x * sampleZ[i];
+        directionY[i] = tangent.y * sampleX[i] + bitangent.y * sampleY[i] + N.y * sampleZ[i];
+        directionZ[i] = tangent.z * sampleX[i] + bitangent.z * sampleY[i] + N.z * sampleZ[i];
+    }
+
     glm::vec4 prefilteredColor = glm::vec4(0.0f);
 
     for (size_t i = 0; i < sampleCount; ++i) {
-        const auto& sample = samples.points[i];
-        glm::vec3 L(sample.x, sample.y, sample.z);
-        float NdotL = L.z;
-        float mipLevel = sample.w;
-        // Now back to world space
-        L = tangent * L.x + bitangent * L.y + N * L.z;
-        prefilteredColor += fetchLod(L, mipLevel) * NdotL;
+        int face;
+        glm::vec2 uv;
+        getFaceUV(glm::vec3(directionX[i], directionY[i], directionZ[i]), &face, &uv);
+
+        glm::vec4 color = mips[samples.loLevels[i]].fetch(face, uv);
+        const float lodFrac = samples.lodFracs[i];
+        if (lodFrac > 0.0f) {
+            glm::vec4 hiColor = mips[samples.hiLevels[i]].fetch(face, uv);
+            color += (hiColor - color) * lodFrac;
+        }
+        // Weighted by NdotL
+        prefilteredColor += color * sampleZ[i];
     }
     prefilteredColor = prefilteredColor * samples.invTotalWeight;
     prefilteredColor.a = 1.0f;
     return prefilteredColor;
-}
\ No newline at end of file
+}
+
+void CubeMap::convolveForGGXWithFetchLod(CubeMap& output) const {
+    const auto mipCount = getMipCount();
+    std::vector<GGXSamples> mipSamples;
+    generateMipGGXSamples(mipSamples);
+
+    for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
+        const auto& samples = mipSamples[mipLevel];
+        const auto mipDimensions = output.getMipDimensions(mipLevel);
+        const auto outputLineStride = output.getMipLineStride(mipLevel);
+
+        for (int face = 0; face < 6; face++) {
+            const glm::vec3* faceNormals = FACE_NORMALS + face * 4;
+            const glm::vec3 deltaYNormalLo = faceNormals[2] - faceNormals[0];
+            const glm::vec3 deltaYNormalHi = faceNormals[3] - faceNormals[1];
+            auto outputFacePixels = output.editFace(mipLevel, face);
+
+            for (int y = 0; y < mipDimensions.y; y++) {
+                const float yAlpha = (y + 0.5f) / mipDimensions.y;
+                const glm::vec3 normalXLo = faceNormals[0] + deltaYNormalLo * yAlpha;
+                const glm::vec3 normalXHi = faceNormals[1] + deltaYNormalHi * yAlpha;
+                const glm::vec3 deltaXNormal = normalXHi - normalXLo;
+
+                for (int x = 0; x < mipDimensions.x; x++) {
+                    const float xAlpha = (x + 0.5f) / mipDimensions.x;
+                    const glm::vec3 N = glm::normalize(normalXLo + deltaXNormal * xAlpha);
+
+                    // from tangent-space vector to world-space
+                    glm::vec3 bitangent = std::abs(N.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+                    glm::vec3 tangent = glm::normalize(glm::cross(bitangent, N));
+                    bitangent = glm::cross(N, tangent);
+
+                    glm::vec4 prefilteredColor = glm::vec4(0.0f);
+                    for (const auto& sample : samples.points) {
+                        glm::vec3 L(sample.x, sample.y, sample.z);
+                        float NdotL = L.z;
+                        float lod = sample.w;
+                        // Now back to world space
+                        L = tangent * L.x + bitangent * L.y + N * L.z;
+                        prefilteredColor += fetchLod(L, lod) * NdotL;
+                    }
+                    prefilteredColor = prefilteredColor * samples.invTotalWeight;
+                    prefilteredColor.a = 1.0f;
+                    outputFacePixels[x + y * outputLineStride] = prefilteredColor;
+                }
+            }
+        }
+    }
+}
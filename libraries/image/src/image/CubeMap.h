@@ -64,6 +64,9 @@ namespace image {
         Image getFaceImage(gpu::uint16 mipLevel, int face) const;
 
         void convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProcessing) const;
+        // The same convolution done one texel at a time through fetchLod, as it was before convolveForGGX used sample
+        // tables. Much slower, only meant to check the results of convolveForGGX against.
+        void convolveForGGXWithFetchLod(CubeMap& output) const;
         glm::vec4 fetchLod(const glm::vec3& dir, float lod) const;
 
     private:
@@ -81,9 +84,13 @@ namespace image {
 
         static void getFaceUV(const glm::vec3& dir, int* index, glm::vec2* uv);
         static void generateGGXSamples(GGXSamples& data, float roughness, const int resolution);
+        void generateMipGGXSamples(std::vector<GGXSamples>& mipSamples) const;
         static void copyFace(int width, int height, const glm::vec4* source, size_t srcLineStride, glm::vec4* dest, size_t dstLineStride);
-        void convolveMipFaceForGGX(const GGXSamples& samples, CubeMap& output, gpu::uint16 mipLevel, int face, const std::atomic<bool>& abortProcessing) const;
-        glm::vec4 computeConvolution(const glm::vec3& normal, const GGXSamples& samples) const;
+        void prepareGGXSamples(GGXSamples& data) const;
+        void convolveRowsForGGX(const GGXSamples& samples, const std::vector<ConstMip>& mips, CubeMap& output, gpu::uint16 mipLevel,
+                                int face, int rowBegin, int rowEnd, std::vector<float>& directions) const;
+        static glm::vec4 computeConvolution(const glm::vec3& normal, const GGXSamples& samples, const std::vector<ConstMip>& mips,
+                                            std::vector<float>& directions);
 
     };
 
@@ -14,6 +14,7 @@
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
+#include <QtCore/QThread>
 #include <QUrl>
 #include <QRgb>
 #include <QBuffer>
@@ -23,6 +24,7 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -500,24 +502,101 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
+static std::atomic<int> textureProcessingConcurrency { 0 };
+
+void setTextureProcessingConcurrency(int maxConcurrency) {
+    textureProcessingConcurrency.store(maxConcurrency);
+}
+
+int getTextureProcessingConcurrency() {
+    int maxConcurrency = textureProcessingConcurrency.load();
+    if (maxConcurrency > 0) {
+        return maxConcurrency;
+    }
+    // by default leave a core to the threads that aren't processing textures, like the main and render threads
+    return std::max(QThread::idealThreadCount() - 1, 1);
+}
+
+static tbb::task_arena& getTextureProcessingArena() {
+    // every thread loading or baking textures runs its parallel work in this arena,
+    // so that all of them together stay within the texture processing concurrency
+    static tbb::task_arena arena(getTextureProcessingConcurrency());
+    return arena;
+}
+
+void runInTextureProcessingArena(const std::function<void()>& function) {
+    getTextureProcessingArena().execute(function);
+}
+
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
-            if (!_abortProcessing.load()) {
-                task(context, i);
-            } else {
-                break;
-            }
-        }
+        getTextureProcessingArena().execute([&] {
+            tbb::parallel_for(0, count, [&](int i) {
+                if (!_abortProcessing.load()) {
+                    task(context, i);
+                }
+            });
+        });
     }
 };
+
+// Below this many pixels a mip is built by nvtt on the calling thread, as it isn't worth spreading
+static const int MIN_PARALLEL_MIP_PIXELS = 256 * 256;
+static const int MIP_ROWS_PER_TILE = 16;
+
+// Same as surface.buildNextMipmap(nvtt::MipmapFilter_Box), but with the common case of a 2x2 box over even
+// dimensions computed in tiles of rows across the texture processing arena
+static void buildNextMipmap(nvtt::Surface& surface) {
+    const int width = surface.width();
+    const int height = surface.height();
+    const nvtt::AlphaMode alphaMode = surface.alphaMode();
+
+    if (alphaMode != nvtt::AlphaMode_None || surface.depth() != 1 || (width & 1) || (height & 1) ||
+        width * height < MIN_PARALLEL_MIP_PIXELS) {
+        surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+        return;
+    }
+
+    const int NUM_CHANNELS = 4;
+    const int mipWidth = width / 2;
+    const int mipHeight = height / 2;
+    const nvtt::Surface& source = surface;
+    std::vector<float> mipChannels[NUM_CHANNELS];
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        mipChannels[c].resize(mipWidth * mipHeight);
+    }
+
+    getTextureProcessingArena().execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(0, mipHeight, MIP_ROWS_PER_TILE), [&](const tbb::blocked_range<int>& rows) {
+            for (int c = 0; c < NUM_CHANNELS; c++) {
+                const float* channel = source.channel(c);
+                float* mipChannel = mipChannels[c].data();
+                for (int y = rows.begin(); y < rows.end(); y++) {
+                    const float* row0 = channel + (2 * y) * width;
+                    const float* row1 = row0 + width;
+                    float* mipRow = mipChannel + y * mipWidth;
+                    for (int x = 0; x < mipWidth; x++) {
+                        mipRow[x] = 0.25f * (row0[2 * x] + row0[2 * x + 1] + row1[2 * x] + row1[2 * x + 1]);
+                    }
+                }
+            }
+        });
+    });
+
+    const nvtt::WrapMode wrapMode = surface.wrapMode();
+    surface.setImage(nvtt::InputFormat_RGBA_32F, mipWidth, mipHeight, 1,
+                     mipChannels[0].data(), mipChannels[1].data(), mipChannels[2].data(), mipChannels[3].data());
+    surface.setAlphaMode(alphaMode);
+    surface.setWrapMode(wrapMode);
+}
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -622,14 +701,13 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     context.setTaskDispatcher(&dispatcher);
 
     context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
     if (buildMips) {
         while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+            buildNextMipmap(surface);
             context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         }
     }
@@ -759,13 +837,14 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
+        ParallelTaskDispatcher dispatcher(abortProcessing);
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         if (buildMips) {
             while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+                buildNextMipmap(surface);
                 context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
             }
         }
@@ -1590,7 +1669,9 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
                 irradianceTexture->assignStoredMipFace(0, face, faces[face].getByteCount(), faces[face].getBits());
             }
 
-            irradianceTexture->generateIrradiance(target);
+            runInTextureProcessingArena([&] {
+                irradianceTexture->generateIrradiance(target);
+            });
 
             auto irradiance = irradianceTexture->getIrradiance();
             theTexture->overrideIrradiance(irradiance);
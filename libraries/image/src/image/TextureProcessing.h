@@ -12,6 +12,8 @@
 #ifndef hifi_image_TextureProcessing_h
 #define hifi_image_TextureProcessing_h
 
+#include <functional>
+
 #include <QVariant>
 
 #include <gpu/Texture.h>
@@ -125,6 +127,13 @@ std::pair<gpu::TexturePointer, glm::ivec2> processImage(std::shared_ptr<QIODevic
                                                         int maxNumPixels, TextureUsage::Type textureType,
                                                         bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
 
+// Texture compression and mip generation on all threads share one pool of at most this many threads.
+// Only takes effect if called before the first texture is processed.
+void setTextureProcessingConcurrency(int maxConcurrency);
+int getTextureProcessingConcurrency();
+// Runs function, which may spread its work with tbb, within that pool
+void runInTextureProcessingArena(const std::function<void()>& function);
+
 void convertToTextureWithMips(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1);
 void convertToTexture(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1, int mipLevel = 0);
 
@@ -0,0 +1,217 @@
+//
+//  AssetCache.cpp
+//  libraries/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include "NetworkLogging.h"
+
+static const QString PARTIAL_DIRECTORY = "partial";
+static const QString PARTIAL_RANGES_EXTENSION = ".ranges";
+// Downloads that haven't been carried on within a week are given up
+static const qint64 MAX_PARTIAL_AGE_SECS = 7 * 24 * 60 * 60;
+
+static int getRangeCount(uint64_t size, uint64_t rangeSize) {
+    return (int)((size + rangeSize - 1) / rangeSize);
+}
+
+AssetCache::AssetCache(const QString& directory, qint64 maximumSize) :
+    _directory(directory),
+    _partialDirectory(_directory.filePath(PARTIAL_DIRECTORY)),
+    _maximumSize(maximumSize)
+{
+    _directory.mkpath(".");
+    _partialDirectory.mkpath(".");
+
+    for (const auto& fileInfo : _directory.entryInfoList(QDir::Files)) {
+        auto hash = fileInfo.fileName();
+        if (AssetUtils::isValidHash(hash)) {
+            _entries.insert(hash, { fileInfo.size(), fileInfo.lastModified() });
+            _size += fileInfo.size();
+        } else {
+            // Left over from a save that didn't complete
+            QFile::remove(fileInfo.absoluteFilePath());
+        }
+    }
+
+    auto now = QDateTime::currentDateTime();
+    for (const auto& fileInfo : _partialDirectory.entryInfoList(QDir::Files)) {
+        if (fileInfo.lastModified().secsTo(now) > MAX_PARTIAL_AGE_SECS) {
+            QFile::remove(fileInfo.absoluteFilePath());
+        }
+    }
+
+    qCDebug(asset_client) << "Asset cache at" << _directory.path() << "holds" << _entries.size() << "assets of"
+                          << _size << "bytes";
+
+    evict();
+}
+
+QByteArray AssetCache::load(const AssetUtils::AssetHash& hash) {
+    auto entry = _entries.find(hash);
+    if (entry == _entries.end()) {
+        return QByteArray();
+    }
+
+    QFile file { _directory.filePath(hash) };
+    QByteArray data;
+    if (file.open(QIODevice::ReadWrite)) {
+        data = file.readAll();
+    }
+
+    if (data.size() != entry->size) {
+        qCWarning(asset_client) << "Removing unreadable asset" << hash << "from the asset cache";
+        file.close();
+        file.remove();
+        _size -= entry->size;
+        _entries.erase(entry);
+        return QByteArray();
+    }
+
+    // Kept on the file too, so that the least recently used assets are still the first evicted after a restart
+    entry->lastUsed = QDateTime::currentDateTime();
+    file.setFileTime(entry->lastUsed, QFileDevice::FileModificationTime);
+
+    return data;
+}
+
+bool AssetCache::save(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    if (_entries.contains(hash)) {
+        return true;
+    }
+
+    QSaveFile file { _directory.filePath(hash) };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(asset_client) << "Failed to write asset" << hash << "to the asset cache";
+        return false;
+    }
+
+    _entries.insert(hash, { data.size(), QDateTime::currentDateTime() });
+    _size += data.size();
+
+    evict();
+    return true;
+}
+
+void AssetCache::clear() {
+    for (auto itr = _entries.cbegin(); itr != _entries.cend(); ++itr) {
+        QFile::remove(_directory.filePath(itr.key()));
+    }
+    _entries.clear();
+    _size = 0;
+
+    _partialDirectory.removeRecursively();
+    _partialDirectory.mkpath(".");
+}
+
+bool AssetCache::loadPartial(const AssetUtils::AssetHash& hash, uint64_t size, uint64_t rangeSize, QByteArray& data,
+                             QBitArray& receivedRanges) {
+    QFile rangesFile { getPartialRangesPath(hash) };
+    if (!rangesFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    quint64 partialSize { 0 };
+    quint64 partialRangeSize { 0 };
+    QBitArray partialRanges;
+    QDataStream stream { &rangesFile };
+    stream >> partialSize >> partialRangeSize >> partialRanges;
+    bool isValid = stream.status() == QDataStream::Ok && partialSize == size && partialRangeSize == rangeSize &&
+        partialRanges.size() == getRangeCount(size, rangeSize);
+    rangesFile.close();
+
+    QFile file { _partialDirectory.filePath(hash) };
+    if (isValid && file.open(QIODevice::ReadOnly)) {
+        data = file.readAll();
+        file.close();
+        isValid = (uint64_t)data.size() == size;
+    } else {
+        isValid = false;
+    }
+
+    if (!isValid) {
+        removePartial(hash);
+        data.clear();
+        return false;
+    }
+
+    receivedRanges = partialRanges;
+    return true;
+}
+
+bool AssetCache::savePartialRange(const AssetUtils::AssetHash& hash, uint64_t size, uint64_t rangeSize, int range,
+                                  const QByteArray& data, const QBitArray& receivedRanges) {
+    QFile file { _partialDirectory.filePath(hash) };
+    if (!file.open(QIODevice::ReadWrite) || ((uint64_t)file.size() != size && !file.resize(size)) ||
+        !file.seek(range * rangeSize) || file.write(data) != data.size() || !file.flush()) {
+        qCWarning(asset_client) << "Failed to write a range of asset" << hash << "to the asset cache";
+        return false;
+    }
+    file.close();
+
+    // Written after the data, so that the ranges never claim more than the partial file holds
+    QSaveFile rangesFile { getPartialRangesPath(hash) };
+    if (!rangesFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream { &rangesFile };
+    stream << (quint64)size << (quint64)rangeSize << receivedRanges;
+    return stream.status() == QDataStream::Ok && rangesFile.commit();
+}
+
+void AssetCache::removePartial(const AssetUtils::AssetHash& hash) {
+    QFile::remove(getPartialRangesPath(hash));
+    QFile::remove(_partialDirectory.filePath(hash));
+}
+
+bool AssetCache::claimPartial(const AssetUtils::AssetHash& hash) {
+    if (_claimedPartials.contains(hash)) {
+        return false;
+    }
+    _claimedPartials.insert(hash);
+    return true;
+}
+
+void AssetCache::releasePartial(const AssetUtils::AssetHash& hash) {
+    _claimedPartials.remove(hash);
+}
+
+QString AssetCache::getPartialRangesPath(const AssetUtils::AssetHash& hash) const {
+    return _partialDirectory.filePath(hash + PARTIAL_RANGES_EXTENSION);
+}
+
+void AssetCache::evict() {
+    if (_size <= _maximumSize) {
+        return;
+    }
+
+    std::vector<std::pair<QDateTime, AssetUtils::AssetHash>> byLastUse;
+    byLastUse.reserve(_entries.size());
+    for (auto itr = _entries.cbegin(); itr != _entries.cend(); ++itr) {
+        byLastUse.emplace_back(itr->lastUsed, itr.key());
+    }
+    std::sort(byLastUse.begin(), byLastUse.end());
+
+    // Down to a little below the maximum, so that the next few saves don't each have to evict again
+    const qint64 targetSize = _maximumSize - _maximumSize / 10;
+    for (const auto& asset : byLastUse) {
+        if (_size <= targetSize) {
+            break;
+        }
+        QFile::remove(_directory.filePath(asset.second));
+        _size -= _entries.take(asset.second).size;
+    }
+}
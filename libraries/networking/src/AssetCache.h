@@ -0,0 +1,73 @@
+//
+//  AssetCache.h
+//  libraries/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetCache_h
+#define hifi_AssetCache_h
+
+#include <QtCore/QBitArray>
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include "AssetUtils.h"
+
+// An on-disk cache of ATP assets, stored under their hash so that the same asset is only kept once whichever domain
+// it came from.  Assets that are downloaded a range at a time are kept in a partial file with the ranges received so
+// far until they complete, so that an interrupted download carries on from where it stopped.
+//
+// Not thread safe, it is only used from the AssetClient thread.
+class AssetCache {
+public:
+    AssetCache(const QString& directory, qint64 maximumSize);
+
+    bool contains(const AssetUtils::AssetHash& hash) const { return _entries.contains(hash); }
+    // Returns a null array if the asset isn't cached
+    QByteArray load(const AssetUtils::AssetHash& hash);
+    // The data must be the asset with that hash, which the callers have already checked
+    bool save(const AssetUtils::AssetHash& hash, const QByteArray& data);
+    void clear();
+
+    qint64 getSize() const { return _size; }
+    qint64 getMaximumSize() const { return _maximumSize; }
+    QString getDirectory() const { return _directory.path(); }
+
+    // Returns the asset, with what hasn't been received yet zeroed, and which of its ranges have been received, if a
+    // download of it with the same size and range size was under way
+    bool loadPartial(const AssetUtils::AssetHash& hash, uint64_t size, uint64_t rangeSize, QByteArray& data,
+                     QBitArray& receivedRanges);
+    // Stores one more range of a download, receivedRanges including it
+    bool savePartialRange(const AssetUtils::AssetHash& hash, uint64_t size, uint64_t rangeSize, int range,
+                          const QByteArray& data, const QBitArray& receivedRanges);
+    void removePartial(const AssetUtils::AssetHash& hash);
+    // Only one download of an asset at a time may use its partial file.  Returns false if another one holds it, in
+    // which case the download goes ahead without one.
+    bool claimPartial(const AssetUtils::AssetHash& hash);
+    void releasePartial(const AssetUtils::AssetHash& hash);
+
+private:
+    struct Entry {
+        qint64 size;
+        QDateTime lastUsed;
+    };
+
+    QString getPartialRangesPath(const AssetUtils::AssetHash& hash) const;
+    void evict();
+
+    QDir _directory;
+    QDir _partialDirectory;
+    qint64 _maximumSize;
+    qint64 _size { 0 };
+    QHash<AssetUtils::AssetHash, Entry> _entries;
+    QSet<AssetUtils::AssetHash> _claimedPartials;
+};
+
+#endif // hifi_AssetCache_h
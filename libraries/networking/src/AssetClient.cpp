@@ -11,9 +11,11 @@
 
 #include "AssetClient.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
@@ -34,6 +36,8 @@
 
 MessageID AssetClient::_currentID = 0;
 
+static const QString ASSET_CACHE_DIRECTORY = "atp";
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -51,6 +55,8 @@ AssetClient::AssetClient() {
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetReply), true);
     packetReceiver.registerListener(PacketType::AssetUploadReply,
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadReply));
+    packetReceiver.registerListener(PacketType::AssetUploadChunkReply,
+        PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadChunkReply));
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
@@ -81,8 +87,17 @@ void AssetClient::initCaching() {
         auto cache = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache());
         qInfo() << "ResourceManager disk cache already setup at" << cache->cacheDirectory()
                 << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
+        if (_cacheDir.isEmpty()) {
+            _cacheDir = cache->cacheDirectory();
+        }
     }
 
+    // ATP assets are cached apart, under their hash
+    if (!_assetCache) {
+        _assetCache.reset(new AssetCache(QDir(_cacheDir).filePath(ASSET_CACHE_DIRECTORY), MAXIMUM_CACHE_SIZE));
+        qInfo() << "Asset cache setup at" << _assetCache->getDirectory()
+                << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
+    }
 }
 
 namespace {
@@ -318,6 +333,11 @@ void AssetClient::clearCache() {
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
+
+    if (_assetCache) {
+        qInfo() << "AssetClient::clearCache(): Clearing asset cache.";
+        _assetCache->clear();
+    }
 }
 
 void AssetClient::handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -527,8 +547,8 @@ void AssetClient::handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> messag
         auto requestIt = messageCallbackMap.find(messageID);
         if (requestIt != messageCallbackMap.end()) {
             auto callback = requestIt->second;
-            callback(true, error, info);
             messageCallbackMap.erase(requestIt);
+            callback(true, error, info);
         }
 
         // Although the messageCallbackMap may now be empty, we won't delete the node until we have disconnected from
@@ -595,8 +615,8 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
             callbacks.completeCallback(true, error, message->readAll());
         }
 
-
-        messageCallbackMap.erase(requestIt);
+        // By ID, as the callback may have made new requests
+        messageCallbackMap.erase(messageID);
     }
 }
 
@@ -895,6 +915,11 @@ bool AssetClient::cancelUploadAssetRequest(MessageID id) {
             return true;
         }
     }
+    for (auto& kv : _pendingChunkedUploads) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -904,7 +929,22 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     auto nodeList = DependencyManager::get<LimitedNodeList>();
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
-    if (assetServer) {
+    if (assetServer && (uint64_t)data.length() > AssetUtils::UPLOAD_CHUNK_SIZE) {
+        static const QUuid UPLOAD_NAMESPACE { "{5b8cbb4a-3bb3-4e6b-9a0e-7e3fc40bcb2e}" };
+
+        auto messageID = ++_currentID;
+        auto& upload = _pendingChunkedUploads[assetServer][messageID];
+        upload.hash = AssetUtils::hashData(data);
+        upload.uploadID = QUuid::createUuidV5(UPLOAD_NAMESPACE, upload.hash);
+        upload.data = data;
+        upload.callback = callback;
+
+        // Chunks are sent one at a time, each after the asset server has stored the one before
+        if (sendUploadChunk(assetServer, messageID, 0)) {
+            return messageID;
+        }
+        _pendingChunkedUploads[assetServer].erase(messageID);
+    } else if (assetServer) {
         auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
 
         auto messageID = ++_currentID;
@@ -925,6 +965,84 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     return INVALID_MESSAGE_ID;
 }
 
+bool AssetClient::sendUploadChunk(const SharedNodePointer& assetServer, MessageID messageID, uint64_t offset) {
+    const auto& upload = _pendingChunkedUploads[assetServer][messageID];
+
+    auto packetList = NLPacketList::create(PacketType::AssetUploadChunk, QByteArray(), true, true);
+    packetList->writePrimitive(messageID);
+    packetList->write(upload.uploadID.toRfc4122());
+    packetList->write(upload.hash);
+
+    uint64_t size = upload.data.length();
+    uint64_t chunkSize = std::min(size - offset, AssetUtils::UPLOAD_CHUNK_SIZE);
+    packetList->writePrimitive(size);
+    packetList->writePrimitive(offset);
+    packetList->write(upload.data.constData() + offset, chunkSize);
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    return nodeList->sendPacketList(std::move(packetList), *assetServer) != -1;
+}
+
+void AssetClient::handleAssetUploadChunkReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    uint64_t bytesReceived { 0 };
+    message->readPrimitive(&bytesReceived);
+
+    auto messageMapIt = _pendingChunkedUploads.find(senderNode);
+    if (messageMapIt == _pendingChunkedUploads.end()) {
+        return;
+    }
+    auto& messageCallbackMap = messageMapIt->second;
+    auto requestIt = messageCallbackMap.find(messageID);
+    if (requestIt == messageCallbackMap.end()) {
+        return;
+    }
+
+    uint64_t size = requestIt->second.data.length();
+    auto expectedHash = requestIt->second.hash;
+    auto callback = requestIt->second.callback;
+
+    // The asset server answers a chunk it didn't expect with how much it has, which is where to carry on from
+    bool sendNextChunk = (error == AssetUtils::AssetServerError::NoError ||
+                          error == AssetUtils::AssetServerError::InvalidByteRange) && bytesReceived < size;
+    if (sendNextChunk) {
+        if (!sendUploadChunk(senderNode, messageID, bytesReceived)) {
+            messageCallbackMap.erase(requestIt);
+            callback(false, AssetUtils::AssetServerError::NoError, QString());
+        }
+        return;
+    }
+
+    QString hashString;
+    if (error == AssetUtils::AssetServerError::NoError && bytesReceived == size) {
+        auto hash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+        if (hash == expectedHash) {
+            hashString = hash.toHex();
+            qCDebug(asset_client) << "Successfully uploaded asset to asset-server - SHA256 hash is " << hashString;
+        } else {
+            // Something else was spooled under this upload's ID, so the asset server committed different data
+            qCWarning(asset_client) << "Uploaded asset was stored with hash" << hash.toHex() << "instead of"
+                                    << expectedHash.toHex();
+            error = AssetUtils::AssetServerError::HashVerificationFailed;
+        }
+    } else {
+        qCWarning(asset_client) << "Error uploading file to asset server";
+        if (error == AssetUtils::AssetServerError::NoError) {
+            error = AssetUtils::AssetServerError::InvalidByteRange;
+        }
+    }
+
+    messageCallbackMap.erase(requestIt);
+    callback(true, error, hashString);
+}
+
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -983,6 +1101,16 @@ void AssetClient::handleNodeKilled(SharedNodePointer node) {
             messageMapIt->second.clear();
         }
     }
+
+    {
+        auto messageMapIt = _pendingChunkedUploads.find(node);
+        if (messageMapIt != _pendingChunkedUploads.end()) {
+            for (const auto& value : messageMapIt->second) {
+                value.second.callback(false, AssetUtils::AssetServerError::NoError, "");
+            }
+            messageMapIt->second.clear();
+        }
+    }
 }
 
 void AssetClient::handleNodeClientConnectionReset(SharedNodePointer node) {
@@ -1003,7 +1131,10 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
     {
         auto messageMapIt = _pendingRequests.find(node);
         if (messageMapIt != _pendingRequests.end()) {
-            for (const auto& value : messageMapIt->second) {
+            // Taken out first, as the callbacks may cancel other requests or make new ones
+            auto requests = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : requests) {
                 auto& message = value.second.message;
                 if (message) {
                     // Disconnect from all signals emitting from the pending message
@@ -1012,18 +1143,18 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
 
                 value.second.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray());
             }
-            messageMapIt->second.clear();
         }
     }
 
     {
         auto messageMapIt = _pendingInfoRequests.find(node);
         if (messageMapIt != _pendingInfoRequests.end()) {
+            auto requests = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
             AssetInfo info { "", 0 };
-            for (const auto& value : messageMapIt->second) {
+            for (const auto& value : requests) {
                 value.second(false, AssetUtils::AssetServerError::NoError, info);
             }
-            messageMapIt->second.clear();
         }
     }
 
@@ -17,10 +17,12 @@
 #include <QString>
 
 #include <map>
+#include <memory>
 
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetCache.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
@@ -78,6 +80,7 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadChunkReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
@@ -94,6 +97,7 @@ private:
     MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
+    bool sendUploadChunk(const SharedNodePointer& assetServer, MessageID messageID, uint64_t offset);
 
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
@@ -105,19 +109,34 @@ private:
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    // Null until caching is set up
+    AssetCache* getAssetCache() const { return _assetCache.get(); }
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
         ProgressCallback progressCallback;
     };
 
+    // Chunked uploads are named by the hash of their data, so that uploading the same data again after an interruption
+    // carries on from what the asset server already has.  Anyone knowing the hash can name the same upload, so every
+    // chunk also carries the hash, which the asset server checks the spooled data against before committing it.
+    struct ChunkedUploadData {
+        QUuid uploadID;
+        QByteArray hash;
+        QByteArray data;
+        UploadResultCallback callback;
+    };
+
     static MessageID _currentID;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, MappingOperationCallback>> _pendingMappingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, ChunkedUploadData>> _pendingChunkedUploads;
 
     QString _cacheDir;
+    std::unique_ptr<AssetCache> _assetCache;
 
     friend class AssetRequest;
     friend class AssetUpload;
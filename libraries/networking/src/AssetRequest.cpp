@@ -12,6 +12,7 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QtCore/QThread>
 
@@ -38,6 +39,16 @@ AssetRequest::~AssetRequest() {
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+    }
+    // The ranges received so far are kept in the asset cache, for the next request of the asset to carry on from
+    for (const auto& pendingRange : _pendingRanges) {
+        if (pendingRange.second.messageID) {
+            assetClient->cancelGetAssetRequest(pendingRange.second.messageID);
+        }
+    }
+    releasePartial();
 }
 
 void AssetRequest::start() {
@@ -59,22 +70,93 @@ void AssetRequest::start() {
         emit finished(this);
         return;
     }
-    
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto assetCache = assetClient->getAssetCache();
+
     // Try to load from cache
-    _data = AssetUtils::loadFromCache(getUrl());
-    if (!_data.isNull()) {
-        _error = NoError;
+    if (assetCache && assetCache->contains(_hash)) {
+        _data = assetCache->load(_hash);
 
+        if (!_data.isNull() && _byteRange.isSet()) {
+            // the same as the asset server would send
+            ByteRange byteRange = _byteRange;
+            if (byteRange.isValid()) {
+                byteRange.fixupRange(_data.size());
+            }
+            if (byteRange.isValid() && _data.size() >= byteRange.fromInclusive && _data.size() >= byteRange.toExclusive) {
+                auto from = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : _data.size() + byteRange.fromInclusive;
+                _data = _data.mid(from, byteRange.size());
+            } else {
+                _data = QByteArray();
+            }
+        }
+    }
+    if (_data.isNull() && !_byteRange.isSet()) {
+        // Assets cached before they had a cache of their own are still in the general disk cache
+        _data = AssetUtils::loadFromCache(getUrl());
+    }
+    if (!_data.isNull()) {
         _loadedFromCache = true;
+        finish(NoError);
+        return;
+    }
 
-        _state = Finished;
-        emit finished(this);
+    _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestData();
         return;
     }
 
-    _state = WaitingForData;
+    // Assets no bigger than a range come in one go in answer to a request for their last range, which the asset server
+    // answers with the whole asset when it is smaller.  The size, which decides whether a larger asset is downloaded as
+    // several ranges at once, is asked for at the same time rather than first.
+    requestTail();
+    if (_state != WaitingForData) {
+        return;
+    }
 
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    auto hash = _hash;
+
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that) {
+            qCWarning(asset_client) << "Got info reply for dead asset request " << hash;
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived) {
+            finish(NetworkError);
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            finish(toError(serverError));
+        } else if (info.size > (int64_t)AssetUtils::DOWNLOAD_RANGE_SIZE) {
+            startRangedDownload(info.size);
+        } else if (!_tailData.isNull()) {
+            // The whole asset is already here, and it didn't match its hash
+            finish(HashVerificationFailed);
+        }
+        // Otherwise the whole asset is still on its way
+    });
+}
+
+AssetRequest::Error AssetRequest::toError(AssetUtils::AssetServerError serverError) {
+    switch (serverError) {
+        case AssetUtils::AssetServerError::NoError:
+            return NoError;
+        case AssetUtils::AssetServerError::AssetNotFound:
+            return NotFound;
+        case AssetUtils::AssetServerError::InvalidByteRange:
+            return InvalidByteRange;
+        default:
+            return UnknownError;
+    }
+}
+
+void AssetRequest::requestData() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -90,49 +172,317 @@ void AssetRequest::start() {
         _assetRequestID = INVALID_MESSAGE_ID;
 
         if (!responseReceived) {
-            _error = NetworkError;
+            finish(NetworkError);
+            return;
         } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
-        } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
-            }
+            finish(toError(serverError));
+            return;
+        } else if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
+            // the hash of the received data does not match what we expect, so we return an error
+            finish(HashVerificationFailed);
+            return;
+        }
+
+        _data = data;
+        _totalReceived += data.size();
+        emit progress(_totalReceived, data.size());
+
+        auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+        if (!_byteRange.isSet() && assetCache) {
+            assetCache->save(_hash, data);
+        }
+
+        finish(NoError);
+    }, [this, that](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            // If the request is dead, return
+            return;
+        }
+        emit progress(totalReceived, total);
+    });
+}
 
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
+void AssetRequest::requestTail() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    auto hash = _hash;
 
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
-                }
+    // A negative start counts back from the end of the asset, and covers all of it when it is smaller
+    const AssetUtils::DataOffset tailStart = -(AssetUtils::DataOffset)AssetUtils::DOWNLOAD_RANGE_SIZE;
+
+    _assetRequestID = assetClient->getAsset(_hash, tailStart, 0,
+        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+
+        if (!that) {
+            qCWarning(asset_client) << "Got tail reply for dead asset request " << hash;
+            return;
+        }
+        _assetRequestID = INVALID_MESSAGE_ID;
+
+        if (_size > 0) {
+            // The size came first and the rest of the asset is already coming in as ranges, which the tail completes,
+            // or if it failed, the last range is requested with the others
+            if (responseReceived && serverError == AssetUtils::AssetServerError::NoError) {
+                addTail(data);
             }
+            requestRanges();
+            return;
         }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+
+        if (!responseReceived) {
+            finish(NetworkError);
+            return;
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            finish(toError(serverError));
+            return;
         }
-        
-        _state = Finished;
-        emit finished(this);
+
+        bool isWholeAsset = (uint64_t)data.size() < AssetUtils::DOWNLOAD_RANGE_SIZE;
+        bool hashMatches = AssetUtils::hashData(data).toHex() == _hash;
+        if (!isWholeAsset && !hashMatches) {
+            // A larger asset, downloaded as ranges once its size is known
+            _tailData = data;
+            return;
+        } else if (!hashMatches) {
+            finish(HashVerificationFailed);
+            return;
+        }
+
+        _data = data;
+        _totalReceived += data.size();
+        emit progress(_totalReceived, data.size());
+
+        auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+        if (assetCache) {
+            assetCache->save(_hash, data);
+        }
+
+        finish(NoError);
     }, [this, that](qint64 totalReceived, qint64 total) {
+        if (!that || _size > 0) {
+            // If the request is dead or downloading ranges, return
+            return;
+        }
+        emit progress(totalReceived, total);
+    });
+}
+
+void AssetRequest::addTail(const QByteArray& tail) {
+    const int lastRange = _receivedRanges.size() - 1;
+    const uint64_t lastRangeStart = lastRange * AssetUtils::DOWNLOAD_RANGE_SIZE;
+    if ((uint64_t)tail.size() != AssetUtils::DOWNLOAD_RANGE_SIZE || _receivedRanges.testBit(lastRange)) {
+        return;
+    }
+
+    // The tail ends at the end of the asset, so it holds all of the last range and some of the one before
+    memcpy(_data.data() + _size - tail.size(), tail.constData(), tail.size());
+    _receivedRanges.setBit(lastRange);
+    _totalReceived += _size - lastRangeStart;
+
+    auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+    if (assetCache && _hasPartial) {
+        assetCache->savePartialRange(_hash, _size, AssetUtils::DOWNLOAD_RANGE_SIZE, lastRange,
+                                     tail.right((int)(_size - lastRangeStart)), _receivedRanges);
+    }
+    emit progress(_totalReceived, _size);
+}
+
+void AssetRequest::startRangedDownload(uint64_t size) {
+    // Starts with a couple of ranges at once, adding one more for each range received and halving for each one that
+    // fails, so that a fast connection is kept full without swamping a slow one
+    static const int INITIAL_PENDING_RANGES = 2;
+
+    _size = size;
+    _maxPendingRanges = INITIAL_PENDING_RANGES;
+
+    auto rangeCount = (int)((size + AssetUtils::DOWNLOAD_RANGE_SIZE - 1) / AssetUtils::DOWNLOAD_RANGE_SIZE);
+    auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+    // Concurrent requests of the same asset would overwrite each other's record of the ranges received, so only the
+    // first one keeps a partial file
+    _hasPartial = assetCache && assetCache->claimPartial(_hash);
+    if (_hasPartial && assetCache->loadPartial(_hash, size, AssetUtils::DOWNLOAD_RANGE_SIZE, _data, _receivedRanges)) {
+        _isResumed = true;
+        for (int range = 0; range < rangeCount; ++range) {
+            if (_receivedRanges.testBit(range)) {
+                _totalReceived += std::min(AssetUtils::DOWNLOAD_RANGE_SIZE, size - range * AssetUtils::DOWNLOAD_RANGE_SIZE);
+            }
+        }
+        qCDebug(asset_client) << "Resuming download of" << _hash << "from" << _totalReceived << "of" << size << "bytes";
+    } else {
+        _data = QByteArray((int)size, '\0');
+        _receivedRanges = QBitArray(rangeCount);
+    }
+
+    if (!_tailData.isNull()) {
+        addTail(_tailData);
+        _tailData = QByteArray();
+    } else if (_assetRequestID != INVALID_MESSAGE_ID && _receivedRanges.testBit(rangeCount - 1)) {
+        // Resumed with the last range already in
+        DependencyManager::get<AssetClient>()->cancelGetAssetRequest(_assetRequestID);
+        _assetRequestID = INVALID_MESSAGE_ID;
+    }
+
+    requestRanges();
+}
+
+void AssetRequest::requestRanges() {
+    // The last range comes with the tail while that is still on its way
+    bool isTailPending = _assetRequestID != INVALID_MESSAGE_ID;
+    int tailRange = isTailPending ? _receivedRanges.size() - 1 : -1;
+
+    for (int range = 0; range < _receivedRanges.size(); ++range) {
+        if (_state != WaitingForData || (int)_pendingRanges.size() >= _maxPendingRanges) {
+            return;
+        }
+        if (range != tailRange && !_receivedRanges.testBit(range) && _pendingRanges.find(range) == _pendingRanges.end()) {
+            requestRange(range);
+        }
+    }
+
+    if (_state == WaitingForData && _pendingRanges.empty() && !isTailPending) {
+        completeRangedDownload();
+    }
+}
+
+void AssetRequest::requestRange(int range) {
+    static const int MAX_PENDING_RANGES = 8;
+    static const int MAX_FAILED_RANGES = 5;
+
+    const uint64_t rangeStart = range * AssetUtils::DOWNLOAD_RANGE_SIZE;
+    const uint64_t rangeEnd = std::min(rangeStart + AssetUtils::DOWNLOAD_RANGE_SIZE, _size);
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    auto hash = _hash;
+
+    // In place before the request is made, as a request that can't be sent calls back straight away
+    _pendingRanges[range] = PendingRange();
+
+    auto messageID = assetClient->getAsset(_hash, rangeStart, rangeEnd,
+        [this, that, hash, range, rangeStart, rangeEnd](bool responseReceived, AssetUtils::AssetServerError serverError,
+                                                        const QByteArray& data) {
+
+        if (!that) {
+            qCWarning(asset_client) << "Got range reply for dead asset request " << hash;
+            return;
+        }
+        _pendingRanges.erase(range);
+
+        if (!responseReceived || (serverError == AssetUtils::AssetServerError::NoError &&
+                                  (uint64_t)data.size() != rangeEnd - rangeStart)) {
+            if (++_failedRanges > MAX_FAILED_RANGES) {
+                finish(NetworkError);
+                return;
+            }
+            _maxPendingRanges = std::max(1, _maxPendingRanges / 2);
+            qCDebug(asset_client) << "Retrying range" << range << "of" << _hash << "with" << _maxPendingRanges << "at once";
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            finish(toError(serverError));
+            return;
+        } else {
+            memcpy(_data.data() + rangeStart, data.constData(), data.size());
+            _receivedRanges.setBit(range);
+            _totalReceived += data.size();
+
+            auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+            if (assetCache && _hasPartial) {
+                assetCache->savePartialRange(_hash, _size, AssetUtils::DOWNLOAD_RANGE_SIZE, range, data, _receivedRanges);
+            }
+
+            _maxPendingRanges = std::min(MAX_PENDING_RANGES, _maxPendingRanges + 1);
+            emit progress(_totalReceived, _size);
+        }
+
+        requestRanges();
+    }, [this, that, range](qint64 totalReceived, qint64 total) {
         if (!that) {
             // If the request is dead, return
             return;
         }
-        emit progress(totalReceived, total);
+        auto pendingRange = _pendingRanges.find(range);
+        if (pendingRange == _pendingRanges.end()) {
+            return;
+        }
+        pendingRange->second.received = totalReceived;
+
+        qint64 received = _totalReceived;
+        for (const auto& pending : _pendingRanges) {
+            received += pending.second.received;
+        }
+        emit progress(received, _size);
     });
+
+    auto pendingRange = _pendingRanges.find(range);
+    if (messageID != INVALID_MESSAGE_ID && pendingRange != _pendingRanges.end()) {
+        pendingRange->second.messageID = messageID;
+    }
+}
+
+void AssetRequest::completeRangedDownload() {
+    auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+    if (assetCache && _hasPartial) {
+        assetCache->removePartial(_hash);
+    }
+
+    if (AssetUtils::hashData(_data).toHex() != _hash) {
+        if (_isResumed) {
+            // What was carried over from an earlier download may be stale or corrupted, so download the whole asset
+            // again, once, before giving up on it
+            qCWarning(asset_client) << "Resumed download of" << _hash << "failed verification, downloading it again";
+            _isResumed = false;
+            _data.fill('\0');
+            _receivedRanges.fill(false);
+            _totalReceived = 0;
+            requestRanges();
+            return;
+        }
+        finish(HashVerificationFailed);
+        return;
+    }
+
+    if (assetCache) {
+        assetCache->save(_hash, _data);
+    }
+    finish(NoError);
+}
+
+void AssetRequest::releasePartial() {
+    if (_hasPartial) {
+        auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+        if (assetCache) {
+            assetCache->releasePartial(_hash);
+        }
+        _hasPartial = false;
+    }
+}
+
+void AssetRequest::finish(Error error) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (_assetRequestID) {
+        assetClient->cancelGetAssetRequest(_assetRequestID);
+        _assetRequestID = INVALID_MESSAGE_ID;
+    }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+    }
+    _tailData = QByteArray();
+    for (const auto& pendingRange : _pendingRanges) {
+        if (pendingRange.second.messageID) {
+            assetClient->cancelGetAssetRequest(pendingRange.second.messageID);
+        }
+    }
+    _pendingRanges.clear();
+    releasePartial();
+
+    _error = error;
+    if (_error != NoError) {
+        _data = QByteArray();
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
 }
 
 
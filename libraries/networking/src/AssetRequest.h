@@ -12,6 +12,9 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <unordered_map>
+
+#include <QBitArray>
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -62,6 +65,23 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    struct PendingRange {
+        MessageID messageID { INVALID_MESSAGE_ID };
+        qint64 received { 0 };
+    };
+
+    static Error toError(AssetUtils::AssetServerError serverError);
+
+    void requestData();
+    void requestTail();
+    void addTail(const QByteArray& tail);
+    void startRangedDownload(uint64_t size);
+    void requestRanges();
+    void requestRange(int range);
+    void completeRangedDownload();
+    void releasePartial();
+    void finish(Error error);
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -70,8 +90,20 @@ private:
     QByteArray _data;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
+
+    // Large assets are downloaded as ranges of AssetUtils::DOWNLOAD_RANGE_SIZE, several at a time
+    uint64_t _size { 0 };
+    QBitArray _receivedRanges;
+    std::unordered_map<int, PendingRange> _pendingRanges;
+    int _maxPendingRanges { 0 };
+    int _failedRanges { 0 };
+    bool _hasPartial { false }; // whether this request holds the asset cache's partial file of the asset
+    bool _isResumed { false }; // whether some of the ranges came from the partial file rather than this request
+    // The last range of an asset larger than a range, kept until the size says where it goes
+    QByteArray _tailData;
 };
 
 #endif
@@ -46,6 +46,8 @@ QString AssetUpload::getErrorString() const {
             return "There was a problem reaching your Asset Server. Please check your network connectivity.";
         case AssetUpload::ServerFileError:
             return "The Asset Server failed to store the asset. Please try again.";
+        case AssetUpload::HashVerificationFailed:
+            return "The Asset Server stored different content than was uploaded. Please try again.";
         default:
             return QString("Unknown error with code %1").arg(_error);
     }
@@ -98,14 +100,18 @@ void AssetUpload::start() {
                 case AssetUtils::AssetServerError::FileOperationFailed:
                     _error = ServerFileError;
                     break;
+                case AssetUtils::AssetServerError::HashVerificationFailed:
+                    _error = HashVerificationFailed;
+                    break;
                 default:
                     _error = FileOpenError;
                     break;
             }
         }
         
-        if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
-            AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data);
+        auto assetCache = DependencyManager::get<AssetClient>()->getAssetCache();
+        if (_error == NoError && assetCache && hash == AssetUtils::hashData(_data).toHex()) {
+            assetCache->save(hash, _data);
         }
         
         emit finished(this, hash);
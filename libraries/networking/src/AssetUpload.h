@@ -33,7 +33,8 @@ public:
         TooLarge,
         PermissionDenied,
         FileOpenError,
-        ServerFileError
+        ServerFileError,
+        HashVerificationFailed
     };
     
     static const QString PERMISSION_DENIED_ERROR;
@@ -30,6 +30,8 @@ using AssetPathList = QStringList;
 const size_t SHA256_HASH_LENGTH = 32;
 const size_t SHA256_HASH_HEX_LENGTH = 64;
 const uint64_t MAX_UPLOAD_SIZE = 1000 * 1000 * 1000; // 1GB
+const uint64_t UPLOAD_CHUNK_SIZE = 1024 * 1024; // larger uploads are sent as a series of chunks of this size
+const uint64_t DOWNLOAD_RANGE_SIZE = 1024 * 1024; // larger downloads are requested as several ranges of this size at once
 
 const QString ASSET_FILE_PATH_REGEX_STRING = "^(\\/[^\\/\\0]+)+$";
 const QString ASSET_PATH_REGEX_STRING = "^\\/([^\\/\\0]+(\\/)?)+$";
@@ -46,7 +48,8 @@ enum AssetServerError : uint8_t {
     MappingOperationFailed,
     FileOperationFailed,
     NoAssetServer,
-    LostConnection
+    LostConnection,
+    HashVerificationFailed
 };
 
 enum AssetMappingOperationType : uint8_t {
@@ -164,6 +164,8 @@ public:
     static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
 
+    // One message as it's sent in a MessagesData packet, which may hold several of them back to back
+    static QByteArray encodeMessage(const QString& channel, bool isText, const QByteArray& messageData, const QUuid& senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
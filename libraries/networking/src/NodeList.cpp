@@ -123,6 +123,9 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     connect(this, &LimitedNodeList::nodeAdded, this, &NodeList::startNodeHolePunch);
     connect(this, &LimitedNodeList::nodeSocketUpdated, this, &NodeList::startNodeHolePunch);
 
+    // a node we drop on our own (e.g. it went silent) won't be in any delta, so ask for a full list next time
+    connect(this, &LimitedNodeList::nodeKilled, this, &NodeList::handleNodeKilledForDomainList, Qt::DirectConnection);
+
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
@@ -314,6 +317,8 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
         _domainHandler.softReset(reason);
     }
 
+    resetDomainListVersion();
+
     // refresh the owner UUID to the NULL UUID
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
@@ -497,6 +502,10 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << publicSockAddr << localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainIsConnected) {
+            packetStream << _domainListVersion.load();
+        }
+
         if (!domainIsConnected) {
 
             // Metaverse account.
@@ -756,6 +765,20 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version this list brings us up to, the version it is a delta from (zero for a full list), the number of
+    // nodes in the whole list (which may span several packets) and the nodes removed since the base version
+    quint64 domainListVersion;
+    packetStream >> domainListVersion;
+
+    quint64 domainListBaseVersion;
+    packetStream >> domainListBaseVersion;
+
+    quint32 domainListNodeCount;
+    packetStream >> domainListNodeCount;
+
+    QList<QUuid> removedNodeIDs;
+    packetStream >> removedNodeIDs;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -852,9 +875,27 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    for (const auto& removedNodeID : removedNodeIDs) {
+        killDomainServerRemovedNode(removedNodeID);
+    }
+
+    // a list can span several unreliable packets, and repeated check ins can get the same list more than once,
+    // so collect the nodes per list and only take its version once we've seen all of them
+    if (domainListVersion != _pendingDomainListVersion || domainListBaseVersion != _pendingDomainListBaseVersion) {
+        _pendingDomainListVersion = domainListVersion;
+        _pendingDomainListBaseVersion = domainListBaseVersion;
+        _pendingDomainListNodes.clear();
+    }
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        _pendingDomainListNodes.insert(parseNodeFromPacketStream(packetStream));
+    }
+
+    // a delta only applies on top of the version it was made from
+    if (_pendingDomainListNodes.size() >= (int)domainListNodeCount
+        && (domainListBaseVersion == 0 || domainListBaseVersion == _domainListVersion)) {
+        _domainListVersion = domainListVersion;
     }
 }
 
@@ -870,11 +911,30 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    killDomainServerRemovedNode(nodeUUID);
+}
+
+void NodeList::killDomainServerRemovedNode(const QUuid& nodeUUID) {
+    // the domain-server already knows this node is gone, so this kill doesn't invalidate our domain list version
+    _domainServerRemovedNodeID = nodeUUID;
     killNodeWithUUID(nodeUUID);
+    _domainServerRemovedNodeID = QUuid();
     removeDelayedAdd(nodeUUID);
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+void NodeList::handleNodeKilledForDomainList(SharedNodePointer node) {
+    if (node->getUUID() != _domainServerRemovedNodeID) {
+        _domainListVersion = 0;
+    }
+}
+
+void NodeList::resetDomainListVersion() {
+    _domainListVersion = 0;
+    _pendingDomainListVersion = 0;
+    _pendingDomainListBaseVersion = 0;
+}
+
+QUuid NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
     packetStream >> info.type
@@ -893,6 +953,8 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 
     addNewNode(info);
+
+    return info.uuid;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
@@ -152,6 +152,8 @@ private slots:
 
     void maybeSendIgnoreSetToNode(SharedNodePointer node);
 
+    void handleNodeKilledForDomainList(SharedNodePointer node);
+
 private:
     NodeList() : LimitedNodeList(INVALID_PORT, INVALID_PORT) { assert(false); } // Not implemented, needed for DependencyManager templates compile
     NodeList(char ownerType, int socketListenPort = INVALID_PORT, int dtlsListenPort = INVALID_PORT);
@@ -165,7 +167,9 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
+    void killDomainServerRemovedNode(const QUuid& nodeUUID);
+    void resetDomainListVersion();
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -181,6 +185,14 @@ private:
 
     bool _sendDomainServerCheckInEnabled { true };
 
+    // the domain list version we have completely applied, sent with each check in so the domain-server can reply with
+    // only what changed since; zero asks for a full list
+    std::atomic<quint64> _domainListVersion { 0 };
+    quint64 _pendingDomainListVersion { 0 };
+    quint64 _pendingDomainListBaseVersion { 0 };
+    QSet<QUuid> _pendingDomainListNodes;
+    QUuid _domainServerRemovedNodeID;
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
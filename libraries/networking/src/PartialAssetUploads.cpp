@@ -0,0 +1,174 @@
+//
+//  PartialAssetUploads.cpp
+//  libraries/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PartialAssetUploads.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+
+#include <UUID.h>
+
+#include "NetworkLogging.h"
+
+// Idle uploads are forgotten in memory after an hour, and their spool files are removed after a week
+static const std::chrono::hours MAX_IDLE_UPLOAD_TIME { 1 };
+static const qint64 MAX_SPOOL_FILE_AGE_SECS = 7 * 24 * 60 * 60;
+
+PartialAssetUploads::PartialAssetUploads(const QDir& spoolDir, const QDir& filesDir) :
+    _spoolDir(spoolDir),
+    _filesDir(filesDir)
+{
+    removeAbandonedUploads();
+}
+
+void PartialAssetUploads::removeAbandonedUploads() {
+    std::lock_guard<std::mutex> lock { _uploadsMutex };
+
+    auto now = QDateTime::currentDateTime();
+    for (const auto& fileInfo : _spoolDir.entryInfoList(QDir::Files)) {
+        // An upload still held in memory may be in the middle of writing its next chunk
+        if (_uploads.contains(QUuid(fileInfo.fileName()))) {
+            continue;
+        }
+        if (fileInfo.lastModified().secsTo(now) > MAX_SPOOL_FILE_AGE_SECS) {
+            qCDebug(networking) << "Removing abandoned upload" << fileInfo.fileName();
+            QFile::remove(fileInfo.absoluteFilePath());
+        }
+    }
+}
+
+std::shared_ptr<PartialAssetUploads::PartialUpload> PartialAssetUploads::getUpload(const QUuid& uploadID) {
+    std::lock_guard<std::mutex> lock { _uploadsMutex };
+
+    auto existing = _uploads.find(uploadID);
+    if (existing != _uploads.end()) {
+        return existing.value();
+    }
+
+    // Make room by forgetting uploads nobody is sending any more, which are picked up again from their spool files if
+    // they ever resume
+    auto now = std::chrono::steady_clock::now();
+    auto it = _uploads.begin();
+    while (it != _uploads.end()) {
+        if (it.value().use_count() == 1 && now - it.value()->lastChunkTime > MAX_IDLE_UPLOAD_TIME) {
+            it = _uploads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto upload = std::make_shared<PartialUpload>();
+    _uploads.insert(uploadID, upload);
+    return upload;
+}
+
+void PartialAssetUploads::removeUpload(const QUuid& uploadID) {
+    std::lock_guard<std::mutex> lock { _uploadsMutex };
+    _uploads.remove(uploadID);
+}
+
+AssetUtils::AssetServerError PartialAssetUploads::receiveChunk(const QUuid& uploadID, const QByteArray& expectedHash,
+                                                          uint64_t size, uint64_t offset, const QByteArray& chunk,
+                                                          uint64_t& bytesReceived, QByteArray& hash) {
+    auto upload = getUpload(uploadID);
+    std::lock_guard<std::mutex> lock { upload->mutex };
+
+    QFile spoolFile { _spoolDir.filePath(uuidStringWithoutCurlyBraces(uploadID)) };
+
+    if (!upload->isLoaded) {
+        // Carry on from what was spooled before, hashing it a block at a time
+        upload->size = size;
+        upload->expectedHash = expectedHash;
+        if (spoolFile.open(QIODevice::ReadOnly)) {
+            if ((uint64_t)spoolFile.size() <= size && upload->hash.addData(&spoolFile)) {
+                upload->bytesReceived = spoolFile.size();
+            } else {
+                upload->hash.reset();
+            }
+            spoolFile.close();
+        }
+        upload->isLoaded = true;
+    }
+
+    if (upload->size != size || upload->expectedHash != expectedHash) {
+        // Not the same data after all, start over
+        upload->hash.reset();
+        upload->bytesReceived = 0;
+        upload->size = size;
+        upload->expectedHash = expectedHash;
+    }
+
+    upload->lastChunkTime = std::chrono::steady_clock::now();
+    bytesReceived = upload->bytesReceived;
+
+    if (offset != upload->bytesReceived || offset + chunk.size() > size) {
+        return AssetUtils::AssetServerError::InvalidByteRange;
+    }
+
+    auto openMode = QIODevice::WriteOnly | (offset == 0 ? QIODevice::Truncate : QIODevice::Append);
+    if (!spoolFile.open(openMode) || spoolFile.write(chunk) != chunk.size() || !spoolFile.flush()) {
+        qCWarning(networking) << "Failed to write upload chunk to" << spoolFile.fileName();
+        spoolFile.resize(upload->bytesReceived);
+        return AssetUtils::AssetServerError::FileOperationFailed;
+    }
+    spoolFile.close();
+
+    upload->hash.addData(chunk);
+    upload->bytesReceived += chunk.size();
+    bytesReceived = upload->bytesReceived;
+
+    if (upload->bytesReceived < size) {
+        return AssetUtils::AssetServerError::NoError;
+    }
+
+    auto error = commitUpload(*upload, spoolFile.fileName(), hash);
+    removeUpload(uploadID);
+    return error;
+}
+
+AssetUtils::AssetServerError PartialAssetUploads::commitUpload(PartialUpload& upload, const QString& spoolPath,
+                                                          QByteArray& hash) {
+    hash = upload.hash.result();
+    auto hexHash = hash.toHex();
+
+    if (hash != upload.expectedHash) {
+        // What was spooled isn't what the uploader sent, it may have been started by someone else or left corrupted
+        qCWarning(networking) << "Discarding upload" << spoolPath << "with hash" << hexHash << "instead of"
+                                << upload.expectedHash.toHex();
+        QFile::remove(spoolPath);
+        return AssetUtils::AssetServerError::HashVerificationFailed;
+    }
+
+    QFile file { _filesDir.filePath(QString(hexHash)) };
+    if (file.exists()) {
+        // check if the local file has the correct contents, otherwise we overwrite
+        QCryptographicHash existingHash { QCryptographicHash::Sha256 };
+        if (file.open(QIODevice::ReadOnly) && existingHash.addData(&file) && existingHash.result() == hash) {
+            qCDebug(networking) << "Not overwriting existing verified file: " << hexHash;
+            file.close();
+            QFile::remove(spoolPath);
+            return AssetUtils::AssetServerError::NoError;
+        }
+
+        qCDebug(networking) << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+        file.close();
+        file.remove();
+    }
+
+    // The spool is next to the asset files, so moving it into place is a rename that can't leave a partial asset
+    if (!QFile::rename(spoolPath, file.fileName())) {
+        qCWarning(networking) << "Failed to move upload" << spoolPath << "to" << file.fileName() << " - upload failed.";
+        QFile::remove(spoolPath);
+        return AssetUtils::AssetServerError::FileOperationFailed;
+    }
+
+    qCDebug(networking) << "Wrote file" << hexHash << "to disk. Upload complete";
+    return AssetUtils::AssetServerError::NoError;
+}
@@ -0,0 +1,65 @@
+//
+//  PartialAssetUploads.h
+//  libraries/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PartialAssetUploads_h
+#define hifi_PartialAssetUploads_h
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include "AssetUtils.h"
+
+// Uploads sent in chunks, spooled to a file per upload until the last chunk arrives and the file is moved into place
+// under its hash.  Spool files outlive the asset server, so an interrupted upload carries on from where it stopped.
+// Upload IDs can be worked out by anyone who knows the hash of the data, so a finished upload is only committed if it
+// has the hash the uploader expects, and its spool is thrown away otherwise.
+class PartialAssetUploads {
+public:
+    PartialAssetUploads(const QDir& spoolDir, const QDir& filesDir);
+
+    // Appends the chunk at offset if it is the next one of the upload, and once the upload is complete, sets hash.
+    // bytesReceived is how much of the upload has been stored, which is where the next chunk should start.
+    AssetUtils::AssetServerError receiveChunk(const QUuid& uploadID, const QByteArray& expectedHash, uint64_t size,
+                                              uint64_t offset, const QByteArray& chunk, uint64_t& bytesReceived,
+                                              QByteArray& hash);
+
+    // Removes spool files of uploads that haven't received a chunk for a week.  Run when created and then
+    // periodically by the owner, since an abandoned upload is never seen again to be cleaned up.
+    void removeAbandonedUploads();
+
+private:
+    struct PartialUpload {
+        std::mutex mutex;
+        QCryptographicHash hash { QCryptographicHash::Sha256 };
+        QByteArray expectedHash;
+        uint64_t size { 0 };
+        uint64_t bytesReceived { 0 };
+        bool isLoaded { false }; // whether what was spooled before this upload was seen has been hashed
+        std::chrono::steady_clock::time_point lastChunkTime;
+    };
+
+    std::shared_ptr<PartialUpload> getUpload(const QUuid& uploadID);
+    void removeUpload(const QUuid& uploadID);
+    AssetUtils::AssetServerError commitUpload(PartialUpload& upload, const QString& spoolPath, QByteArray& hash);
+
+    QDir _spoolDir;
+    QDir _filesDir;
+
+    std::mutex _uploadsMutex;
+    QHash<QUuid, std::shared_ptr<PartialUpload>> _uploads;
+};
+
+#endif // hifi_PartialAssetUploads_h
@@ -69,6 +69,10 @@ protected:
     /// Implements generic processing behavior for this thread.
     virtual bool process() override;
 
+    /// Processes the packets taken off the queue in one pass. The default hands them to processPacket() one at a time;
+    /// override to work on the whole batch at once.
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets);
+
     /// Determines the timeout of the wait when there are no packets to process. Default value is 100ms to allow for regular event processing.
     virtual uint32_t getMaxWait() const { return MAX_WAIT_TIME; }
 
@@ -137,6 +137,8 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        AssetUploadChunk,
+        AssetUploadChunkReply,
         NUM_PACKET_TYPE
     };
 
@@ -196,7 +198,8 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
             << PacketTypeEnum::Value::AssetGet
-            << PacketTypeEnum::Value::AssetUpload;
+            << PacketTypeEnum::Value::AssetUpload
+            << PacketTypeEnum::Value::AssetUploadChunk;
         return DOMAIN_SOURCED_PACKETS;
     }
 
@@ -204,7 +207,8 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_IGNORED_VERIFICATION_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperationReply
             << PacketTypeEnum::Value::AssetGetReply
-            << PacketTypeEnum::Value::AssetUploadReply;
+            << PacketTypeEnum::Value::AssetUploadReply
+            << PacketTypeEnum::Value::AssetUploadChunkReply;
         return DOMAIN_IGNORED_VERIFICATION_PACKETS;
     }
 };
@@ -287,6 +291,7 @@ enum class EntityVersion : PacketVersion {
     UserAgent,
     AllBillboardMode,
     TextAlignment,
+    DictionaryCompression,
 
     // Add new versions above here
     NUM_PACKET_TYPE,
@@ -311,7 +316,8 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ChunkedUploads
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -386,7 +392,13 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasDeltaUpdates
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreDeltaUpdates = 22,
+    HasLastDomainListVersion
 };
 
 enum class AudioVersion : PacketVersion {
@@ -401,7 +413,8 @@ enum class AudioVersion : PacketVersion {
 };
 
 enum class MessageDataVersion : PacketVersion {
-    TextOrBinaryData = 18
+    TextOrBinaryData = 18,
+    BatchedMessages
 };
 
 enum class IcePingVersion : PacketVersion {
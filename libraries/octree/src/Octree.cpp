@@ -708,10 +708,11 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         return false;
     }
 
-    QDataStream jsonStream(jsonData);
+    // parse the unzipped data in place rather than copying it out of a stream
+    compressedJsonData.clear();
     QUrl relativeURL = QUrl::fromLocalFile(qFileName).adjusted(QUrl::RemoveFilename);
 
-    return readJSONFromStream(-1, jsonStream, "", false, relativeURL);
+    return readJSON(jsonData, "", false, relativeURL);
 }
 
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
@@ -852,37 +853,55 @@ bool Octree::readJSONFromStream(
     // we get an eof.  Leave streamLength parameter for consistency.
 
     QByteArray jsonBuffer;
-    char* rawData = new char[READ_JSON_BUFFER_SIZE];
+    QByteArray readBuffer(READ_JSON_BUFFER_SIZE, 0);
     while (!inputStream.atEnd()) {
-        int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
+        int got = inputStream.readRawData(readBuffer.data(), READ_JSON_BUFFER_SIZE);
         if (got < 0) {
             qCritical() << "error while reading from json stream";
-            delete[] rawData;
             return false;
         }
         if (got == 0) {
             break;
         }
-        jsonBuffer += QByteArray(rawData, got);
+        jsonBuffer.append(readBuffer.constData(), got);
     }
 
+    return readJSON(jsonBuffer, marketplaceID, isImport, relativeURL);
+}
+
+bool Octree::readJSON(const QByteArray& jsonBuffer, const QString& marketplaceID, const bool isImport, const QUrl& relativeURL) {
+    // only the top level is parsed here, the entities are left for readFromParsedJSON()
     OctreeEntitiesFileParser octreeParser;
     octreeParser.setRelativeURL(relativeURL);
     octreeParser.setEntitiesString(jsonBuffer);
 
     QVariantMap asMap;
-    if (!octreeParser.parseEntities(asMap)) {
+    if (!octreeParser.parseEntitiesHeader(asMap)) {
         qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
         return false;
     }
 
+    return readFromParsedJSON(asMap, octreeParser, marketplaceID, isImport);
+}
+
+bool Octree::readFromParsedJSON(QVariantMap& entityDescription, const OctreeEntitiesFileParser& parser,
+                                const QString& marketplaceID, const bool isImport) {
+    QVariantList entitiesList;
+    for (int i = 0; i < parser.getNumEntities(); i++) {
+        QJsonObject entityObject;
+        if (!parser.parseEntity(i, entityObject)) {
+            qCritical() << "Couldn't parse Entities JSON: ill-formed entity" << i;
+            return false;
+        }
+        entitiesList.append(entityObject);
+    }
+    entityDescription["Entities"] = std::move(entitiesList);
+
     if (!marketplaceID.isEmpty()) {
-        addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
+        addMarketplaceIDToDocumentEntities(entityDescription, marketplaceID);
     }
 
-    bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
-    return success;
+    return readFromMap(entityDescription, isImport);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -33,6 +33,7 @@
 class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
+class OctreeEntitiesFileParser;
 class OctreePacketData;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
@@ -122,6 +123,13 @@ public:
     {}
 };
 
+/// One edit record decoded off the tree lock by Octree::decodeEditPacketData(), subclassed by trees that support it
+class OctreeDecodedEdit {
+public:
+    virtual ~OctreeDecodedEdit() {}
+};
+using OctreeDecodedEditPointer = std::unique_ptr<OctreeDecodedEdit>;
+
 class Octree : public QObject, public std::enable_shared_from_this<Octree>, public ReadWriteLockable {
     Q_OBJECT
 public:
@@ -138,6 +146,15 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    // Edit packet types whose records can be decoded before taking the tree lock. decodeEditPacketData() may be called
+    // from several threads at once and must not touch the tree; it returns the bytes read, or 0 if the record is
+    // unreadable. processDecodedEdit() is then called in packet order with the tree write locked.
+    virtual bool canDecodeEditPacketType(PacketType packetType) const { return false; }
+    virtual int decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     OctreeDecodedEditPointer& decodedEdit) const { return 0; }
+    virtual void processDecodedEdit(ReceivedMessage& message, OctreeDecodedEdit& decodedEdit,
+                                    const SharedNodePointer& sourceNode) { }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -222,6 +239,10 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    // Reads a file whose top level has been parsed but whose entities are still unparsed in the parser. The default
+    // parses them all into the map for readFromMap(); trees can override it to parse and add them as they go.
+    virtual bool readFromParsedJSON(QVariantMap& entityDescription, const OctreeEntitiesFileParser& parser,
+                                    const QString& marketplaceID, const bool isImport);
 
     uint64_t getOctreeElementsCount();
 
@@ -263,6 +284,8 @@ public:
 
 
 protected:
+    bool readJSON(const QByteArray& jsonBuffer, const QString& marketplaceID, const bool isImport, const QUrl& relativeURL);
+
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
 
     static bool countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData);
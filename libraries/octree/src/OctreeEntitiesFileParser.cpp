@@ -38,6 +38,14 @@ void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesConte
     _line = 1;
 }
 
+bool OctreeEntitiesFileParser::parseEntitiesHeader(QVariantMap& parsedEntities) {
+    _deferEntities = true;
+    _entityRanges.clear();
+    bool success = parseEntities(parsedEntities);
+    _deferEntities = false;
+    return success;
+}
+
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
@@ -91,7 +99,9 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
                 return false;
             }
 
-            parsedEntities["Entities"] = std::move(entitiesValue);
+            if (!_deferEntities) {
+                parsedEntities["Entities"] = std::move(entitiesValue);
+            }
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -231,112 +241,131 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
+        int entityStart = _position - 1;
+        int entityLength = matchingBrace - _position + 1;
+        if (_deferEntities) {
+            _entityRanges.push_back({ entityStart, entityLength });
+        } else {
+            QJsonObject entityObject;
+            if (!parseEntityObject(entityStart, entityLength, entityObject)) {
+                _errorString = "Ill-formed entity";
+                return false;
+            }
+            entitiesArray.append(entityObject);
+        }
+
+        _position = matchingBrace;
+        char c = nextToken();
+        if (c == ']') {
+            return true;
+        } else if (c != ',') {
+            _errorString = "Entity array item incorrectly terminated";
             return false;
         }
+    }
+    return true;
+}
 
-        QJsonObject entityObject = entity.object();
-
-        // resolve urls starting with ./ or ../ 
-        if (!_relativeURL.isEmpty()) {
-            bool isDirty = false;
-
-            const QStringList urlKeys { 
-                // model
-                "modelURL",
-                "animation.url",
-                "textures",
-                // image
-                "imageURL",
-                // web
-                "sourceUrl",
-                "scriptURL",
-                // zone
-                "ambientLight.ambientURL",
-                "skybox.url",
-                // particles
-                //"textures",  Already specified for model entity type.
-                // materials
-                "materialURL",
-                // ...shared
-                "href",
-                "script",
-                "serverScripts",
-                "collisionSoundURL",
-                "compoundShapeURL",
-                // TODO: deal with materialData and userData
-            };
+bool OctreeEntitiesFileParser::parseEntity(int index, QJsonObject& entityObject) const {
+    const EntityRange& range = _entityRanges[index];
+    return parseEntityObject(range.start, range.length, entityObject);
+}
 
-            for (const QString& key : urlKeys) {
-                if (key.contains('.')) {
-                    // url is inside another object
-                    const QStringList keyPair = key.split('.');
-                    const QString entityKey = keyPair[0];
-                    const QString childKey = keyPair[1];
+bool OctreeEntitiesFileParser::isEntityWellFormed(int index) const {
+    const EntityRange& range = _entityRanges[index];
+    return !QJsonDocument::fromJson(QByteArray::fromRawData(_entitiesContents.constData() + range.start, range.length)).isNull();
+}
 
-                    if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
-                        QJsonObject childObject = entityObject[entityKey].toObject();
+bool OctreeEntitiesFileParser::parseEntityObject(int start, int length, QJsonObject& entityObject) const {
+    QJsonDocument entity = QJsonDocument::fromJson(QByteArray::fromRawData(_entitiesContents.constData() + start, length));
+    if (entity.isNull()) {
+        return false;
+    }
 
-                        if (childObject.contains(childKey) && childObject[childKey].isString()) {
-                            const QString url = childObject[childKey].toString();
+    entityObject = entity.object();
+    resolveRelativeURLs(entityObject);
+    return true;
+}
 
-                            if (url.startsWith("./") || url.startsWith("../")) {
-                                childObject[childKey] = _relativeURL.resolved(url).toString();
-                                entityObject[entityKey] = childObject;
-                                isDirty = true;
-                            }
-                        }
+void OctreeEntitiesFileParser::resolveRelativeURLs(QJsonObject& entityObject) const {
+    // resolve urls starting with ./ or ../
+    if (_relativeURL.isEmpty()) {
+        return;
+    }
+
+    static const QStringList urlKeys {
+        // model
+        "modelURL",
+        "animation.url",
+        "textures",
+        // image
+        "imageURL",
+        // web
+        "sourceUrl",
+        "scriptURL",
+        // zone
+        "ambientLight.ambientURL",
+        "skybox.url",
+        // particles
+        //"textures",  Already specified for model entity type.
+        // materials
+        "materialURL",
+        // ...shared
+        "href",
+        "script",
+        "serverScripts",
+        "collisionSoundURL",
+        "compoundShapeURL",
+        // TODO: deal with materialData and userData
+    };
+
+    for (const QString& key : urlKeys) {
+        if (key.contains('.')) {
+            // url is inside another object
+            const QStringList keyPair = key.split('.');
+            const QString entityKey = keyPair[0];
+            const QString childKey = keyPair[1];
+
+            if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
+                QJsonObject childObject = entityObject[entityKey].toObject();
+
+                if (childObject.contains(childKey) && childObject[childKey].isString()) {
+                    const QString url = childObject[childKey].toString();
+
+                    if (url.startsWith("./") || url.startsWith("../")) {
+                        childObject[childKey] = _relativeURL.resolved(url).toString();
+                        entityObject[entityKey] = childObject;
                     }
-                } else {
-                    if (entityObject.contains(key) && entityObject[key].isString()) {
-                        const QString value = entityObject[key].toString();
-
-                        if (value.startsWith("./") || value.startsWith("../")) {
-                            // URL value.
-                            entityObject[key] = _relativeURL.resolved(value).toString();
-                            isDirty = true;
-                        } else if (value.startsWith("{")) {
-                            // Object with URL values.
-                            auto document = QJsonDocument::fromJson(value.toUtf8());
-                            if (!document.isNull()) {
-                                auto object = document.object();
-                                bool isObjectUpdated = false;
-                                for (const QString& key : object.keys()) {
-                                    auto value = object[key].toString();
-                                    if (value.startsWith("./") || value.startsWith("../")) {
-                                        object[key] = _relativeURL.resolved(value).toString();
-                                        isObjectUpdated = true;
-                                    }
-                                }
-                                if (isObjectUpdated) {
-                                    entityObject[key] = QString(QJsonDocument(object).toJson());
-                                    isDirty = true;
-                                }
+                }
+            }
+        } else {
+            if (entityObject.contains(key) && entityObject[key].isString()) {
+                const QString value = entityObject[key].toString();
+
+                if (value.startsWith("./") || value.startsWith("../")) {
+                    // URL value.
+                    entityObject[key] = _relativeURL.resolved(value).toString();
+                } else if (value.startsWith("{")) {
+                    // Object with URL values.
+                    auto document = QJsonDocument::fromJson(value.toUtf8());
+                    if (!document.isNull()) {
+                        auto object = document.object();
+                        bool isObjectUpdated = false;
+                        for (const QString& key : object.keys()) {
+                            auto value = object[key].toString();
+                            if (value.startsWith("./") || value.startsWith("../")) {
+                                object[key] = _relativeURL.resolved(value).toString();
+                                isObjectUpdated = true;
                             }
                         }
+                        if (isObjectUpdated) {
+                            entityObject[key] = QString(QJsonDocument(object).toJson());
+                        }
                     }
                 }
             }
-
-            if (isDirty) {
-                entity.setObject(entityObject);
-            }
-        }
-
-        entitiesArray.append(entityObject);
-        _position = matchingBrace;
-        char c = nextToken();
-        if (c == ']') {
-            return true;
-        } else if (c != ',') {
-            _errorString = "Entity array item incorrectly terminated";
-            return false;
         }
     }
-    return true;
 }
 
 int OctreeEntitiesFileParser::findMatchingBrace() const {
@@ -14,7 +14,10 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <vector>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
@@ -25,12 +28,27 @@ public:
     bool parseEntities(QVariantMap& parsedEntities);
     std::string getErrorString() const;
 
+    // Like parseEntities(), but only finds where each entity object is and leaves "Entities" out of parsedEntities.
+    // The entities can then be parsed one at a time, from any thread, with parseEntity().
+    bool parseEntitiesHeader(QVariantMap& parsedEntities);
+    int getNumEntities() const { return (int)_entityRanges.size(); }
+    bool parseEntity(int index, QJsonObject& entityObject) const;
+    // Whether parseEntity() would succeed, without resolving the entity's relative URLs
+    bool isEntityWellFormed(int index) const;
+
 private:
+    struct EntityRange {
+        int start;
+        int length;
+    };
+
     int nextToken();
     std::string readString();
     int readInteger();
     bool readEntitiesArray(QVariantList& entitiesArray);
     int findMatchingBrace() const;
+    bool parseEntityObject(int start, int length, QJsonObject& entityObject) const;
+    void resolveRelativeURLs(QJsonObject& entityObject) const;
 
     QByteArray _entitiesContents;
     QUrl _relativeURL;
@@ -38,6 +56,8 @@ private:
     int _line { 1 };
     int _entitiesLength { 0 };
     std::string _errorString;
+    bool _deferEntities { false };
+    std::vector<EntityRange> _entityRanges;
 };
 
 #endif  // hifi_OctreeEntitiesFileParser_h
@@ -11,8 +11,14 @@
 
 #include "OctreePacketData.h"
 
+#include <limits>
+
+#include <QtCore/QtEndian>
+
 #include <GLMHelpers.h>
+#include <Gzip.h>
 #include <PerfStat.h>
+#include <UUID.h>
 
 #include "OctreeLogging.h"
 #include "NumericalConstants.h"
@@ -105,6 +111,17 @@ bool OctreePacketData::append(unsigned char byte) {
     return success;
 }
 
+unsigned char* OctreePacketData::appendInPlace(int length) {
+    if (length > _bytesAvailable) {
+        return nullptr;
+    }
+    unsigned char* destination = &_uncompressed[_bytesInUse];
+    _bytesInUse += length;
+    _bytesAvailable -= length;
+    _dirty = true;
+    return destination;
+}
+
 bool OctreePacketData::reserveBitMask() {
     return reserveBytes(sizeof(unsigned char));
 }
@@ -422,15 +439,15 @@ bool OctreePacketData::appendValue(const QVector<glm::quat>& value) {
     bool success = appendValue(qVecSize);
 
     if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
-        unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
-        unsigned char* destinationBuffer = start;
-        for (int index = 0; index < value.size(); index++) {
-            destinationBuffer += packOrientationQuatToBytes(destinationBuffer, value[index]);
-        }
-        int quatsSize = destinationBuffer - start;
-        success = append(start, quatsSize);
+        // packed straight into the stream, each quat taking four uint16_t
+        const int PACKED_QUAT_SIZE = sizeof(uint16_t) * 4;
+        int quatsSize = qVecSize * PACKED_QUAT_SIZE;
+        unsigned char* destinationBuffer = appendInPlace(quatsSize);
+        success = destinationBuffer != nullptr;
         if (success) {
+            for (int index = 0; index < qVecSize; index++) {
+                destinationBuffer += packOrientationQuatToBytes(destinationBuffer, value[index]);
+            }
             _bytesOfValues += quatsSize;
             _totalBytesOfValues += quatsSize;
         }
@@ -457,25 +474,16 @@ bool OctreePacketData::appendValue(const QVector<bool>& value) {
     bool success = appendValue(qVecSize);
 
     if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
-        unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
-        unsigned char* destinationBuffer = start;
-        int bit = 0;
-        for (int index = 0; index < value.size(); index++) {
-            if (value[index]) {
-                (*destinationBuffer) |= (1 << bit);
-            }
-            if (++bit == BITS_IN_BYTE) {
-                destinationBuffer++;
-                bit = 0;
-            }
-        }
-        if (bit != 0) {
-            destinationBuffer++;
-        }
-        int boolsSize = destinationBuffer - start;
-        success = append(start, boolsSize);
+        int boolsSize = (qVecSize + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+        unsigned char* destinationBuffer = appendInPlace(boolsSize);
+        success = destinationBuffer != nullptr;
         if (success) {
+            memset(destinationBuffer, 0, boolsSize);
+            for (int index = 0; index < qVecSize; index++) {
+                if (value[index]) {
+                    destinationBuffer[index / BITS_IN_BYTE] |= (1 << (index % BITS_IN_BYTE));
+                }
+            }
             _bytesOfValues += boolsSize;
             _totalBytesOfValues += boolsSize;
         }
@@ -519,6 +527,26 @@ bool OctreePacketData::appendValue(bool value) {
 }
 
 bool OctreePacketData::appendValue(const QString& string) {
+    // Most strings are ASCII, whose UTF-8 is one byte per character, so try copying them straight into the stream after
+    // where the length goes before falling back to converting them
+    int stringLength = string.size();
+    if (stringLength <= std::numeric_limits<uint16_t>::max() && (int)sizeof(uint16_t) + stringLength <= _bytesAvailable) {
+        const QChar* source = string.constData();
+        unsigned char* destination = &_uncompressed[_bytesInUse + sizeof(uint16_t)];
+        int index = 0;
+        while (index < stringLength && source[index].unicode() < 0x80) {
+            destination[index] = (unsigned char)source[index].unicode();
+            index++;
+        }
+        if (index == stringLength) {
+            appendValue((uint16_t)stringLength);
+            appendInPlace(stringLength);
+            _bytesOfRawData += stringLength;
+            _totalBytesOfRawData += stringLength;
+            return true;
+        }
+    }
+
     // TODO: make this a ByteCountCoded leading byte
     QByteArray utf8Array = string.toUtf8();
     uint16_t length = utf8Array.length(); // no NULL
@@ -530,14 +558,18 @@ bool OctreePacketData::appendValue(const QString& string) {
 }
 
 bool OctreePacketData::appendValue(const QUuid& uuid) {
-    QByteArray bytes = uuid.toRfc4122();
     if (uuid.isNull()) {
         return appendValue((uint16_t)0); // zero length for null uuid
     } else {
-        uint16_t length = bytes.size();
-        bool success = appendValue(length);
+        // the same bytes as QUuid::toRfc4122(), without the QByteArray
+        unsigned char bytes[NUM_BYTES_RFC4122_UUID];
+        qToBigEndian<quint32>(uuid.data1, bytes);
+        qToBigEndian<quint16>(uuid.data2, bytes + 4);
+        qToBigEndian<quint16>(uuid.data3, bytes + 6);
+        memcpy(bytes + 8, uuid.data4, sizeof(uuid.data4));
+        bool success = appendValue((uint16_t)NUM_BYTES_RFC4122_UUID);
         if (success) {
-            success = appendRawData((const unsigned char*)bytes.constData(), bytes.size());
+            success = appendRawData(bytes, NUM_BYTES_RFC4122_UUID);
         }
         return success;
     }
@@ -605,6 +637,21 @@ bool OctreePacketData::appendRawData(QByteArray data) {
 AtomicUIntStat OctreePacketData::_compressContentTime { 0 };
 AtomicUIntStat OctreePacketData::_compressContentCalls { 0 };
 
+// Preset dictionary for entity packet compression. Entity packets are small, so without a dictionary most of each one is
+// spent teaching zlib the strings that show up in nearly every packet. zlib prefers matches near the end of the
+// dictionary, so the most common fragments go last. Changing this breaks decoding of packets from older servers, so
+// bump the EntityData packet version along with it.
+static const QByteArray ENTITY_PACKET_DICTIONARY = QByteArray(
+    "hifi_pbrmaterialVersionmaterialsmodelalbedoMapnormalMapemissiveMaproughnessMapmetallicMapocclusionMapopacityMap"
+    "albedoroughnessmetallicemissiveopacityunlitscatteringdefaultFallthroughcullFaceMode"
+    "\"equipHotspots\":[{\"position\":{\"x\":\"rotation\":{\"w\":\"radius\":\"joints\":{\"RightHand\":[{\"x\":"
+    "\"LeftHand\":[{\"x\":\"wearable\":{\"joints\":{\"Hips\":\"Head\":\"Spine2\":"
+    "\"grabbableKey\":{\"grabbable\":true,\"ignoreIK\":false,\"kinematic\":true,\"cloneable\":false}"
+    ".js?.json.png.jpg.ktx.glb.gltf.obj.fbx"
+    "file:///~/atp:/http://https://cdn.vircadia.com/mpassets.highfidelity.com/"
+    "\":{\"x\":0,\"y\":0,\"z\":0},\"grabbableKey\":{\"grabbable\":false}}"
+);
+
 bool OctreePacketData::compressContent() {
     PerformanceWarning warn(false, "OctreePacketData::compressContent()", false, &_compressContentTime, &_compressContentCalls);
     assert(_dirty);
@@ -613,17 +660,16 @@ bool OctreePacketData::compressContent() {
     _bytesInUseLastCheck = _bytesInUse;
 
     bool success = false;
-    const int MAX_COMPRESSION = 9;
 
-    // we only want to compress the data payload, not the message header
-    const uchar* uncompressedData = &_uncompressed[0];
-    int uncompressedSize = _bytesInUse;
+    // packets are compressed by the send threads, which each get their own stream so it can be reset rather than
+    // reallocated for every packet. The dictionary makes up for most of what the fast level gives up in ratio.
+    static thread_local ZlibCompressor compressor(ENTITY_PACKET_COMPRESSION_LEVEL, ENTITY_PACKET_DICTIONARY);
 
-    QByteArray compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    // we only want to compress the data payload, not the message header
+    int compressedBytes = compressor.compress(&_uncompressed[0], _bytesInUse, _compressed, _compressedByteArray.size());
 
-    if (compressedData.size() < _compressedByteArray.size()) {
-        _compressedBytes = compressedData.size();
-        memcpy(_compressed, compressedData.constData(), _compressedBytes);
+    if (compressedBytes >= 0 && compressedBytes < _compressedByteArray.size()) {
+        _compressedBytes = compressedBytes;
         _dirty = false;
         success = true;
     } else {
@@ -643,21 +689,16 @@ void OctreePacketData::loadFinalizedContent(const unsigned char* data, int lengt
             _compressedBytes = length;
             memcpy(_compressed, data, _compressedBytes);
 
-            QByteArray compressedData;
-            compressedData.resize(_compressedBytes);
-            memcpy(compressedData.data(), data, _compressedBytes);
-
-            QByteArray uncompressedData = qUncompress(compressedData);
-            if (uncompressedData.size() > _bytesAvailable) {
-                int moreNeeded = uncompressedData.size() - _bytesAvailable;
-                _uncompressedByteArray.resize(_uncompressedByteArray.size() + moreNeeded);
-                _uncompressed = (unsigned char*)_uncompressedByteArray.data();
-                _bytesAvailable += moreNeeded;
+            // inflate straight into the uncompressed buffer, then restore its capacity for the bookkeeping below
+            if (!zlibUncompress(data, length, _uncompressedByteArray, ENTITY_PACKET_DICTIONARY)) {
+                qCWarning(octree) << "OctreePacketData::loadFinalizedContent -- unable to uncompress" << length << "bytes";
             }
-
-            _bytesInUse = uncompressedData.size();
-            _bytesAvailable -= uncompressedData.size();
-            memcpy(_uncompressed, uncompressedData.constData(), _bytesInUse);
+            _bytesInUse = _uncompressedByteArray.size();
+            if (_uncompressedByteArray.size() < (int)_targetSize) {
+                _uncompressedByteArray.resize(_targetSize);
+            }
+            _uncompressed = (unsigned char*)_uncompressedByteArray.data();
+            _bytesAvailable = _uncompressedByteArray.size() - _bytesInUse;
         } else {
             memcpy(_uncompressed, data, length);
             _bytesInUse = length;
@@ -721,8 +762,7 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QStrin
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
     dataBytes += sizeof(length);
-    QString value = QString::fromUtf8((const char*)dataBytes, length);
-    result = value;
+    result = QString::fromUtf8((const char*)dataBytes, length);
     return sizeof(length) + length;
 }
 
@@ -730,11 +770,14 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QUuid&
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
     dataBytes += sizeof(length);
-    if (length == 0) {
+    if (length != NUM_BYTES_RFC4122_UUID) {
+        // null, as QUuid::fromRfc4122() would give for any other length
         result = QUuid();
     } else {
-        QByteArray ba((const char*)dataBytes, length);
-        result = QUuid::fromRfc4122(ba);
+        result.data1 = qFromBigEndian<quint32>(dataBytes);
+        result.data2 = qFromBigEndian<quint16>(dataBytes + 4);
+        result.data3 = qFromBigEndian<quint16>(dataBytes + 6);
+        memcpy(result.data4, dataBytes + 8, sizeof(result.data4));
     }
     return sizeof(length) + length;
 }
@@ -744,12 +787,7 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char *dataBytes, QVecto
     memcpy(&length, dataBytes, sizeof(uint16_t));
     dataBytes += sizeof(length);
     result.resize(length);
-
-    for(int i=0;i<length;i++) {
-        memcpy(glm::value_ptr(result[i]), dataBytes, sizeof(glm::vec3));
-        dataBytes += sizeof(glm::vec3);
-    }
-
+    memcpy(result.data(), dataBytes, length * sizeof(glm::vec3));
     return sizeof(uint16_t) + length * sizeof(glm::vec3);
 }
 
@@ -806,8 +844,7 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QByteA
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
     dataBytes += sizeof(length);
-    QByteArray value((const char*)dataBytes, length);
-    result = value;
+    result = QByteArray((const char*)dataBytes, length);
     return sizeof(length) + length;
 }
 
@@ -69,6 +69,9 @@ const int REASONABLE_NUMBER_OF_PACKING_ATTEMPTS = 5;
 const int PACKET_IS_COLOR_BIT = 0;
 const int PACKET_IS_COMPRESSED_BIT = 1;
 
+// zlib level used by the send threads; the preset dictionary keeps the ratio close to level 9 on small packets
+const int ENTITY_PACKET_COMPRESSION_LEVEL = 1;
+
 /// An opaque key used when starting, ending, and discarding encoding/packing levels of OctreePacketData
 class LevelDetails {
     LevelDetails(int startIndex, int bytesOfOctalCodes, int bytesOfBitmasks, int bytesOfColor, int bytesReservedAtStart) :
@@ -301,6 +304,9 @@ private:
     /// append a single byte, might fail if byte would cause packet to be too large
     bool append(unsigned char byte);
 
+    /// claims length bytes at the end of the stream for the caller to write in place, returns nullptr if they don't fit
+    unsigned char* appendInPlace(int length);
+
     unsigned int _targetSize;
     bool _enableCompression;
     
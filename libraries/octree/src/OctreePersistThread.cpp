@@ -27,6 +27,7 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QRegExp>
+#include <QSaveFile>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
@@ -313,29 +314,46 @@ void OctreePersistThread::persist() {
 
         _tree->incrementPersistDataVersion();
 
+        // Serialize the tree once, and use the same data for the persist file and the copy sent to the DS
+        QString jsonString;
+        _tree->toJSONString(jsonString);
+        QByteArray jsonData = jsonString.toUtf8();
+        QByteArray gzippedData;
+        if (!gzip(jsonData, gzippedData, -1)) {
+            qCWarning(octree) << "Failed to compress Octree data for" << _filename;
+            return;
+        }
+
         qCDebug(octree) << "Saving Octree data to:" << _filename;
-        if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
+        QSaveFile persistFile(_filename);
+        if (persistFile.open(QIODevice::WriteOnly) &&
+            persistFile.write(_persistAsFileType == "json.gz" ? gzippedData : jsonData) != -1 &&
+            persistFile.commit()) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
         } else {
-            qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+            qCWarning(octree) << "Failed to persist Octree data to" << _filename << persistFile.errorString();
         }
 
-        sendLatestEntityDataToDS();
+        sendLatestEntityDataToDS(gzippedData);
     }
 }
 
 void OctreePersistThread::sendLatestEntityDataToDS() {
-    qDebug() << "Sending latest entity data to DS";
-    auto nodeList = DependencyManager::get<NodeList>();
-    const DomainHandler& domainHandler = nodeList->getDomainHandler();
-
     QByteArray data;
     if (_tree->toJSON(&data, nullptr, true)) {
-        auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
-        message->write(data);
-        nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+        sendLatestEntityDataToDS(data);
     } else {
         qCWarning(octree) << "Failed to persist octree to DS";
     }
 }
+
+void OctreePersistThread::sendLatestEntityDataToDS(const QByteArray& gzippedData) {
+    qDebug() << "Sending latest entity data to DS";
+    auto nodeList = DependencyManager::get<NodeList>();
+    const DomainHandler& domainHandler = nodeList->getDomainHandler();
+
+    auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
+    message->write(gzippedData);
+    nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+}
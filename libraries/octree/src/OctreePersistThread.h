@@ -64,6 +64,7 @@ protected:
 
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
+    void sendLatestEntityDataToDS(const QByteArray& gzippedData);
 
 private:
     OctreePointer _tree;
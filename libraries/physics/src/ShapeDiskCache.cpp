@@ -0,0 +1,157 @@
+//
+//  ShapeDiskCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShapeDiskCache.h"
+
+#include <cstring>
+
+#include <QFile>
+
+#include "PhysicsLogging.h"
+#include "ShapeFactory.h"
+
+const uint32_t ShapeDiskCache::CURRENT_VERSION = 1;
+
+namespace {
+
+const uint32_t SHAPE_CACHE_MAGIC = 0x50485348; // "HSHP"
+
+struct ShapeCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t fingerprint;
+};
+
+// FNV-1a over the raw geometry: far cheaper than the hull reduction or BVH build it lets us skip
+class Fingerprint {
+public:
+    void add(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            _hash = (_hash ^ bytes[i]) * FNV_PRIME;
+        }
+    }
+    template <typename T>
+    void add(const QVector<T>& values) {
+        add<int32_t>(values.size());
+        add(values.constData(), sizeof(T) * (size_t)values.size());
+    }
+    template <typename T>
+    void add(const T& value) { add(&value, sizeof(T)); }
+    uint64_t get() const { return _hash; }
+private:
+    static const uint64_t FNV_PRIME = 0x100000001b3ULL;
+    uint64_t _hash { 0xcbf29ce484222325ULL };
+};
+
+uint64_t computeFingerprint(const ShapeInfo& info) {
+    Fingerprint fingerprint;
+    fingerprint.add<int32_t>((int32_t)info.getType());
+    fingerprint.add(info.getHalfExtents());
+    fingerprint.add(info.getOffset());
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    fingerprint.add<int32_t>(pointCollection.size());
+    for (const auto& points : pointCollection) {
+        fingerprint.add(points);
+    }
+    fingerprint.add(info.getTriangleIndices());
+    return fingerprint.get();
+}
+
+} // anonymous namespace
+
+bool ShapeDiskCache::isCacheable(ShapeType type) {
+    // only shapes that need hull reduction or a BVH build are worth a trip to disk
+    return type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_HULL
+        || type == SHAPE_TYPE_SIMPLE_COMPOUND || type == SHAPE_TYPE_STATIC_MESH;
+}
+
+ShapeDiskCache::ShapeDiskCache(const std::string& dir) :
+    FileCache(dir, "shape") { }
+
+float ShapeDiskCache::getHitRate() const {
+    uint32_t total = _hitCount + _missCount;
+    return total > 0 ? (float)_hitCount / (float)total : 0.0f;
+}
+
+const btCollisionShape* ShapeDiskCache::createShape(const ShapeInfo& info) {
+    if (!isCacheable(info.getType())) {
+        return ShapeFactory::createShapeFromInfo(info);
+    }
+
+    const Key key = QString::number(info.getHash(), 16).toStdString();
+    uint64_t fingerprint = computeFingerprint(info);
+    const btCollisionShape* shape = loadShape(key, fingerprint);
+    if (shape) {
+        ++_hitCount;
+        return shape;
+    }
+
+    ++_missCount;
+    shape = ShapeFactory::createShapeFromInfo(info);
+    if (shape) {
+        storeShape(key, fingerprint, shape);
+    }
+    return shape;
+}
+
+const btCollisionShape* ShapeDiskCache::loadShape(const Key& key, uint64_t fingerprint) {
+    // holding the FilePointer keeps the entry from being evicted while we read it
+    cache::FilePointer file = getFile(key);
+    if (!file) {
+        return nullptr;
+    }
+
+    QFile qFile(QString::fromStdString(file->getFilepath()));
+    if (!qFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    qint64 size = qFile.size();
+    if (size <= (qint64)sizeof(ShapeCacheHeader)) {
+        return nullptr;
+    }
+    const uchar* data = qFile.map(0, size);
+    if (!data) {
+        return nullptr;
+    }
+
+    const btCollisionShape* shape = nullptr;
+    ShapeCacheHeader header;
+    memcpy(&header, data, sizeof(ShapeCacheHeader));
+    if (header.magic == SHAPE_CACHE_MAGIC && header.version == CURRENT_VERSION && header.fingerprint == fingerprint) {
+        const char* payload = reinterpret_cast<const char*>(data) + sizeof(ShapeCacheHeader);
+        shape = ShapeFactory::deserializeShape(payload, (size_t)size - sizeof(ShapeCacheHeader));
+        if (!shape) {
+            qCWarning(physics) << "ShapeDiskCache: discarding corrupt entry" << key.c_str();
+        }
+    }
+    qFile.unmap(const_cast<uchar*>(data));
+    return shape;
+}
+
+void ShapeDiskCache::storeShape(const Key& key, uint64_t fingerprint, const btCollisionShape* shape) {
+    QByteArray payload;
+    if (!ShapeFactory::serializeShape(shape, payload)) {
+        return;
+    }
+
+    ShapeCacheHeader header;
+    header.magic = SHAPE_CACHE_MAGIC;
+    header.version = CURRENT_VERSION;
+    header.fingerprint = fingerprint;
+    QByteArray data(reinterpret_cast<const char*>(&header), (int)sizeof(ShapeCacheHeader));
+    data.append(payload);
+
+    // overwrite: any existing entry under this key was stale or we wouldn't be here
+    const bool OVERWRITE = true;
+    if (writeFile(data.constData(), Metadata(key, (size_t)data.size()), OVERWRITE)) {
+        ++_storeCount;
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  ShapeDiskCache.h
+//  libraries/physics/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShapeDiskCache_h
+#define hifi_ShapeDiskCache_h
+
+#include <atomic>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+// The ShapeDiskCache persists the expensive parts of finished collision shapes (reduced convex hulls and the
+// BVH of static meshes) so they don't need to be recomputed every session.
+//
+// Entries are keyed by ShapeInfo::getHash().  Since that hash is derived from the model URL and dimensions rather
+// than from the actual geometry each entry also stores a fingerprint of the ShapeInfo's point and index data:
+// when the fingerprint no longer matches (e.g. the model changed on the server) the entry is rebuilt.
+//
+// All methods are thread-safe: the cache is used from both the physics thread and ShapeFactory::Workers.
+
+class ShapeDiskCache;
+using ShapeDiskCachePointer = std::shared_ptr<ShapeDiskCache>;
+
+class ShapeDiskCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format that isn't backward compatible this value
+    // should be incremented.  Entries written with any other version are treated as misses.
+    static const uint32_t CURRENT_VERSION;
+
+    static bool isCacheable(ShapeType type);
+
+    ShapeDiskCache(const std::string& dir);
+
+    // \return shape loaded from disk if possible, else a shape freshly created by the ShapeFactory
+    // (in which case it is also written to disk for next time)
+    const btCollisionShape* createShape(const ShapeInfo& info);
+
+    uint32_t getHitCount() const { return _hitCount; }
+    uint32_t getMissCount() const { return _missCount; }
+    uint32_t getStoreCount() const { return _storeCount; }
+    float getHitRate() const;
+
+private:
+    const btCollisionShape* loadShape(const Key& key, uint64_t fingerprint);
+    void storeShape(const Key& key, uint64_t fingerprint, const btCollisionShape* shape);
+
+    std::atomic_uint _hitCount { 0 };
+    std::atomic_uint _missCount { 0 };
+    std::atomic_uint _storeCount { 0 };
+};
+
+#endif // hifi_ShapeDiskCache_h
@@ -11,11 +11,15 @@
 
 #include "ShapeFactory.h"
 
+#include <cstring>
+
 #include <glm/gtx/norm.hpp>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "ShapeDiskCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,7 +31,24 @@ public:
         assert(_dataArray);
     }
 
+    // this ctor skips the BVH build and instead adopts a BVH that was deserialized in place
+    // into bvhBuffer (which must have been allocated by btAlignedAlloc)
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+        assert(_dataArray);
+        assert(bvh && (void*)bvh == _bvhBuffer);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
+        if (_bvhBuffer) {
+            // the BVH lives inside _bvhBuffer and we own both
+            // (it was constructed in place as a btQuantizedBvh so destroy it through the base)
+            btQuantizedBvh* bvh = getOptimizedBvh();
+            bvh->~btQuantizedBvh();
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
+        }
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -44,9 +65,12 @@ public:
         _dataArray = nullptr;
     }
 
+    const btTriangleIndexVertexArray* getDataArray() const { return _dataArray; }
+
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -483,7 +507,302 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+// Serialized shapes are a tree of tagged records.  All values are written in native byte order: the data is
+// only ever read back by the machine that wrote it (see ShapeDiskCache).
+namespace {
+
+enum SerializedShapeTag : uint32_t {
+    SERIALIZED_CONVEX_HULL = 1,
+    SERIALIZED_COMPOUND = 2,
+    SERIALIZED_STATIC_MESH = 3
+};
+
+const uint32_t MAX_SERIALIZED_COMPOUND_DEPTH = 4;
+
+class ShapeWriter {
+public:
+    ShapeWriter(QByteArray& data) : _data(data) {}
+
+    template <typename T>
+    void write(const T& value) { _data.append(reinterpret_cast<const char*>(&value), (int)sizeof(T)); }
+    void writeBytes(const void* bytes, size_t size) { _data.append(static_cast<const char*>(bytes), (int)size); }
+
+    void writeVector(const btVector3& v) {
+        write<float>((float)v.getX());
+        write<float>((float)v.getY());
+        write<float>((float)v.getZ());
+    }
+
+    void writeTransform(const btTransform& transform) {
+        const btMatrix3x3& basis = transform.getBasis();
+        for (int i = 0; i < 3; ++i) {
+            writeVector(basis[i]);
+        }
+        writeVector(transform.getOrigin());
+    }
+
+private:
+    QByteArray& _data;
+};
+
+class ShapeReader {
+public:
+    ShapeReader(const char* data, size_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (_offset + sizeof(T) > _size) {
+            return false;
+        }
+        memcpy(&value, _data + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    const char* readBytes(size_t size) {
+        if (size > _size - _offset) {
+            return nullptr;
+        }
+        const char* bytes = _data + _offset;
+        _offset += size;
+        return bytes;
+    }
+
+    bool readVector(btVector3& v) {
+        float x, y, z;
+        if (!read(x) || !read(y) || !read(z)) {
+            return false;
+        }
+        v.setValue(x, y, z);
+        return true;
+    }
+
+    bool readTransform(btTransform& transform) {
+        btVector3 rows[3];
+        btVector3 origin;
+        if (!readVector(rows[0]) || !readVector(rows[1]) || !readVector(rows[2]) || !readVector(origin)) {
+            return false;
+        }
+        transform.setBasis(btMatrix3x3(rows[0].getX(), rows[0].getY(), rows[0].getZ(),
+                                       rows[1].getX(), rows[1].getY(), rows[1].getZ(),
+                                       rows[2].getX(), rows[2].getY(), rows[2].getZ()));
+        transform.setOrigin(origin);
+        return true;
+    }
+
+    bool atEnd() const { return _offset == _size; }
+
+private:
+    const char* _data;
+    size_t _size;
+    size_t _offset { 0 };
+};
+
+bool serializeStaticMesh(const StaticMeshShape* meshShape, ShapeWriter& writer) {
+    const IndexedMeshArray& meshes = meshShape->getDataArray()->getIndexedMeshArray();
+    btOptimizedBvh* bvh = const_cast<StaticMeshShape*>(meshShape)->getOptimizedBvh();
+    if (meshes.size() != 1 || !bvh) {
+        return false;
+    }
+    const btIndexedMesh& mesh = meshes[0];
+    if (mesh.m_vertexType != PHY_FLOAT || (mesh.m_indexType != PHY_SHORT && mesh.m_indexType != PHY_INTEGER)) {
+        return false;
+    }
+
+    const int32_t VERTICES_PER_TRIANGLE = 3;
+    size_t indexSize = (mesh.m_indexType == PHY_SHORT) ? sizeof(int16_t) : sizeof(int32_t);
+    writer.write<uint32_t>(SERIALIZED_STATIC_MESH);
+    writer.write<int32_t>(mesh.m_numVertices);
+    writer.writeBytes(mesh.m_vertexBase, VERTICES_PER_TRIANGLE * sizeof(btScalar) * (size_t)mesh.m_numVertices);
+    writer.write<int32_t>(mesh.m_numTriangles);
+    writer.write<int32_t>((int32_t)mesh.m_indexType);
+    writer.writeBytes(mesh.m_triangleIndexBase, VERTICES_PER_TRIANGLE * indexSize * (size_t)mesh.m_numTriangles);
+
+    // btOptimizedBvh serializes into a 16-byte aligned scratch buffer which we then copy out
+    uint32_t bvhSize = bvh->calculateSerializeBufferSize();
+    void* bvhBuffer = btAlignedAlloc(bvhSize, 16);
+    bool success = bvh->serializeInPlace(bvhBuffer, bvhSize, false);
+    if (success) {
+        writer.write<uint32_t>(bvhSize);
+        writer.writeBytes(bvhBuffer, bvhSize);
+    }
+    btAlignedFree(bvhBuffer);
+    return success;
+}
+
+btCollisionShape* deserializeStaticMesh(ShapeReader& reader) {
+    const int32_t VERTICES_PER_TRIANGLE = 3;
+    int32_t numVertices = 0;
+    if (!reader.read(numVertices) || numVertices < VERTICES_PER_TRIANGLE) {
+        return nullptr;
+    }
+    size_t vertexDataSize = VERTICES_PER_TRIANGLE * sizeof(btScalar) * (size_t)numVertices;
+    const char* vertexData = reader.readBytes(vertexDataSize);
+    int32_t numTriangles = 0;
+    int32_t indexType = 0;
+    if (!vertexData || !reader.read(numTriangles) || numTriangles < 1 || !reader.read(indexType)) {
+        return nullptr;
+    }
+    if (indexType != (int32_t)PHY_SHORT && indexType != (int32_t)PHY_INTEGER) {
+        return nullptr;
+    }
+    size_t indexSize = (indexType == (int32_t)PHY_SHORT) ? sizeof(int16_t) : sizeof(int32_t);
+    size_t indexDataSize = VERTICES_PER_TRIANGLE * indexSize * (size_t)numTriangles;
+    const char* indexData = reader.readBytes(indexDataSize);
+    uint32_t bvhSize = 0;
+    if (!indexData || !reader.read(bvhSize) || bvhSize == 0) {
+        return nullptr;
+    }
+    const char* bvhData = reader.readBytes(bvhSize);
+    if (!bvhData) {
+        return nullptr;
+    }
+
+    // the BVH is deserialized in place so it needs its own aligned (and writable) copy
+    void* bvhBuffer = btAlignedAlloc(bvhSize, 16);
+    memcpy(bvhBuffer, bvhData, bvhSize);
+    // NOTE: btOptimizedBvh declares its own deSerializeInPlace() but never defines it, so we use the base class
+    // version.  btOptimizedBvh adds no data members so the cast is safe.
+    btOptimizedBvh* bvh = static_cast<btOptimizedBvh*>(btQuantizedBvh::deSerializeInPlace(bvhBuffer, bvhSize, false));
+    if (!bvh) {
+        btAlignedFree(bvhBuffer);
+        return nullptr;
+    }
+
+    // allocate mesh buffers the same way createStaticMeshArray() does, since StaticMeshShape will delete them
+    btIndexedMesh mesh;
+    mesh.m_numTriangles = numTriangles;
+    mesh.m_triangleIndexBase = new unsigned char[indexDataSize];
+    memcpy(const_cast<unsigned char*>(mesh.m_triangleIndexBase), indexData, indexDataSize);
+    mesh.m_indexType = (PHY_ScalarType)indexType;
+    mesh.m_triangleIndexStride = VERTICES_PER_TRIANGLE * (int)indexSize;
+    mesh.m_numVertices = numVertices;
+    mesh.m_vertexBase = new unsigned char[vertexDataSize];
+    memcpy(const_cast<unsigned char*>(mesh.m_vertexBase), vertexData, vertexDataSize);
+    mesh.m_vertexStride = VERTICES_PER_TRIANGLE * sizeof(btScalar);
+    mesh.m_vertexType = PHY_FLOAT;
+
+    btTriangleIndexVertexArray* dataArray = new btTriangleIndexVertexArray;
+    dataArray->addIndexedMesh(mesh, mesh.m_indexType);
+    return new StaticMeshShape(dataArray, bvh, bvhBuffer);
+}
+
+bool serializeShapeRecursive(const btCollisionShape* shape, ShapeWriter& writer, uint32_t depth) {
+    switch (shape->getShapeType()) {
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+            int32_t numPoints = hull->getNumPoints();
+            writer.write<uint32_t>(SERIALIZED_CONVEX_HULL);
+            writer.write<float>((float)hull->getMargin());
+            writer.write<int32_t>(numPoints);
+            const btVector3* points = hull->getUnscaledPoints();
+            for (int32_t i = 0; i < numPoints; ++i) {
+                writer.writeVector(points[i]);
+            }
+            return true;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            if (depth >= MAX_SERIALIZED_COMPOUND_DEPTH) {
+                return false;
+            }
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            int32_t numChildren = compound->getNumChildShapes();
+            writer.write<uint32_t>(SERIALIZED_COMPOUND);
+            writer.write<int32_t>(numChildren);
+            for (int32_t i = 0; i < numChildren; ++i) {
+                writer.writeTransform(compound->getChildTransform(i));
+                if (!serializeShapeRecursive(compound->getChildShape(i), writer, depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            // all triangle mesh shapes made by the ShapeFactory are StaticMeshShapes
+            return serializeStaticMesh(static_cast<const StaticMeshShape*>(shape), writer);
+        }
+        default:
+            return false;
+    }
+}
+
+btCollisionShape* deserializeShapeRecursive(ShapeReader& reader, uint32_t depth) {
+    uint32_t tag = 0;
+    if (!reader.read(tag)) {
+        return nullptr;
+    }
+    switch (tag) {
+        case SERIALIZED_CONVEX_HULL: {
+            float margin = 0.0f;
+            int32_t numPoints = 0;
+            if (!reader.read(margin) || !reader.read(numPoints) || numPoints < 1) {
+                return nullptr;
+            }
+            btConvexHullShape* hull = new btConvexHullShape();
+            hull->setMargin(margin);
+            btVector3 point;
+            for (int32_t i = 0; i < numPoints; ++i) {
+                if (!reader.readVector(point)) {
+                    delete hull;
+                    return nullptr;
+                }
+                hull->addPoint(point, false);
+            }
+            hull->recalcLocalAabb();
+            return hull;
+        }
+        case SERIALIZED_COMPOUND: {
+            int32_t numChildren = 0;
+            if (depth >= MAX_SERIALIZED_COMPOUND_DEPTH || !reader.read(numChildren) || numChildren < 1) {
+                return nullptr;
+            }
+            btCompoundShape* compound = new btCompoundShape();
+            btTransform transform;
+            for (int32_t i = 0; i < numChildren; ++i) {
+                btCollisionShape* child = nullptr;
+                if (reader.readTransform(transform)) {
+                    child = deserializeShapeRecursive(reader, depth + 1);
+                }
+                if (!child) {
+                    ShapeFactory::deleteShape(compound);
+                    return nullptr;
+                }
+                compound->addChildShape(transform, child);
+            }
+            return compound;
+        }
+        case SERIALIZED_STATIC_MESH:
+            return deserializeStaticMesh(reader);
+        default:
+            return nullptr;
+    }
+}
+
+} // anonymous namespace
+
+bool ShapeFactory::serializeShape(const btCollisionShape* shape, QByteArray& data) {
+    assert(shape);
+    data.clear();
+    ShapeWriter writer(data);
+    if (!serializeShapeRecursive(shape, writer, 0)) {
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+const btCollisionShape* ShapeFactory::deserializeShape(const char* data, size_t size) {
+    ShapeReader reader(data, size);
+    btCollisionShape* shape = deserializeShapeRecursive(reader, 0);
+    if (shape && !reader.atEnd()) {
+        // trailing garbage: don't trust any of it
+        deleteShape(shape);
+        shape = nullptr;
+    }
+    return shape;
+}
+
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    shape = diskCache ? diskCache->createShape(shapeInfo) : ShapeFactory::createShapeFromInfo(shapeInfo);
     emit submitWork(this);
 }
@@ -14,17 +14,28 @@
 
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
+#include <QByteArray>
 #include <QObject>
 #include <QtCore/QRunnable>
 
 #include <ShapeInfo.h>
 
+class ShapeDiskCache;
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // serialize a finished hull, compound or static mesh shape (including its BVH) into a flat buffer
+    // \return false if the shape (or one of its children) is of a type that cannot be serialized
+    bool serializeShape(const btCollisionShape* shape, QByteArray& data);
+
+    // rebuild a shape from a buffer written by serializeShape()
+    // \return nullptr if the data is truncated or malformed
+    const btCollisionShape* deserializeShape(const char* data, size_t size);
+
     class Worker : public QObject, public QRunnable {
         Q_OBJECT
     public:
@@ -32,6 +43,7 @@ namespace ShapeFactory {
         void run() override;
         ShapeInfo shapeInfo;
         const btCollisionShape* shape;
+        ShapeDiskCache* diskCache { nullptr };
     signals:
         void submitWork(Worker*);
     };
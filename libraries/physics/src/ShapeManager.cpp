@@ -16,6 +16,8 @@
 
 #include <NumericalConstants.h>
 
+#include "PhysicsLogging.h"
+
 const int MAX_RING_SIZE = 256;
 
 ShapeManager::ShapeManager() {
@@ -34,6 +36,10 @@ ShapeManager::~ShapeManager() {
         delete _deadWorker;
         _deadWorker = nullptr;
     }
+    if (_diskCache) {
+        qCDebug(physics) << "ShapeDiskCache hits:" << _diskCache->getHitCount() << "misses:" << _diskCache->getMissCount()
+            << "stores:" << _diskCache->getStoreCount();
+    }
 }
 
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
@@ -66,6 +72,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 worker->shapeInfo = info;
                 _deadWorker = nullptr;
             }
+            worker->diskCache = _diskCache.get();
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
@@ -73,7 +80,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
-        shape = ShapeFactory::createShapeFromInfo(info);
+        shape = createShape(info);
         if (shape) {
             ShapeReference newRef;
             newRef.refCount = 1;
@@ -85,6 +92,15 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     return shape;
 }
 
+const btCollisionShape* ShapeManager::createShape(const ShapeInfo& info) {
+    return _diskCache ? _diskCache->createShape(info) : ShapeFactory::createShapeFromInfo(info);
+}
+
+void ShapeManager::setDiskCacheDirectory(const std::string& directory) {
+    _diskCache = std::make_shared<ShapeDiskCache>(directory);
+    _diskCache->initialize();
+}
+
 const btCollisionShape* ShapeManager::getShapeByKey(uint64_t key) {
     HashKey hashKey(key);
     ShapeReference* shapeRef = _shapeMap.find(hashKey);
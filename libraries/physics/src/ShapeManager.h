@@ -22,6 +22,7 @@
 
 #include <ShapeInfo.h>
 
+#include "ShapeDiskCache.h"
 #include "ShapeFactory.h"
 #include "HashKey.h"
 
@@ -46,6 +47,9 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// Optionally the ShapeManager can be given a ShapeDiskCache directory, in which case hulls and static
+// meshes are loaded from disk when possible rather than being rebuilt from scratch.
 
 
 class ShapeManager : public QObject {
@@ -66,6 +70,10 @@ public:
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// enable the on-disk cache of computed shapes, stored in directory (relative to the app local data path or absolute)
+    void setDiskCacheDirectory(const std::string& directory);
+    ShapeDiskCachePointer getDiskCache() const { return _diskCache; }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
     int getNumReferences(const ShapeInfo& info) const;
@@ -80,6 +88,7 @@ protected slots:
 private:
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
+    const btCollisionShape* createShape(const ShapeInfo& info);
 
     class ShapeReference {
     public:
@@ -102,6 +111,7 @@ private:
     std::vector<uint64_t> _garbageRing;
     std::vector<uint64_t> _pendingMeshShapes;
     std::vector<KeyExpiry> _orphans;
+    ShapeDiskCachePointer _diskCache;
     ShapeFactory::Worker* _deadWorker { nullptr };
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
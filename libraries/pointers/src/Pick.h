@@ -11,6 +11,7 @@
 #include <memory>
 #include <stdint.h>
 #include <bitset>
+#include <vector>
 
 #include <QtCore/QUuid>
 #include <QVector>
@@ -228,6 +229,15 @@ public:
     virtual PickResultPointer getAvatarIntersection(const T& pick) = 0;
     virtual PickResultPointer getHUDIntersection(const T& pick) = 0;
 
+    // Pick types whose entity tests can share one traversal of the entity tree override these.
+    // getEntityIntersections is called on one of the picks with all the picks of its type that need an entity test
+    // this update, and returns one result per pick.
+    virtual bool canBatchEntityIntersections() const { return false; }
+    virtual std::vector<PickResultPointer> getEntityIntersections(const std::vector<std::shared_ptr<Pick<T>>>& picks,
+                                                                  const std::vector<T>& mathPicks) {
+        return std::vector<PickResultPointer>();
+    }
+
     QVariantMap toVariantMap() const override {
         QVariantMap properties = PickQuery::toVariantMap();
 
@@ -9,6 +9,7 @@
 #define hifi_PickCacheOptimizer_h
 
 #include <unordered_map>
+#include <vector>
 
 #include "Pick.h"
 
@@ -44,6 +45,11 @@ protected:
 
     // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
+    // Fills the cache with the entity results of the picks that need one, in batches if the pick type allows it
+    // Starts from nextToUpdate and stops batching once expiry has passed, the same as update() does
+    // Returns the number of entity intersections computed
+    int cacheEntityIntersections(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t nextToUpdate,
+                                 uint64_t expiry, PickCache& cache);
     void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
 };
 
@@ -56,6 +62,87 @@ bool PickCacheOptimizer<T>::checkAndCompareCachedResults(T& pick, PickCache& cac
     return false;
 }
 
+template<typename T>
+int PickCacheOptimizer<T>::cacheEntityIntersections(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
+        uint32_t nextToUpdate, uint64_t expiry, PickCache& cache) {
+    // large enough to share the work of a batch, small enough to check the expiry often
+    const size_t MAX_BATCH_SIZE = 32;
+
+    if (picks.size() < 2 || !std::static_pointer_cast<Pick<T>>(picks.begin()->second)->canBatchEntityIntersections()) {
+        return 0;
+    }
+
+    std::vector<std::shared_ptr<Pick<T>>> batchPicks;
+    std::vector<T> batchMathPicks;
+    std::vector<PickCacheKey> batchKeys;
+    auto computeBatch = [&]() {
+        // a batch of one has nothing to share, and update() handles it as before
+        std::vector<PickResultPointer> entityResults;
+        if (batchPicks.size() > 1) {
+            entityResults = batchPicks.front()->getEntityIntersections(batchPicks, batchMathPicks);
+        }
+
+        bool batched = entityResults.size() == batchPicks.size();
+        for (size_t i = 0; i < batchPicks.size(); i++) {
+            auto cached = cache.find(batchMathPicks[i]);
+            if (!batched || !entityResults[i]) {
+                cached->second.erase(batchKeys[i]);
+            } else if (entityResults[i]->doesIntersect()) {
+                cached->second[batchKeys[i]] = entityResults[i];
+            } else {
+                cached->second[batchKeys[i]] = batchPicks[i]->getDefaultResult(batchMathPicks[i].toVariantMap());
+            }
+        }
+        int numComputed = batched ? (int)batchPicks.size() : 0;
+        batchPicks.clear();
+        batchMathPicks.clear();
+        batchKeys.clear();
+        return numComputed;
+    };
+
+    // visit the picks in the order update() will, so that the picks it gets to before the expiry are the batched ones
+    const uint32_t INVALID_PICK_ID = 0;
+    auto itr = picks.begin();
+    if (nextToUpdate != INVALID_PICK_ID) {
+        itr = picks.find(nextToUpdate);
+        if (itr == picks.end()) {
+            itr = picks.begin();
+        }
+    }
+    int numIntersectionsComputed = 0;
+    for (size_t numVisited = 1; numVisited <= picks.size(); numVisited++) {
+        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
+        ++itr;
+        if (itr == picks.end()) {
+            itr = picks.begin();
+        }
+
+        if (pick->isEnabled() && pick->getMaxDistance() >= 0.0f &&
+            (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities())) {
+            T mathematicalPick = pick->getMathematicalPick();
+            if (mathematicalPick) {
+                PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+                auto cached = cache.find(mathematicalPick);
+                if (cached == cache.end() || cached->second.find(entityKey) == cached->second.end()) {
+                    // reserve the cache entry so that identical picks are only computed once
+                    cache[mathematicalPick][entityKey] = PickResultPointer();
+                    batchPicks.push_back(pick);
+                    batchMathPicks.push_back(mathematicalPick);
+                    batchKeys.push_back(entityKey);
+                }
+            }
+        }
+
+        if (batchPicks.size() == MAX_BATCH_SIZE || (numVisited == picks.size() && !batchPicks.empty())) {
+            numIntersectionsComputed += computeBatch();
+            if (usecTimestampNow() > expiry) {
+                break;
+            }
+        }
+    }
+    return numIntersectionsComputed;
+}
+
 template<typename T>
 void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick) {
     if (needToCompareResults) {
@@ -71,6 +158,7 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
         uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
     QVector3D numIntersectionsComputed;
     PickCache results;
+    numIntersectionsComputed[0] += cacheEntityIntersections(picks, nextToUpdate, expiry, results);
     const uint32_t INVALID_PICK_ID = 0;
     auto itr = picks.begin();
     if (nextToUpdate != INVALID_PICK_ID) {
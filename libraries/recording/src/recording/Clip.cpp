@@ -19,6 +19,10 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 using namespace recording;
 
 Clip::Pointer Clip::fromFile(const QString& filePath) {
@@ -54,8 +58,22 @@ float Clip::position() const {
     return Frame::frameTimeToSeconds(positionFrameTime());
 }
 
+// Where a frame landed in the output, recorded so that the seek index can be written after the frames
+struct FrameIndexEntry {
+    FrameType type;
+    Frame::Time timeOffset;
+    FrameSize size;
+    quint64 dataOffset;
+};
+
+using FrameIndex = std::vector<FrameIndexEntry>;
+
+// Keeps each index frame's data within the 16 bit frame size
+static const size_t MAX_FRAME_INDEX_ENTRIES_PER_FRAME = 4000;
+
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+bool writeFrame(QIODevice& output, const Frame& frame, quint64& position, FrameIndex* index = nullptr,
+                bool compressed = true) {
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
@@ -75,6 +93,11 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
         frameData = qCompress(frameData);
     }
 
+    if (frameData.size() > std::numeric_limits<FrameSize>::max()) {
+        qWarning() << "Frame data too large to write" << frameData.size();
+        return false;
+    }
+
     uint16_t dataSize = frameData.size();
     written = output.write((char*)&dataSize, sizeof(FrameSize));
     if (written != sizeof(uint16_t)) {
@@ -87,9 +110,43 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
             return false;
         }
     }
+
+    position += PointerClip::MINIMUM_FRAME_SIZE;
+    if (index) {
+        index->push_back({ frame.type, frame.timeOffset, dataSize, position });
+    }
+    position += dataSize;
     return true;
 }
 
+// The index is a run of uncompressed TYPE_INDEX frames holding the position of every frame in the clip, followed by a
+// fixed size TYPE_INDEX_LOCATOR frame that points back at the first of them.  Readers find the locator at the end of
+// the file and can build their frame table without touching the frames themselves.
+static bool writeFrameIndex(QIODevice& output, const FrameIndex& index, quint64& position) {
+    quint64 indexOffset = position;
+    for (size_t begin = 0; begin < index.size(); begin += MAX_FRAME_INDEX_ENTRIES_PER_FRAME) {
+        size_t end = std::min(begin + MAX_FRAME_INDEX_ENTRIES_PER_FRAME, index.size());
+        QByteArray indexData;
+        indexData.reserve((int)((end - begin) * PointerClip::FRAME_INDEX_ENTRY_SIZE));
+        for (size_t i = begin; i < end; ++i) {
+            const auto& entry = index[i];
+            indexData.append((const char*)&entry.type, sizeof(FrameType));
+            indexData.append((const char*)&entry.timeOffset, sizeof(Frame::Time));
+            indexData.append((const char*)&entry.size, sizeof(FrameSize));
+            indexData.append((const char*)&entry.dataOffset, sizeof(quint64));
+        }
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, indexData }), position, nullptr, false)) {
+            return false;
+        }
+    }
+
+    uint32_t entryCount = (uint32_t)index.size();
+    QByteArray locatorData;
+    locatorData.append((const char*)&indexOffset, sizeof(quint64));
+    locatorData.append((const char*)&entryCount, sizeof(uint32_t));
+    return writeFrame(output, Frame({ Frame::TYPE_INDEX_LOCATOR, 0, locatorData }), position, nullptr, false);
+}
+
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
 
@@ -105,17 +162,22 @@ bool Clip::write(QIODevice& output) {
     // Always mark new files as compressed
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
+
+    quint64 position = 0;
+    FrameIndex index;
+    index.reserve(frameCount() + 1);
+
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), position, &index, false)) {
         return false;
     }
 
     seek(0);
 
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (!writeFrame(output, *frame, position, &index)) {
             return false;
         }
     }
-    return true;
+    return writeFrameIndex(output, index, position);
 }
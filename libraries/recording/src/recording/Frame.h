@@ -36,6 +36,10 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    // Reserved types for the seek index written at the end of a clip file.  They are never present in the header's
+    // frame type map, so readers that predate the index drop them like any other unknown frame type.
+    static const FrameType TYPE_INDEX = 0xFFFE;
+    static const FrameType TYPE_INDEX_LOCATOR = 0xFFFD;
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
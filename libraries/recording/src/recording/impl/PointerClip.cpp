@@ -45,7 +45,7 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+PointerFrameHeaderList recording::parseFrameHeaders(uchar* const start, const size_t& size) {
     PointerFrameHeaderList results;
     auto current = start;
     auto end = current + size;
@@ -74,6 +74,71 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
     return results;
 }
 
+// Reads the frame table from the seek index at the end of the clip, if it has one.  Returns an empty list when the
+// index is missing or doesn't agree with the data, in which case the caller walks the frames instead.
+PointerFrameHeaderList recording::parseFrameIndex(uchar* const start, const size_t& size) {
+    PointerFrameHeaderList results;
+    const size_t locatorFrameSize = PointerClip::MINIMUM_FRAME_SIZE + PointerClip::FRAME_INDEX_LOCATOR_SIZE;
+    if (size < locatorFrameSize) {
+        return results;
+    }
+
+    // The locator is always the last frame of an indexed clip
+    auto locator = start + size - locatorFrameSize;
+    FrameType type;
+    FrameSize locatorSize;
+    memcpy(&type, locator, sizeof(FrameType));
+    memcpy(&locatorSize, locator + sizeof(FrameType) + sizeof(Frame::Time), sizeof(FrameSize));
+    if (type != Frame::TYPE_INDEX_LOCATOR || locatorSize != PointerClip::FRAME_INDEX_LOCATOR_SIZE) {
+        return results;
+    }
+
+    quint64 indexOffset;
+    uint32_t entryCount;
+    locator += PointerClip::MINIMUM_FRAME_SIZE;
+    memcpy(&indexOffset, locator, sizeof(quint64));
+    memcpy(&entryCount, locator + sizeof(quint64), sizeof(uint32_t));
+    if (indexOffset > size - locatorFrameSize) {
+        return results;
+    }
+
+    auto current = start + indexOffset;
+    auto indexEnd = start + size - locatorFrameSize;
+    while (results.size() < entryCount && indexEnd - current >= PointerClip::MINIMUM_FRAME_SIZE) {
+        FrameSize indexSize;
+        memcpy(&type, current, sizeof(FrameType));
+        memcpy(&indexSize, current + sizeof(FrameType) + sizeof(Frame::Time), sizeof(FrameSize));
+        current += PointerClip::MINIMUM_FRAME_SIZE;
+        if (type != Frame::TYPE_INDEX || indexEnd - current < indexSize ||
+                indexSize % PointerClip::FRAME_INDEX_ENTRY_SIZE != 0) {
+            return PointerFrameHeaderList();
+        }
+
+        for (auto entry = current; entry < current + indexSize; entry += PointerClip::FRAME_INDEX_ENTRY_SIZE) {
+            PointerFrameHeader header;
+            auto field = entry;
+            memcpy(&(header.type), field, sizeof(FrameType));
+            field += sizeof(FrameType);
+            memcpy(&(header.timeOffset), field, sizeof(Frame::Time));
+            field += sizeof(Frame::Time);
+            memcpy(&(header.size), field, sizeof(FrameSize));
+            field += sizeof(FrameSize);
+            memcpy(&(header.fileOffset), field, sizeof(quint64));
+            if (header.fileOffset > indexOffset || indexOffset - header.fileOffset < header.size) {
+                return PointerFrameHeaderList();
+            }
+            results.push_back(header);
+        }
+        current += indexSize;
+    }
+
+    if (results.size() != entryCount) {
+        return PointerFrameHeaderList();
+    }
+    qDebug(recordingLog) << "Read frame index with " << results.size() << " frames";
+    return results;
+}
+
 void PointerClip::reset() {
     _frames.clear();
     _data = nullptr;
@@ -87,7 +152,11 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    auto parsedFrameHeaders = parseFrameIndex(data, size);
+    if (parsedFrameHeaders.empty()) {
+        // Clips written before the seek index existed
+        parsedFrameHeaders = parseFrameHeaders(data, size);
+    }
     // Verify that at least one frame exists and that the first frame is a header
     if (0 == parsedFrameHeaders.size()) {
         qWarning() << "No frames found, invalid file";
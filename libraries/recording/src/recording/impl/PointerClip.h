@@ -29,6 +29,11 @@ struct PointerFrameHeader : public FrameHeader {
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
 
+// Builds the frame table of clip data by walking every frame header
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size);
+// Builds the frame table from the seek index at the end of clip data, empty if there is none or it can't be trusted
+PointerFrameHeaderList parseFrameIndex(uchar* const start, const size_t& size);
+
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
@@ -44,6 +49,10 @@ public:
 
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+    // Seek index entries are a frame header plus the offset of the frame data, the locator is the offset of the first
+    // index frame plus the number of entries
+    static const size_t FRAME_INDEX_ENTRY_SIZE = MINIMUM_FRAME_SIZE + sizeof(quint64);
+    static const size_t FRAME_INDEX_LOCATOR_SIZE = sizeof(quint64) + sizeof(uint32_t);
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
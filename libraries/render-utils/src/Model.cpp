@@ -1484,11 +1484,37 @@ void Model::updateClusterMatrices() {
 
     _needsUpdateClusterMatrices = false;
     const HFMModel& hfmModel = getHFMModel();
+    // hold the skeleton once for all clusters rather than copying the shared pointer per cluster
+    const AnimSkeleton::ConstPointer skeleton = _rig.getAnimSkeleton();
+    const int numBindMeshes = skeleton ? skeleton->getNumClusterBindMatrixMeshes() : 0;
     for (int i = 0; i < (int) _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
-        int meshIndex = i;
         const HFMMesh& mesh = hfmModel.meshes.at(i);
-        for (int j = 0; j < mesh.clusters.size(); j++) {
+        const int numClusters = mesh.clusters.size();
+
+        if (skeleton && numClusters > 0 && i < numBindMeshes &&
+            (int)skeleton->getClusterBindMatricesOriginalValues(i).size() >= numClusters) {
+            const std::vector<HFMCluster>& bindClusters = skeleton->getClusterBindMatricesOriginalValues(i);
+            if (_useDualQuaternionSkinning) {
+                for (int j = 0; j < numClusters; j++) {
+                    auto jointPose = _rig.getJointPose(mesh.clusters.at(j).jointIndex);
+                    Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
+                    Transform clusterTransform;
+                    Transform::mult(clusterTransform, jointTransform, bindClusters[j].inverseBindTransform);
+                    state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
+                }
+            } else {
+                glm::mat4* clusterMatrices = state.clusterMatrices.data();
+                for (int j = 0; j < numClusters; j++) {
+                    glm_mat4u_mul(_rig.getJointTransform(mesh.clusters.at(j).jointIndex), bindClusters[j].inverseBindMatrix, clusterMatrices[j]);
+                }
+            }
+            continue;
+        }
+
+        // the bind table doesn't cover this mesh (yet), so look each cluster up individually as before
+        int meshIndex = i;
+        for (int j = 0; j < numClusters; j++) {
             const HFMCluster& cluster = mesh.clusters.at(j);
             int clusterIndex = j;
 
@@ -1838,30 +1864,46 @@ static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 class Blender : public QRunnable {
 public:
 
-    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
+    Blender(std::vector<BlendJob>&& jobs);
 
     virtual void run() override;
 
 private:
-    ModelPointer _model;
-    HFMModel::ConstPointer _hfmModel;
-    int _blendNumber;
-    QVector<float> _blendshapeCoefficients;
+    void blend(const BlendJob& job, BlendedVertices& result);
+
+    std::vector<BlendJob> _jobs;
+
+    // scratch space reused across all the jobs of this blender
+    QVector<BlendshapeOffsetUnpacked> _unpackedBlendshapeOffsets;
 };
 
-Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
-    _model(model),
-    _hfmModel(hfmModel),
-    _blendNumber(blendNumber),
-    _blendshapeCoefficients(blendshapeCoefficients) {
+Blender::Blender(std::vector<BlendJob>&& jobs) :
+    _jobs(std::move(jobs)) {
 }
 
 void Blender::run() {
-    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
+    std::vector<BlendedVertices> results(_jobs.size());
+    for (size_t i = 0; i < _jobs.size(); ++i) {
+        blend(_jobs[i], results[i]);
+    }
+    _jobs.clear();
+
+    // post all results to the ModelBlender at once, which will dispatch to the models if still alive
+    auto modelBlender = DependencyManager::get<ModelBlender>();
+    if (modelBlender) {
+        QMetaObject::invokeMethod(modelBlender.data(), [modelBlender, results = std::move(results)] {
+            modelBlender->setBlendedVertices(results);
+        });
+    }
+}
+
+void Blender::blend(const BlendJob& job, BlendedVertices& result) {
+    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", job.model->getURL().toString() } });
+    const HFMModel::ConstPointer& hfmModel = job.hfmModel;
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
     int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
     int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (auto meshIter = hfmModel->meshes.cbegin(); meshIter != hfmModel->meshes.cend(); ++meshIter) {
         numMeshes++;
         if (meshIter->blendshapes.isEmpty()) {
             continue;
@@ -1872,17 +1914,20 @@ void Blender::run() {
     }
 
     // allocate the required sizes
-    QVector<int> blendedMeshSizes;
+    result.model = job.model;
+    result.blendNumber = job.blendNumber;
+    QVector<int>& blendedMeshSizes = result.blendedMeshSizes;
     blendedMeshSizes.reserve(numMeshes);
 
-    QVector<BlendshapeOffset> packedBlendshapeOffsets;
+    QVector<BlendshapeOffset>& packedBlendshapeOffsets = result.blendshapeOffsets;
     packedBlendshapeOffsets.resize(numBlendshapeOffsets);
 
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    if (_unpackedBlendshapeOffsets.size() < maxBlendshapeOffsets) {
+        _unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    }
 
     int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (auto meshIter = hfmModel->meshes.cbegin(); meshIter != hfmModel->meshes.cend(); ++meshIter) {
         if (meshIter->blendshapes.isEmpty()) {
             blendedMeshSizes.push_back(0);
             continue;
@@ -1891,12 +1936,12 @@ void Blender::run() {
         blendedMeshSizes.push_back(numVertsInMesh);
 
         // initialize offsets to zero
-        memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
+        memset(_unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
 
         // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
         const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
-            float vertexCoefficient = _blendshapeCoefficients.at(i);
+        for (int i = 0, n = qMin(job.blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
+            float vertexCoefficient = job.blendshapeCoefficients.at(i);
             const float EPSILON = 0.0001f;
             if (vertexCoefficient < EPSILON) {
                 continue;
@@ -1907,7 +1952,7 @@ void Blender::run() {
             for (int j = 0; j < blendshape.indices.size(); ++j) {
                 int index = blendshape.indices.at(j);
 
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
+                auto& currentBlendshapeOffset = _unpackedBlendshapeOffsets[index];
                 currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
                 currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
                 if (j < blendshape.tangents.size()) {
@@ -1917,35 +1962,36 @@ void Blender::run() {
         }
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
-        auto unpacked = unpackedBlendshapeOffsets.data();
+        auto unpacked = _unpackedBlendshapeOffsets.data();
         auto packed = packedBlendshapeOffsets.data() + offset;
         packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
 
         offset += numVertsInMesh;
     }
     Q_ASSERT(offset == numBlendshapeOffsets);
-
-    // post the result to the ModelBlender, which will dispatch to the model if still alive
-    QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
-                              Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
-                              Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
-                              Q_ARG(QVector<int>, blendedMeshSizes));
 }
 
-bool Model::maybeStartBlender() {
+bool Model::prepareBlendJob(BlendJob& job) {
     if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
+        job.model = getThisPointer();
+        job.hfmModel = getGeometry()->getConstHFMModelPointer();
+        job.blendNumber = ++_blendNumber;
+        job.blendshapeCoefficients = _blendshapeCoefficients;
         return true;
     }
     return false;
 }
 
+const size_t ModelBlender::MAX_JOBS_PER_BLENDER = 16;
+
 ModelBlender::ModelBlender() :
     _pendingBlenders(0) {
+    // leave a core for the main thread
+    _blenderThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
 }
 
 ModelBlender::~ModelBlender() {
+    _blenderThreadPool.waitForDone();
 }
 
 void ModelBlender::noteRequiresBlend(ModelPointer model) {
@@ -1954,41 +2000,47 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
         _modelsRequiringBlendsQueue.push(model);
         _modelsRequiringBlendsSet.insert(model);
     }
+    maybeStartBlender();
+}
 
-    if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
-            }
+void ModelBlender::maybeStartBlender() {
+    if (_pendingBlenders >= _blenderThreadPool.maxThreadCount()) {
+        // every thread is busy: let requests pile up so the next free thread can take several at once
+        return;
+    }
+
+    std::vector<BlendJob> jobs;
+    while (!_modelsRequiringBlendsQueue.empty() && jobs.size() < MAX_JOBS_PER_BLENDER) {
+        auto weakPtr = _modelsRequiringBlendsQueue.front();
+        _modelsRequiringBlendsQueue.pop();
+        _modelsRequiringBlendsSet.erase(weakPtr);
+        ModelPointer nextModel = weakPtr.lock();
+        BlendJob job;
+        if (nextModel && nextModel->prepareBlendJob(job)) {
+            jobs.push_back(std::move(job));
         }
     }
+
+    if (!jobs.empty()) {
+        _pendingBlenders++;
+        _blenderThreadPool.start(new Blender(std::move(jobs)));
+    }
 }
 
-void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes) {
-    if (model) {
-        auto blendshapeOperator = model->getModelBlendshapeOperator();
-        if (blendshapeOperator) {
-            blendshapeOperator(blendNumber, blendshapeOffsets, blendedMeshSizes, model->fetchRenderItemIDs());
+void ModelBlender::setBlendedVertices(const std::vector<BlendedVertices>& blendedVertices) {
+    for (const auto& result : blendedVertices) {
+        const ModelPointer& model = result.model;
+        if (model) {
+            auto blendshapeOperator = model->getModelBlendshapeOperator();
+            if (blendshapeOperator) {
+                blendshapeOperator(result.blendNumber, result.blendshapeOffsets, result.blendedMeshSizes, model->fetchRenderItemIDs());
+            }
         }
     }
 
     {
         Lock lock(_mutex);
         _pendingBlenders--;
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
-            }
-        }
+        maybeStartBlender();
     }
 }
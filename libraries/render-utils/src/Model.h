@@ -16,6 +16,7 @@
 #include <QObject>
 #include <QUrl>
 #include <QMutex>
+#include <QThreadPool>
 
 #include <unordered_map>
 #include <unordered_set>
@@ -65,6 +66,7 @@ inline uint qHash(const std::shared_ptr<MeshPartPayload>& a, uint seed) {
 class Model;
 using ModelPointer = std::shared_ptr<Model>;
 using ModelWeakPointer = std::weak_ptr<Model>;
+struct BlendJob;
 
 struct SortedTriangleSet {
     SortedTriangleSet(float distance, TriangleSet* triangleSet, int partIndex, int shapeID, int subMeshIndex) :
@@ -162,7 +164,8 @@ public:
     AABox getRenderableMeshBound() const;
     const render::ItemIDs& fetchRenderItemIDs() const;
 
-    bool maybeStartBlender();
+    /// Snapshots the current blendshape coefficients into job; returns false if the model can't be blended yet
+    bool prepareBlendJob(BlendJob& job);
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
@@ -519,20 +522,42 @@ Q_DECLARE_METATYPE(ModelPointer)
 Q_DECLARE_METATYPE(Geometry::WeakPointer)
 Q_DECLARE_METATYPE(BlendshapeOffset)
 
+/// A snapshot of one model's blendshape state, blended on a ModelBlender thread
+struct BlendJob {
+    ModelPointer model;
+    HFMModel::ConstPointer hfmModel;
+    int blendNumber { 0 };
+    QVector<float> blendshapeCoefficients;
+};
+
+/// The result of a BlendJob, handed back to the model on the main thread
+struct BlendedVertices {
+    ModelPointer model;
+    int blendNumber { 0 };
+    QVector<BlendshapeOffset> blendshapeOffsets;
+    QVector<int> blendedMeshSizes;
+};
+
 /// Handle management of pending models that need blending
+///
+/// Blends run on a dedicated thread pool.  While all of its threads are busy new requests queue up and the next
+/// free thread takes up to MAX_JOBS_PER_BLENDER of them at once, returning all of their results in one queued call.
 class ModelBlender : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 
 public:
+    static const size_t MAX_JOBS_PER_BLENDER;
 
     /// Adds the specified model to the list requiring vertex blends.
     void noteRequiresBlend(ModelPointer model);
 
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
 
+    /// Delivers the results of one blender to their models; must be called on the ModelBlender's thread
+    void setBlendedVertices(const std::vector<BlendedVertices>& blendedVertices);
+
 public slots:
-    void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
 
 private:
@@ -542,8 +567,12 @@ private:
     ModelBlender();
     virtual ~ModelBlender();
 
+    // must be called with _mutex held
+    void maybeStartBlender();
+
     std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
     std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
+    QThreadPool _blenderThreadPool;
     int _pendingBlenders;
     Mutex _mutex;
 
@@ -13,12 +13,72 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <iterator>
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
+namespace {
+
+// Item lists shorter than this are culled inline: below it the cost of spawning tasks outweighs the gain.
+const size_t MIN_ITEMS_PER_CULL_TASK = 512;
+
+enum CullFlags : uint8_t {
+    CULL_NONE = 0x00,
+    CULL_FRUSTUM = 0x01,
+    CULL_SOLID_ANGLE = 0x02
+};
+
+void cullItemRange(const ItemID* begin, const ItemID* end, uint8_t cullFlags, const ItemFilter& filter,
+                   Scene& scene, RenderArgs* args, CullTest& test, ItemBounds& outItems) {
+    for (auto itr = begin; itr != end; ++itr) {
+        auto& item = scene.getItem(*itr);
+        if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
+            ItemBound itemBound(*itr, item.getBound(args));
+            if ((!(cullFlags & CULL_FRUSTUM) || test.frustumTest(itemBound.bound)) &&
+                    (!(cullFlags & CULL_SOLID_ANGLE) || test.solidAngleTest(itemBound.bound))) {
+                outItems.emplace_back(itemBound);
+                if (item.getKey().isMetaCullGroup()) {
+                    item.fetchMetaSubItemBounds(outItems, scene, args);
+                }
+            }
+        }
+    }
+}
+
+// Culls a list of item ids, splitting large lists into chunks which are culled in parallel.
+// Chunk results are appended in order so the output is identical to a serial pass.
+void cullItems(const ItemIDs& ids, uint8_t cullFlags, const ItemFilter& filter,
+               Scene& scene, RenderArgs* args, CullTest& test, ItemBounds& outItems) {
+    const size_t numItems = ids.size();
+    if (numItems < 2 * MIN_ITEMS_PER_CULL_TASK) {
+        cullItemRange(ids.data(), ids.data() + numItems, cullFlags, filter, scene, args, test, outItems);
+        return;
+    }
+
+    const size_t numChunks = (numItems + MIN_ITEMS_PER_CULL_TASK - 1) / MIN_ITEMS_PER_CULL_TASK;
+    std::vector<ItemBounds> chunkItems(numChunks);
+    std::vector<RenderDetails::Item> chunkDetails(numChunks);
+    tbb::parallel_for((size_t)0, numChunks, [&](size_t chunk) {
+        size_t begin = chunk * MIN_ITEMS_PER_CULL_TASK;
+        size_t end = std::min(begin + MIN_ITEMS_PER_CULL_TASK, numItems);
+        CullTest chunkTest(test, chunkDetails[chunk]);
+        chunkItems[chunk].reserve(end - begin);
+        cullItemRange(ids.data() + begin, ids.data() + end, cullFlags, filter, scene, args, chunkTest, chunkItems[chunk]);
+    });
+
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        outItems.insert(outItems.end(), chunkItems[chunk].begin(), chunkItems[chunk].end());
+        test._renderDetails._outOfView += chunkDetails[chunk]._outOfView;
+        test._renderDetails._tooSmall += chunkDetails[chunk]._tooSmall;
+    }
+}
+
+} // anonymous namespace
+
 std::unordered_set<QUuid> CullTest::_containingZones = std::unordered_set<QUuid>();
 std::unordered_set<QUuid> CullTest::_prevContainingZones = std::unordered_set<QUuid>();
 
@@ -27,6 +87,13 @@ CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item&
     _args(pargs),
     _renderDetails(renderDetails),
     _antiFrustum(antiFrustum) {
+    const ::Plane* planes = _args->getViewFrustum().getPlanes();
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        const glm::vec3& normal = planes[i].getNormal();
+        _frustumPlanes[i] = glm::vec4(normal, planes[i].getDCoefficient());
+        _frustumPlaneAbsNormals[i] = glm::abs(normal);
+    }
+
     // FIXME: Keep this code here even though we don't use it yet
     /*_eyePos = _args->getViewFrustum().getPosition();
     float a = glm::degrees(Octree::getPerspectiveAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
@@ -37,10 +104,29 @@ CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item&
     */
 }
 
+CullTest::CullTest(const CullTest& other, RenderDetails::Item& renderDetails) :
+    _functor(other._functor),
+    _args(other._args),
+    _renderDetails(renderDetails),
+    _antiFrustum(other._antiFrustum),
+    _eyePos(other._eyePos),
+    _squareTanAlpha(other._squareTanAlpha) {
+    std::copy(std::begin(other._frustumPlanes), std::end(other._frustumPlanes), std::begin(_frustumPlanes));
+    std::copy(std::begin(other._frustumPlaneAbsNormals), std::end(other._frustumPlaneAbsNormals), std::begin(_frustumPlaneAbsNormals));
+}
+
 bool CullTest::frustumTest(const AABox& bound) {
-    if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-        _renderDetails._outOfView++;
-        return false;
+    // Same result as ViewFrustum::boxIntersectsFrustum() but in center/extent form: the distance of the farthest
+    // vertex is dot(n, center) + d + dot(|n|, halfScale), which needs no per-axis selects and vectorizes well.
+    const glm::vec3 halfScale = 0.5f * bound.getScale();
+    const glm::vec3 center = bound.getCorner() + halfScale;
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        const glm::vec4& plane = _frustumPlanes[i];
+        float distance = glm::dot(glm::vec3(plane), center) + plane.w + glm::dot(_frustumPlaneAbsNormals[i], halfScale);
+        if (distance < 0.0f) {
+            _renderDetails._outOfView++;
+            return false;
+        }
     }
     return true;
 }
@@ -181,134 +267,33 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        const bool skipCulling = _skipCulling || _overrideSkipCulling;
 
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullItems(inSelection.insideItems, CULL_NONE, filter, *scene, args, test, outItems);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            uint8_t cullFlags = skipCulling ? CULL_NONE : CULL_SOLID_ANGLE;
+            cullItems(inSelection.insideSubcellItems, cullFlags, filter, *scene, args, test, outItems);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            uint8_t cullFlags = skipCulling ? CULL_NONE : CULL_FRUSTUM;
+            cullItems(inSelection.partialItems, cullFlags, filter, *scene, args, test, outItems);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            uint8_t cullFlags = skipCulling ? CULL_NONE : (CULL_FRUSTUM | CULL_SOLID_ANGLE);
+            cullItems(inSelection.partialSubcellItems, cullFlags, filter, *scene, args, test, outItems);
         }
     }
 
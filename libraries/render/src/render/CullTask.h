@@ -28,7 +28,13 @@ namespace render {
         glm::vec3 _eyePos;
         float _squareTanAlpha;
 
+        // frustum planes (normal, d) and absolute normals cached at construction for the center/extent box test
+        glm::vec4 _frustumPlanes[NUM_FRUSTUM_PLANES];
+        glm::vec3 _frustumPlaneAbsNormals[NUM_FRUSTUM_PLANES];
+
         CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum = nullptr);
+        // copy the tests of another CullTest but accumulate details separately (for use on worker threads)
+        CullTest(const CullTest& other, RenderDetails::Item& renderDetails);
 
         bool frustumTest(const AABox& bound);
         bool antiFrustumTest(const AABox& bound);
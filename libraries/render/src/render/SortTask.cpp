@@ -13,86 +13,87 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <cstring>
+
+#include <Radix2InplaceSort.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
+namespace {
 
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
-};
+// Depth keys are the top DEPTH_KEY_BITS bits of the squared distance's IEEE-754 representation below the sign bit.
+// Since the squared distance is never negative these order exactly like the floats themselves.  Dropping the low
+// mantissa bits still leaves better than 1e-4 relative precision, which is plenty for draw ordering, and shortens
+// the radix sort.
+const uint32_t DEPTH_KEY_BITS = 24;
+const uint32_t DEPTH_KEY_MASK = (1u << DEPTH_KEY_BITS) - 1;
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
-    }
+struct ItemDepthKey {
+    uint32_t key;
+    uint32_t index; // into the input ItemBounds
 };
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
-    }
+struct ItemDepthKeyScanner {
+    typedef uint32_t state_type;
+    state_type initial_state() const { return 1u << (DEPTH_KEY_BITS - 1); }
+    bool advance(state_type& state) const { state >>= 1; return state != 0; }
+    bool bit(const ItemDepthKey& item, state_type state) const { return (item.key & state) != 0; }
 };
 
+uint32_t computeDepthKey(float distanceSquared, bool frontToBack) {
+    uint32_t bits;
+    memcpy(&bits, &distanceSquared, sizeof(uint32_t));
+    uint32_t key = (bits >> (31 - DEPTH_KEY_BITS)) & DEPTH_KEY_MASK;
+    // back to front is an ascending sort on the inverted key
+    return frontToBack ? key : (~key & DEPTH_KEY_MASK);
+}
+
+} // anonymous namespace
+
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
-
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
 
     // Allocate and simply copy
     outItems.clear();
     outItems.reserve(inItems.size());
 
-
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound(args);
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    // Make a compact local dataset of the quantized center distance
+    std::vector<ItemDepthKey> depthKeys;
+    depthKeys.reserve(inItems.size());
+    for (uint32_t i = 0; i < (uint32_t)inItems.size(); ++i) {
+        float distanceSquared = viewFrustum.distanceToCameraSquared(inItems[i].bound.calcCenter());
+        depthKeys.push_back({ computeDepthKey(distanceSquared, frontToBack), i });
     }
 
     // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
+    radix2InplaceSort(depthKeys.begin(), depthKeys.end(), ItemDepthKeyScanner());
 
     // Finally once sorted result to a list of itemID and keep uniques
     render::ItemID previousID = Item::INVALID_ITEM_ID;
     if (!bounds) {
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
+        for (const auto& depthKey : depthKeys) {
+            const ItemBound& item = inItems[depthKey.index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
             }
         }
-    } else if (!itemBoundSorts.empty()) {
+    } else if (!depthKeys.empty()) {
         if (bounds->isNull()) {
-            *bounds = itemBoundSorts.front()._bounds;
+            *bounds = inItems[depthKeys.front().index].bound;
         }
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
-                *bounds += item._bounds;
+        for (const auto& depthKey : depthKeys) {
+            const ItemBound& item = inItems[depthKey.index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
+                *bounds += item.bound;
             }
         }
     }
@@ -174,6 +174,15 @@ void ArrayBufferClass::fromScriptValue(const QScriptValue& object, QByteArray& b
         // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
         if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(object.data())) {
             byteArray = *buffer;
+        } else if (QByteArray* viewBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(BUFFER_PROPERTY_NAME).data())) {
+            // Typed array or DataView, which shares its buffer when it views all of it
+            qint32 byteOffset = object.data().property(BYTE_OFFSET_PROPERTY_NAME).toInt32();
+            qint32 byteLength = object.data().property(BYTE_LENGTH_PROPERTY_NAME).toInt32();
+            if (byteOffset == 0 && byteLength == viewBuffer->size()) {
+                byteArray = *viewBuffer;
+            } else {
+                byteArray = viewBuffer->mid(byteOffset, byteLength);
+            }
         }
     }
 }
@@ -28,6 +28,8 @@ class ArrayBufferClass : public QObject, public QScriptClass {
 public:
     ArrayBufferClass(ScriptEngine* scriptEngine);
     QScriptValue newInstance(qint32 size);
+    // Shares ba rather than copying it, as do QByteArrays converted to scripts. Scripts only copy the data when they
+    // first write to it while native code still holds it.
     QScriptValue newInstance(const QByteArray& ba);
 
     QueryFlags queryProperty(const QScriptValue& object,
@@ -14,6 +14,7 @@
 
 #include <QScriptClass>
 #include <QtCore/QObject>
+#include <QtCore/QtEndian>
 #include <QtScript/QScriptClass>
 #include <QtScript/QScriptContext>
 #include <QtScript/QScriptEngine>
@@ -26,6 +27,32 @@ static const QString BUFFER_PROPERTY_NAME = "buffer";
 static const QString BYTE_OFFSET_PROPERTY_NAME = "byteOffset";
 static const QString BYTE_LENGTH_PROPERTY_NAME = "byteLength";
 
+// Elements are read straight out of an ArrayBuffer, which never detaches it from the native data it may share, and
+// written in place, which only copies the buffer if it is still shared
+template<class T>
+bool readArrayBufferElement(const QByteArray* arrayBuffer, quint32 byteOffset, bool littleEndian, T& value) {
+    if (!arrayBuffer || (quint64)byteOffset + sizeof(T) > (quint64)arrayBuffer->size()) {
+        return false;
+    }
+    const char* source = arrayBuffer->constData() + byteOffset;
+    value = littleEndian ? qFromLittleEndian<T>(source) : qFromBigEndian<T>(source);
+    return true;
+}
+
+template<class T>
+bool writeArrayBufferElement(QByteArray* arrayBuffer, quint32 byteOffset, bool littleEndian, T value) {
+    if (!arrayBuffer || (quint64)byteOffset + sizeof(T) > (quint64)arrayBuffer->size()) {
+        return false;
+    }
+    char* destination = arrayBuffer->data() + byteOffset;
+    if (littleEndian) {
+        qToLittleEndian<T>(value, destination);
+    } else {
+        qToBigEndian<T>(value, destination);
+    }
+    return true;
+}
+
 class ArrayBufferViewClass : public QObject, public QScriptClass {
     Q_OBJECT
 public:
@@ -39,11 +39,8 @@ bool DataViewPrototype::realOffset(qint32& offset, size_t size) const {
 
 qint32 DataViewPrototype::getInt8(qint32 byteOffset) {
     if (realOffset(byteOffset, sizeof(qint8))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        
-        qint8 result;
-        stream >> result;
+        qint8 result { 0 };
+        readArrayBufferElement<qint8>(thisArrayBuffer(), byteOffset, true, result);
         return result;
     }
     thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
@@ -52,11 +49,8 @@ qint32 DataViewPrototype::getInt8(qint32 byteOffset) {
 
 quint32 DataViewPrototype::getUint8(qint32 byteOffset) {
     if (realOffset(byteOffset, sizeof(quint8))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        
-        quint8 result;
-        stream >> result;
+        quint8 result { 0 };
+        readArrayBufferElement<quint8>(thisArrayBuffer(), byteOffset, true, result);
         return result;
     }
     thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
@@ -65,12 +59,8 @@ quint32 DataViewPrototype::getUint8(qint32 byteOffset) {
 
 qint32 DataViewPrototype::getInt16(qint32 byteOffset, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(qint16))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        qint16 result;
-        stream >> result;
+        qint16 result { 0 };
+        readArrayBufferElement<qint16>(thisArrayBuffer(), byteOffset, littleEndian, result);
         return result;
     }
     thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
@@ -79,12 +69,8 @@ qint32 DataViewPrototype::getInt16(qint32 byteOffset, bool littleEndian) {
 
 quint32 DataViewPrototype::getUint16(qint32 byteOffset, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(quint16))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        quint16 result;
-        stream >> result;
+        quint16 result { 0 };
+        readArrayBufferElement<quint16>(thisArrayBuffer(), byteOffset, littleEndian, result);
         return result;
     }
     thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
@@ -93,12 +79,8 @@ quint32 DataViewPrototype::getUint16(qint32 byteOffset, bool littleEndian) {
 
 qint32 DataViewPrototype::getInt32(qint32 byteOffset, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(qint32))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        qint32 result;
-        stream >> result;
+        qint32 result { 0 };
+        readArrayBufferElement<qint32>(thisArrayBuffer(), byteOffset, littleEndian, result);
         return result;
     }
     thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
@@ -107,12 +89,8 @@ qint32 DataViewPrototype::getInt32(qint32 byteOffset, bool littleEndian) {
 
 quint32 DataViewPrototype::getUint32(qint32 byteOffset, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(quint32))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        quint32 result;
-        stream >> result;
+        quint32 result { 0 };
+        readArrayBufferElement<quint32>(thisArrayBuffer(), byteOffset, littleEndian, result);
         return result;
     }
     thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
@@ -121,13 +99,8 @@ quint32 DataViewPrototype::getUint32(qint32 byteOffset, bool littleEndian) {
 
 QScriptValue DataViewPrototype::getFloat32(qint32 byteOffset, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(float))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        float result;
-        stream >> result;
+        float result { 0 };
+        readArrayBufferElement<float>(thisArrayBuffer(), byteOffset, littleEndian, result);
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -140,13 +113,8 @@ QScriptValue DataViewPrototype::getFloat32(qint32 byteOffset, bool littleEndian)
 
 QScriptValue DataViewPrototype::getFloat64(qint32 byteOffset, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(double))) {
-        QDataStream stream(*thisArrayBuffer());
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        double result;
-        stream >> result;
+        double result { 0 };
+        readArrayBufferElement<double>(thisArrayBuffer(), byteOffset, littleEndian, result);
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -159,10 +127,7 @@ QScriptValue DataViewPrototype::getFloat64(qint32 byteOffset, bool littleEndian)
 
 void DataViewPrototype::setInt8(qint32 byteOffset, qint32 value) {
     if (realOffset(byteOffset, sizeof(qint8))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        
-        stream << (qint8)value;
+        writeArrayBufferElement<qint8>(thisArrayBuffer(), byteOffset, true, (qint8)value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -170,10 +135,7 @@ void DataViewPrototype::setInt8(qint32 byteOffset, qint32 value) {
 
 void DataViewPrototype::setUint8(qint32 byteOffset, quint32 value) {
     if (realOffset(byteOffset, sizeof(quint8))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        
-        stream << (quint8)value;
+        writeArrayBufferElement<quint8>(thisArrayBuffer(), byteOffset, true, (quint8)value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -181,11 +143,7 @@ void DataViewPrototype::setUint8(qint32 byteOffset, quint32 value) {
 
 void DataViewPrototype::setInt16(qint32 byteOffset, qint32 value, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(qint16))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        stream << (qint16)value;
+        writeArrayBufferElement<qint16>(thisArrayBuffer(), byteOffset, littleEndian, (qint16)value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -193,11 +151,7 @@ void DataViewPrototype::setInt16(qint32 byteOffset, qint32 value, bool littleEnd
 
 void DataViewPrototype::setUint16(qint32 byteOffset, quint32 value, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(quint16))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        stream << (quint16)value;
+        writeArrayBufferElement<quint16>(thisArrayBuffer(), byteOffset, littleEndian, (quint16)value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -205,11 +159,7 @@ void DataViewPrototype::setUint16(qint32 byteOffset, quint32 value, bool littleE
 
 void DataViewPrototype::setInt32(qint32 byteOffset, qint32 value, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(qint32))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        stream << (qint32)value;
+        writeArrayBufferElement<qint32>(thisArrayBuffer(), byteOffset, littleEndian, (qint32)value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -217,11 +167,7 @@ void DataViewPrototype::setInt32(qint32 byteOffset, qint32 value, bool littleEnd
 
 void DataViewPrototype::setUint32(qint32 byteOffset, quint32 value, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(quint32))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        
-        stream << (quint32)value;
+        writeArrayBufferElement<quint32>(thisArrayBuffer(), byteOffset, littleEndian, (quint32)value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -229,12 +175,7 @@ void DataViewPrototype::setUint32(qint32 byteOffset, quint32 value, bool littleE
 
 void DataViewPrototype::setFloat32(qint32 byteOffset, float value, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(float))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        stream << value;
+        writeArrayBufferElement<float>(thisArrayBuffer(), byteOffset, littleEndian, value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
@@ -242,12 +183,7 @@ void DataViewPrototype::setFloat32(qint32 byteOffset, float value, bool littleEn
 
 void DataViewPrototype::setFloat64(qint32 byteOffset, double value, bool littleEndian) {
     if (realOffset(byteOffset, sizeof(double))) {
-        QDataStream stream(thisArrayBuffer(), QIODevice::ReadWrite);
-        stream.skipRawData(byteOffset);
-        stream.setByteOrder((littleEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        stream << value;
+        writeArrayBufferElement<double>(thisArrayBuffer(), byteOffset, littleEndian, value);
     } else {
         thisObject().engine()->evaluate("throw \"RangeError: byteOffset out of range\"");
     }
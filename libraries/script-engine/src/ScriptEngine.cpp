@@ -225,11 +225,12 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
 {
+    _timerClock.start();
+
     switch (_context) {
         case Context::CLIENT_SCRIPT:
             _type = Type::CLIENT;
@@ -404,6 +405,8 @@ void ScriptEngine::runDebuggable() {
         }
         _lastUpdate = now;
 
+        processTimers();
+
         // only clear exceptions if we are not in the middle of evaluating
         if (!isEvaluating() && hasUncaughtException()) {
             qCWarning(scriptengine) << __FUNCTION__ << "---------- UNCAUGHT EXCEPTION --------";
@@ -1326,11 +1329,15 @@ void ScriptEngine::run() {
         // We don't want to actually sleep for too long, because it causes our scripts to hang
         // on shutdown and stop... so we want to loop and sleep until we've spent our time in
         // purgatory, constantly checking to see if our script was asked to end
+        //
+        // Script timers are run from here as they come due, so the wait is broken up to wake for each of them.
         bool processedEvents = false;
-        if (!_isFinished) {
+        while (!_isFinished) {
             PROFILE_RANGE(script, "processEvents-sleep");
             std::chrono::milliseconds sleepFor =
                 std::chrono::duration_cast<std::chrono::milliseconds>(sleepUntil - clock::now());
+            bool isFrameDue = sleepFor <= std::chrono::milliseconds(0);
+            sleepFor = std::min(sleepFor, std::chrono::milliseconds(getMSecsUntilNextTimer()));
             if (sleepFor > std::chrono::milliseconds(0)) {
                 QEventLoop loop;
                 QTimer timer;
@@ -1342,6 +1349,11 @@ void ScriptEngine::run() {
                 QCoreApplication::processEvents();
             }
             processedEvents = true;
+
+            processTimers();
+            if (isFrameDue) {
+                break;
+            }
         }
 
         PROFILE_RANGE(script, "ScriptMainLoop");
@@ -1447,29 +1459,27 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
+    QVector<ScriptTimers::TimerID> toDelete;
+    _timers.forEach([&](ScriptTimers::TimerID timer, const ScriptTimer&) {
+        toDelete << timer;
+    });
+    if (!toDelete.isEmpty()) {
+        qCDebug(scriptengine) << getFilename() << "stopAllTimers" << toDelete.size();
+    }
+    for (auto timer : toDelete) {
         stopTimer(timer);
     }
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
+     // We could maintain a separate map of entityID => timer, but someone will have to prove to me that it's worth the complexity. -HRS
+    QVector<ScriptTimers::TimerID> toDelete;
+    _timers.forEach([&](ScriptTimers::TimerID timer, const ScriptTimer& timerData) {
+        if (timerData.callback.definingEntityIdentifier == entityID) {
+            toDelete << timer; // don't delete while we're iterating. save it.
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
+    });
+    for (auto timer : toDelete) { // now reap 'em
         stopTimer(timer);
     }
 
@@ -1525,88 +1535,126 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+// Runs the timers that have come due, in the order they were due
+void ScriptEngine::processTimers() {
+    if (_timers.empty()) {
+        return;
+    }
+
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
-            scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
-            return; // bail early
+            return; // timers are ignored while shutting down
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    _expiredTimers.clear();
+    quint64 now = _timerClock.elapsed();
+    _timers.advance(now, _expiredTimers);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    for (const auto& expired : _expiredTimers) {
+        if (_isFinished) {
+            break;
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        // Timers can be cleared by the functions of timers that ran before them
+        ScriptTimer* timer = _timers.find(expired.id);
+        if (!timer) {
+            continue;
+        }
+
+        CallbackData timerData = timer->callback;
+        if (timer->isSingleShot) {
+            _timers.remove(expired.id);
+        } else {
+            // Keep to the interval, unless it has fallen a whole interval behind
+            quint64 nextExpiry = expired.expiry + timer->intervalMS;
+            if (nextExpiry <= now) {
+                nextExpiry = now + timer->intervalMS;
+            }
+            _timers.reschedule(expired.id, nextExpiry);
+        }
+
+        quint64 calledUsecs = (quint64)_timerClock.nsecsElapsed() / NSECS_PER_USEC;
+        quint64 dueUsecs = expired.expiry * USECS_PER_MSEC;
+        quint64 latencyUsecs = calledUsecs > dueUsecs ? calledUsecs - dueUsecs : 0;
+        _totalTimerLatencyUsecs += latencyUsecs;
+        if (latencyUsecs > _maxTimerLatencyUsecs) {
+            _maxTimerLatencyUsecs = latencyUsecs;
+        }
+        ++_timersFired;
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, "timerFired");
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
+    _activeTimerCount = (int)_timers.size();
 }
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+int ScriptEngine::getMSecsUntilNextTimer() const {
+    quint64 nextExpiry = _timers.nextExpiry();
+    quint64 now = _timerClock.elapsed();
+    if (nextExpiry <= now) {
+        return 0;
     }
+    return (int)std::min<quint64>(nextExpiry - now, std::numeric_limits<int>::max());
+}
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
-
+int ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    // add the timer to the wheel, it is run from our loop once it comes due
+    ScriptTimer timer;
+    timer.callback = { function, currentEntityIdentifier, currentSandboxURL };
+    timer.intervalMS = std::max(intervalMS, 0);
+    timer.isSingleShot = isSingleShot;
 
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    auto timerID = _timers.add(timer, _timerClock.elapsed() + timer.intervalMS);
+    _activeTimerCount = (int)_timers.size();
+    return timerID;
+}
 
-    newTimer->start(intervalMS);
-    return newTimer;
+QVariantMap ScriptEngine::getTimerStats() const {
+    QVariantMap stats;
+    quint64 timersFired = _timersFired;
+    stats["activeTimers"] = (int)_activeTimerCount;
+    stats["timersFired"] = (double)timersFired;
+    stats["averageLatency"] = timersFired > 0 ? (double)_totalTimerLatencyUsecs / timersFired / USECS_PER_MSEC : 0.0;
+    stats["maxLatency"] = (double)_maxTimerLatencyUsecs / USECS_PER_MSEC;
+    return stats;
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+int ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return ScriptTimers::INVALID_TIMER_ID; // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+int ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return ScriptTimers::INVALID_TIMER_ID; // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
-    } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+void ScriptEngine::stopTimer(int timer) {
+    if (_timers.remove(timer)) {
+        _activeTimerCount = (int)_timers.size();
+    } else if (timer != ScriptTimers::INVALID_TIMER_ID) {
+        qCDebug(scriptengine) << "stopTimer -- not a running timer" << timer;
     }
 }
 
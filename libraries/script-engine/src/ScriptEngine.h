@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -49,6 +50,7 @@
 #include "ConsoleScriptingInterface.h"
 #include "SettingHandle.h"
 #include "Profile.h"
+#include "TimerWheel.h"
 
 class QScriptEngineDebugger;
 
@@ -69,6 +71,16 @@ public:
     QUrl definingSandboxURL;
 };
 
+// A Script.setTimeout or Script.setInterval timer
+class ScriptTimer {
+public:
+    CallbackData callback;
+    int intervalMS { 0 };
+    bool isSingleShot { true };
+};
+
+using ScriptTimers = TimerWheel<ScriptTimer>;
+
 class DeferredLoadEntity {
 public:
     EntityItemID entityID;
@@ -470,31 +482,31 @@ public:
      * @function Script.setInterval
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} interval - The interval at which to call the function, in ms.
-     * @returns {object} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
+     * @returns {number} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
      * @example <caption>Print a message every second.</caption>
      * Script.setInterval(function () {
      *     print("Interval timer fired");
      * }, 1000);
     */
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE int setInterval(const QScriptValue& function, int intervalMS);
 
     /*@jsdoc
      * Calls a function once, after a delay.
      * @function Script.setTimeout
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} timeout - The delay after which to call the function, in ms.
-     * @returns {object} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
+     * @returns {number} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
      * @example <caption>Print a message once, after a second.</caption>
      * Script.setTimeout(function () {
      *     print("Timeout timer fired");
      * }, 1000);
      */
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE int setTimeout(const QScriptValue& function, int timeoutMS);
 
     /*@jsdoc
      * Stops an interval timer set by {@link Script.setInterval|setInterval}.
      * @function Script.clearInterval
-     * @param {object} timer - The interval timer to stop.
+     * @param {number} timer - The interval timer to stop.
      * @example <caption>Stop an interval timer.</caption>
      * // Print a message every second.
      * var timer = Script.setInterval(function () {
@@ -507,12 +519,12 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(int timer) { stopTimer(timer); }
 
     /*@jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
      * @function Script.clearTimeout
-     * @param {object} timer - The timeout timer to stop.
+     * @param {number} timer - The timeout timer to stop.
      * @example <caption>Stop a timeout timer.</caption>
      * // Print a message after two seconds.
      * var timer = Script.setTimeout(function () {
@@ -522,7 +534,24 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(int timer) { stopTimer(timer); }
+
+    /*@jsdoc
+     * Gets statistics on the script's timers.
+     * @function Script.getTimerStats
+     * @returns {Script.TimerStats} Statistics on the script's timers.
+     */
+    /*@jsdoc
+     * Statistics on the timers of a script.
+     * @typedef {object} Script.TimerStats
+     * @property {number} activeTimers - The number of timeout and interval timers that are set.
+     * @property {number} timersFired - The number of times timers have called their functions.
+     * @property {number} averageLatency - The average delay between when timers were due and when their functions were
+     *     called, in ms.
+     * @property {number} maxLatency - The longest delay between when a timer was due and when its function was called,
+     *     in ms.
+     */
+    Q_INVOKABLE QVariantMap getTimerStats() const;
 
     /*@jsdoc
      * Prints a message to the program log and emits {@link Script.printedMessage}.
@@ -936,7 +965,8 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void processTimers();
+    int getMSecsUntilNextTimer() const;
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -944,8 +974,8 @@ protected:
     void setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details);
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    int setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(int timer);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -975,7 +1005,11 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // Script timers are kept in a timer wheel with 1 ms ticks and run from the script's own loop, rather than each being
+    // a QTimer on the event loop
+    ScriptTimers _timers;
+    QElapsedTimer _timerClock;
+    std::vector<ScriptTimers::Expired> _expiredTimers;
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
@@ -1007,6 +1041,12 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    // Read from other threads for stats
+    std::atomic<int> _activeTimerCount { 0 };
+    std::atomic<quint64> _timersFired { 0 };
+    std::atomic<quint64> _totalTimerLatencyUsecs { 0 };
+    std::atomic<quint64> _maxTimerLatencyUsecs { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
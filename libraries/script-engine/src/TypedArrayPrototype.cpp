@@ -34,6 +34,10 @@ void TypedArrayPrototype::set(QScriptValue array, qint32 offset) {
             engine()->evaluate("throw \"ArgumentError: array does not fit\"");
             return;
         }
+        QScriptValue object = thisObject();
+        if (offset >= 0 && typedArray->copyElements(array, object, offset)) {
+            return;
+        }
         for (quint32 i = 0; i < length; ++i) {
             thisObject().setProperty(QString::number(offset + i), array.property(QString::number(i)));
         }
@@ -11,6 +11,8 @@
 
 #include "TypedArrays.h"
 
+#include <cstring>
+
 #include <glm/glm.hpp>
 
 #include "ScriptEngine.h"
@@ -50,6 +52,9 @@ QScriptValue TypedArray::newInstance(QScriptValue array) {
     if (array.property(ARRAY_LENGTH_HANDLE).isValid()) {
         quint32 length = array.property(ARRAY_LENGTH_HANDLE).toInt32();
         QScriptValue newArray = newInstance(length);
+        if (copyElements(array, newArray, 0)) {
+            return newArray;
+        }
         for (quint32 i = 0; i < length; ++i) {
             QScriptValue value = array.property(QString::number(i));
             setProperty(newArray, engine()->toStringHandle(QString::number(i)),
@@ -199,20 +204,43 @@ void TypedArray::setBytesPerElement(quint32 bytesPerElement) {
     _ctor.setProperty(_bytesPerElementName, _bytesPerElement);
 }
 
+bool TypedArray::copyElements(const QScriptValue& source, QScriptValue& destination, quint32 index) {
+    if (source.scriptClass() != this) {
+        return false;
+    }
+
+    QScriptValue sourceData = source.data();
+    QScriptValue destinationData = destination.data();
+    QByteArray* sourceBuffer = qscriptvalue_cast<QByteArray*>(sourceData.property(_bufferName).data());
+    QByteArray* destinationBuffer = qscriptvalue_cast<QByteArray*>(destinationData.property(_bufferName).data());
+    if (!sourceBuffer || !destinationBuffer) {
+        return false;
+    }
+
+    // Shared, so that if both are views of the same buffer the source is read as it was before the copy
+    const QByteArray sourceBytes = *sourceBuffer;
+    quint32 sourceOffset = sourceData.property(_byteOffsetName).toInt32();
+    quint32 byteLength = sourceData.property(_byteLengthName).toInt32();
+    quint32 destinationOffset = destinationData.property(_byteOffsetName).toInt32() + index * _bytesPerElement;
+    if ((quint64)sourceOffset + byteLength > (quint64)sourceBytes.size() ||
+        (quint64)destinationOffset + byteLength > (quint64)destinationBuffer->size()) {
+        return false;
+    }
+
+    if (byteLength > 0) {
+        memcpy(destinationBuffer->data() + destinationOffset, sourceBytes.constData() + sourceOffset, byteLength);
+    }
+    return true;
+}
+
 // templated helper functions
-// don't work for floats as they require single precision settings
 template<class T>
 QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString& name, uint id) {
     bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        
-        stream.setByteOrder(QDataStream::LittleEndian);
-        T result;
-        stream >> result;
+    T result;
+    if (ok && readArrayBufferElement<T>(arrayBuffer, id, true, result)) {
         return result;
     }
     return QScriptValue();
@@ -220,12 +248,8 @@ QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString&
 
 template<class T>
 void setPropertyHelper(QByteArray* arrayBuffer, const QScriptString& name, uint id, const QScriptValue& value) {
-    if (arrayBuffer && value.isNumber()) {
-        QDataStream stream(arrayBuffer, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        
-        stream << (T)value.toNumber();
+    if (value.isNumber()) {
+        writeArrayBufferElement<T>(arrayBuffer, id, true, (T)value.toNumber());
     }
 }
 
@@ -274,16 +298,16 @@ QScriptValue Uint8ClampedArrayClass::property(const QScriptValue& object, const
 void Uint8ClampedArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
+    if (value.isNumber()) {
+        quint8 clamped;
         if (value.toNumber() > 255) {
-            stream << (quint8)255;
+            clamped = 255;
         } else if (value.toNumber() < 0) {
-            stream << (quint8)0;
+            clamped = 0;
         } else {
-            stream << (quint8)glm::clamp(qRound(value.toNumber()), 0, 255);
+            clamped = (quint8)glm::clamp(qRound(value.toNumber()), 0, 255);
         }
+        writeArrayBufferElement<quint8>(ba, id, true, clamped);
     }
 }
 
@@ -357,17 +381,12 @@ Float32ArrayClass::Float32ArrayClass(ScriptEngine* scriptEngine) : TypedArray(sc
 }
 
 QScriptValue Float32ArrayClass::property(const QScriptValue& object, const QScriptString& name, uint id) {
-    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());bool ok = false;
+    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
+    bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        float result;
-        stream >> result;
+    float result;
+    if (ok && readArrayBufferElement<float>(arrayBuffer, id, true, result)) {
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -379,14 +398,7 @@ QScriptValue Float32ArrayClass::property(const QScriptValue& object, const QScri
 void Float32ArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        stream << (float)value.toNumber();
-    }
+    setPropertyHelper<float>(ba, name, id, value);
 }
 
 Float64ArrayClass::Float64ArrayClass(ScriptEngine* scriptEngine) : TypedArray(scriptEngine, FLOAT_64_ARRAY_CLASS_NAME) {
@@ -394,17 +406,12 @@ Float64ArrayClass::Float64ArrayClass(ScriptEngine* scriptEngine) : TypedArray(sc
 }
 
 QScriptValue Float64ArrayClass::property(const QScriptValue& object, const QScriptString& name, uint id) {
-    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());bool ok = false;
+    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
+    bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        double result;
-        stream >> result;
+    double result;
+    if (ok && readArrayBufferElement<double>(arrayBuffer, id, true, result)) {
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -416,13 +423,6 @@ QScriptValue Float64ArrayClass::property(const QScriptValue& object, const QScri
 void Float64ArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        stream << (double)value.toNumber();
-    }
+    setPropertyHelper<double>(ba, name, id, value);
 }
 
@@ -51,6 +51,9 @@ protected:
     static QScriptValue construct(QScriptContext* context, QScriptEngine* engine);
 
     void setBytesPerElement(quint32 bytesPerElement);
+    // Copies all of source, if it is an array of this type, into destination from index in one go, rather than an
+    // element at a time through their properties
+    bool copyElements(const QScriptValue& source, QScriptValue& destination, quint32 index);
 
     QScriptValue _proto;
     QScriptValue _ctor;
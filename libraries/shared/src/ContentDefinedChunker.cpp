@@ -0,0 +1,51 @@
+//
+//  ContentDefinedChunker.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentDefinedChunker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+static const uint64_t CHUNK_BOUNDARY_MASK = 0xFFFF000000000000ULL; // about 64 KB past the minimum on average
+
+static const std::array<uint64_t, 256>& chunkGearTable() {
+    // Generated rather than random so that the chunks are the same from run to run
+    static const std::array<uint64_t, 256> table = [] {
+        std::array<uint64_t, 256> values;
+        uint64_t state = 0;
+        for (auto& value : values) {
+            state += 0x9E3779B97F4A7C15ULL;
+            uint64_t mixed = state;
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+            value = mixed ^ (mixed >> 31);
+        }
+        return values;
+    }();
+    return table;
+}
+
+int ContentDefinedChunker::nextChunkLength(const char* data, int length) {
+    if (length <= MIN_CHUNK_SIZE) {
+        return length;
+    }
+
+    const auto& gear = chunkGearTable();
+    int end = std::min(length, MAX_CHUNK_SIZE);
+    uint64_t hash = 0;
+    for (int i = MIN_CHUNK_SIZE; i < end; ++i) {
+        hash = (hash << 1) + gear[(uint8_t)data[i]];
+        if ((hash & CHUNK_BOUNDARY_MASK) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
@@ -0,0 +1,29 @@
+//
+//  ContentDefinedChunker.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContentDefinedChunker_h
+#define hifi_ContentDefinedChunker_h
+
+// Splits data into chunks whose boundaries are placed where a rolling (gear) hash of the preceding bytes matches a
+// pattern rather than at fixed offsets, so that an edit only changes the chunks around it and the boundaries after it
+// line up with those of the unedited data.
+namespace ContentDefinedChunker {
+
+const int MIN_CHUNK_SIZE = 16 * 1024;
+const int MAX_CHUNK_SIZE = 256 * 1024;
+
+// Returns the length of the chunk starting at data, given the length of the data left.  Chunks are between
+// MIN_CHUNK_SIZE and MAX_CHUNK_SIZE long, with boundaries about every 64 KB past the minimum; only the last chunk of
+// the data can be shorter.
+int nextChunkLength(const char* data, int length);
+
+}
+
+#endif // hifi_ContentDefinedChunker_h
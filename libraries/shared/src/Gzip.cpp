@@ -153,3 +153,112 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+const int ZLIB_SIZE_HEADER_BYTES = 4;
+const int ZLIB_WINDOW_BITS = 15;
+const int MAX_ZLIB_UNCOMPRESSED_SIZE = 64 * 1024 * 1024;
+
+struct ZlibCompressor::Stream {
+    z_stream strm;
+    bool initialized { false };
+    int compressionLevel;
+};
+
+ZlibCompressor::ZlibCompressor(int compressionLevel, const QByteArray& dictionary) :
+    _stream(new Stream()),
+    _dictionary(dictionary)
+{
+    _stream->compressionLevel = compressionLevel;
+}
+
+ZlibCompressor::~ZlibCompressor() {
+    if (_stream->initialized) {
+        deflateEnd(&_stream->strm);
+    }
+}
+
+int ZlibCompressor::compress(const unsigned char* source, int sourceLength, unsigned char* destination,
+                             int destinationCapacity) {
+    if (sourceLength < 0 || destinationCapacity <= ZLIB_SIZE_HEADER_BYTES) {
+        return -1;
+    }
+
+    z_stream& strm = _stream->strm;
+    if (!_stream->initialized) {
+        strm.zalloc = Z_NULL;
+        strm.zfree = Z_NULL;
+        strm.opaque = Z_NULL;
+        if (deflateInit2(&strm, _stream->compressionLevel, Z_DEFLATED, ZLIB_WINDOW_BITS,
+                         DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return -1;
+        }
+        _stream->initialized = true;
+    } else if (deflateReset(&strm) != Z_OK) {
+        return -1;
+    }
+
+    if (!_dictionary.isEmpty() &&
+        deflateSetDictionary(&strm, (const Bytef*)_dictionary.constData(), (uInt)_dictionary.size()) != Z_OK) {
+        return -1;
+    }
+
+    strm.next_in = (Bytef*)source;
+    strm.avail_in = (uInt)sourceLength;
+    strm.next_out = destination + ZLIB_SIZE_HEADER_BYTES;
+    strm.avail_out = (uInt)(destinationCapacity - ZLIB_SIZE_HEADER_BYTES);
+
+    if (deflate(&strm, Z_FINISH) != Z_STREAM_END) {
+        return -1;
+    }
+
+    destination[0] = (unsigned char)((sourceLength >> 24) & 0xff);
+    destination[1] = (unsigned char)((sourceLength >> 16) & 0xff);
+    destination[2] = (unsigned char)((sourceLength >> 8) & 0xff);
+    destination[3] = (unsigned char)(sourceLength & 0xff);
+    return ZLIB_SIZE_HEADER_BYTES + (int)strm.total_out;
+}
+
+bool zlibUncompress(const unsigned char* source, int sourceLength, QByteArray& destination, const QByteArray& dictionary) {
+    destination.clear();
+    if (!source || sourceLength <= ZLIB_SIZE_HEADER_BYTES) {
+        return false;
+    }
+
+    quint32 expectedSize = ((quint32)source[0] << 24) | ((quint32)source[1] << 16) |
+        ((quint32)source[2] << 8) | (quint32)source[3];
+    if (expectedSize > (quint32)MAX_ZLIB_UNCOMPRESSED_SIZE) {
+        return false;
+    }
+    destination.resize((int)expectedSize);
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (Bytef*)(source + ZLIB_SIZE_HEADER_BYTES);
+    strm.avail_in = (uInt)(sourceLength - ZLIB_SIZE_HEADER_BYTES);
+
+    if (inflateInit2(&strm, ZLIB_WINDOW_BITS) != Z_OK) {
+        destination.clear();
+        return false;
+    }
+
+    // zlib wants at least one byte of output space to make progress, even for an empty payload
+    Bytef emptyOutput;
+    strm.next_out = expectedSize > 0 ? (Bytef*)destination.data() : &emptyOutput;
+    strm.avail_out = expectedSize > 0 ? (uInt)expectedSize : 1;
+
+    int status = inflate(&strm, Z_FINISH);
+    if (status == Z_NEED_DICT && !dictionary.isEmpty()) {
+        if (inflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), (uInt)dictionary.size()) == Z_OK) {
+            status = inflate(&strm, Z_FINISH);
+        }
+    }
+
+    bool success = status == Z_STREAM_END && strm.total_out == expectedSize;
+    inflateEnd(&strm);
+    if (!success) {
+        destination.clear();
+    }
+    return success;
+}
@@ -12,6 +12,8 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <memory>
+
 #include <QByteArray>
 
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
@@ -24,4 +26,26 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// Compresses many small buffers through one reusable zlib stream, optionally primed with a preset dictionary, so the
+// per-call cost is a deflateReset instead of a full deflateInit/deflateEnd. The output uses the qCompress framing: the
+// uncompressed size as 4 big-endian bytes followed by a zlib stream. It is not thread safe; use one per thread.
+class ZlibCompressor {
+public:
+    ZlibCompressor(int compressionLevel, const QByteArray& dictionary = QByteArray());
+    ~ZlibCompressor();
+
+    // returns the number of bytes written to destination, or -1 if the result did not fit in destinationCapacity
+    int compress(const unsigned char* source, int sourceLength, unsigned char* destination, int destinationCapacity);
+
+private:
+    struct Stream;
+    std::unique_ptr<Stream> _stream;
+    QByteArray _dictionary;
+};
+
+// Reads the output of ZlibCompressor, and of qCompress, into destination. The dictionary is only used when the stream
+// asks for one.
+bool zlibUncompress(const unsigned char* source, int sourceLength, QByteArray& destination,
+                    const QByteArray& dictionary = QByteArray());
+
 #endif
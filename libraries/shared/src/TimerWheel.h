@@ -0,0 +1,243 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// A hierarchical timer wheel holding many timers for a single thread.  Timers are added, rescheduled and removed in
+// constant time and expire in batches when the owner advances the wheel.  Times are in ticks, whose length is up to
+// the owner, and must not go backwards.
+//
+// Each level has 64 slots, each slot covering 64 times as many ticks as a slot of the level below it.  Timers are
+// kept in the lowest level whose range covers them, and move down a level whenever the level below wraps around, so
+// that by the time a timer expires it is in the slot of the lowest level for its exact tick.  Timers further away
+// than the top level covers (about 4.6 hours of 1 ms ticks) sit in its last slot and are placed again when it comes
+// round.
+template <typename T>
+class TimerWheel {
+public:
+    using TimerID = int;
+    static const TimerID INVALID_TIMER_ID = 0;
+
+    struct Expired {
+        TimerID id;
+        uint64_t expiry;
+    };
+
+    explicit TimerWheel(uint64_t currentTick = 0) : _currentTick(currentTick) {}
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Timers due at or before the current tick expire on the next one
+    TimerID add(T value, uint64_t expiry) {
+        do {
+            _nextID = (_nextID == std::numeric_limits<TimerID>::max()) ? 1 : _nextID + 1;
+        } while (_entries.find(_nextID) != _entries.end());
+
+        auto& entry = _entries[_nextID];
+        entry.id = _nextID;
+        entry.value = std::move(value);
+        link(entry, expiry);
+        return entry.id;
+    }
+
+    // Also puts back timers that have expired and not yet been removed, to make intervals
+    bool reschedule(TimerID id, uint64_t expiry) {
+        auto itr = _entries.find(id);
+        if (itr == _entries.end()) {
+            return false;
+        }
+        unlink(itr->second);
+        link(itr->second, expiry);
+        return true;
+    }
+
+    bool remove(TimerID id) {
+        auto itr = _entries.find(id);
+        if (itr == _entries.end()) {
+            return false;
+        }
+        unlink(itr->second);
+        _entries.erase(itr);
+        return true;
+    }
+
+    T* find(TimerID id) {
+        auto itr = _entries.find(id);
+        return itr != _entries.end() ? &itr->second.value : nullptr;
+    }
+
+    // Moves the wheel up to tick, appending the timers that expire on the way in order of expiry.  Expired timers are
+    // no longer scheduled but are kept until they are removed or rescheduled.
+    void advance(uint64_t tick, std::vector<Expired>& expired) {
+        while (_currentTick < tick) {
+            if (_scheduledCount == 0) {
+                _currentTick = tick;
+                break;
+            }
+            if (_occupiedSlots[0] == 0) {
+                // Nothing can expire before the bottom level wraps around and the next level moves down
+                _currentTick = std::min(tick, _currentTick | SLOT_MASK);
+                if (_currentTick == tick) {
+                    break;
+                }
+            }
+
+            ++_currentTick;
+            cascade();
+
+            int slot = (int)(_currentTick & SLOT_MASK);
+            Entry* entry = _heads[0][slot];
+            while (entry) {
+                Entry* next = entry->next;
+                unlink(*entry);
+                expired.push_back({ entry->id, entry->expiry });
+                entry = next;
+            }
+        }
+    }
+
+    // The earliest tick at which advancing might expire a timer, or the maximum tick if none are scheduled
+    uint64_t nextExpiry() const {
+        if (_scheduledCount == 0) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        // Timers in the upper levels can't expire before the bottom level next wraps around
+        uint64_t nextWrap = (_currentTick | SLOT_MASK) + 1;
+        if (_occupiedSlots[0] != 0) {
+            for (uint64_t tick = _currentTick + 1; tick < nextWrap; ++tick) {
+                if (_occupiedSlots[0] & (1ULL << (tick & SLOT_MASK))) {
+                    return tick;
+                }
+            }
+        }
+        return nextWrap;
+    }
+
+    template <typename F>
+    void forEach(F function) const {
+        for (const auto& itr : _entries) {
+            function(itr.first, itr.second.value);
+        }
+    }
+
+    uint64_t getCurrentTick() const { return _currentTick; }
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const uint64_t SLOT_MASK = SLOTS - 1;
+    static const int LEVELS = 4;
+
+    struct Entry {
+        TimerID id { INVALID_TIMER_ID };
+        T value;
+        uint64_t expiry { 0 };
+        Entry* previous { nullptr };
+        Entry* next { nullptr };
+        int level { -1 }; // -1 when not scheduled
+        int slot { 0 };
+    };
+
+    void link(Entry& entry, uint64_t expiry) {
+        entry.expiry = std::max(expiry, _currentTick + 1);
+        place(entry);
+        ++_scheduledCount;
+    }
+
+    void place(Entry& entry) {
+        uint64_t delta = entry.expiry - _currentTick;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1ULL << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        uint64_t slotTick = entry.expiry;
+        if (delta >= (1ULL << (SLOT_BITS * LEVELS))) {
+            slotTick = _currentTick + (1ULL << (SLOT_BITS * LEVELS)) - 1;
+        }
+        int slot = (int)((slotTick >> (SLOT_BITS * level)) & SLOT_MASK);
+
+        // Appended, so that timers due on the same tick mostly expire in the order they were scheduled
+        entry.level = level;
+        entry.slot = slot;
+        entry.previous = _tails[level][slot];
+        entry.next = nullptr;
+        if (entry.previous) {
+            entry.previous->next = &entry;
+        } else {
+            _heads[level][slot] = &entry;
+        }
+        _tails[level][slot] = &entry;
+        _occupiedSlots[level] |= (1ULL << slot);
+    }
+
+    void unlink(Entry& entry) {
+        if (entry.level < 0) {
+            return;
+        }
+        if (entry.previous) {
+            entry.previous->next = entry.next;
+        } else {
+            _heads[entry.level][entry.slot] = entry.next;
+        }
+        if (entry.next) {
+            entry.next->previous = entry.previous;
+        } else {
+            _tails[entry.level][entry.slot] = entry.previous;
+        }
+        if (!_heads[entry.level][entry.slot]) {
+            _occupiedSlots[entry.level] &= ~(1ULL << entry.slot);
+        }
+        entry.previous = nullptr;
+        entry.next = nullptr;
+        entry.level = -1;
+        --_scheduledCount;
+    }
+
+    // Moves the timers of each upper level slot that has come round down into the levels below, from the top down so
+    // that timers moving more than one level end up in the right place
+    void cascade() {
+        int topLevel = 0;
+        while (topLevel < LEVELS - 1 && (_currentTick & ((1ULL << (SLOT_BITS * (topLevel + 1))) - 1)) == 0) {
+            ++topLevel;
+        }
+        for (int level = topLevel; level > 0; --level) {
+            int slot = (int)((_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+            Entry* entry = _heads[level][slot];
+            _heads[level][slot] = nullptr;
+            _tails[level][slot] = nullptr;
+            _occupiedSlots[level] &= ~(1ULL << slot);
+            while (entry) {
+                Entry* next = entry->next;
+                place(*entry);
+                entry = next;
+            }
+        }
+    }
+
+    // Entries are never moved once inserted, so the slot lists can point straight at them
+    std::unordered_map<TimerID, Entry> _entries;
+    Entry* _heads[LEVELS][SLOTS] {};
+    Entry* _tails[LEVELS][SLOTS] {};
+    uint64_t _occupiedSlots[LEVELS] {};
+    uint64_t _currentTick;
+    size_t _scheduledCount { 0 };
+    TimerID _nextID { INVALID_TIMER_ID };
+};
+
+#endif // hifi_TimerWheel_h
@@ -13,7 +13,223 @@
 
 #include "GLMHelpers.h"
 
-#include <list>
+#include <algorithm>
+#include <thread>
+
+// leaves are a single TrianglePacket
+static const uint32_t MAX_LEAF_TRIANGLES = 4;
+// number of buckets each axis is split into when looking for the cheapest split
+static const int SAH_BINS = 12;
+// past this depth nodes are split at the median, which bounds the depth of the tree, and so the traversal stack
+static const int MAX_SAH_DEPTH = 48;
+static const int MAX_TRAVERSAL_DEPTH = 96;
+// big subtrees near the root are built on their own threads
+static const uint32_t MIN_PARALLEL_BUILD_TRIANGLES = 8192;
+static const int MAX_PARALLEL_BUILD_DEPTH = 3;
+
+class TriangleSet::Builder {
+public:
+    Builder(const std::vector<Triangle>& triangles);
+
+    void build(std::vector<Node>& nodes, std::vector<TrianglePacket>& packets);
+
+private:
+    struct Bounds {
+        glm::vec3 minimum { FLT_MAX };
+        glm::vec3 maximum { -FLT_MAX };
+
+        void grow(const glm::vec3& point) { minimum = glm::min(minimum, point); maximum = glm::max(maximum, point); }
+        void grow(const Bounds& other) { minimum = glm::min(minimum, other.minimum); maximum = glm::max(maximum, other.maximum); }
+        float halfArea() const {
+            glm::vec3 extent = maximum - minimum;
+            return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+        }
+    };
+
+    void buildNode(uint32_t begin, uint32_t end, int depth, std::vector<Node>& nodes);
+    uint32_t split(uint32_t begin, uint32_t end, int depth, const Bounds& centroidBounds);
+
+    const std::vector<Triangle>& _triangles;
+    std::vector<Bounds> _triangleBounds;
+    std::vector<glm::vec3> _centroids;
+    std::vector<uint32_t> _order;
+};
+
+TriangleSet::Builder::Builder(const std::vector<Triangle>& triangles) :
+    _triangles(triangles),
+    _triangleBounds(triangles.size()),
+    _centroids(triangles.size()),
+    _order(triangles.size())
+{
+    for (size_t i = 0; i < triangles.size(); i++) {
+        const Triangle& triangle = triangles[i];
+        Bounds& bounds = _triangleBounds[i];
+        bounds.grow(triangle.v0);
+        bounds.grow(triangle.v1);
+        bounds.grow(triangle.v2);
+        _centroids[i] = 0.5f * (bounds.minimum + bounds.maximum);
+        _order[i] = (uint32_t)i;
+    }
+}
+
+void TriangleSet::Builder::build(std::vector<Node>& nodes, std::vector<TrianglePacket>& packets) {
+    nodes.clear();
+    packets.clear();
+    if (_triangles.empty()) {
+        return;
+    }
+
+    nodes.reserve(2 * (_triangles.size() / MAX_LEAF_TRIANGLES + 1));
+    buildNode(0, (uint32_t)_order.size(), 0, nodes);
+    nodes.shrink_to_fit();
+
+    // pack the triangles of each leaf, in tree order, and point the leaf at its packet
+    packets.reserve(_triangles.size() / MAX_LEAF_TRIANGLES + 1);
+    for (auto& node : nodes) {
+        if (!node.isLeaf()) {
+            continue;
+        }
+        TrianglePacket packet {};
+        for (uint32_t lane = 0; lane < node.count; lane++) {
+            uint32_t triangleIndex = _order[node.offset + lane];
+            const Triangle& triangle = _triangles[triangleIndex];
+            glm::vec3 edge1 = triangle.v1 - triangle.v0;
+            glm::vec3 edge2 = triangle.v2 - triangle.v0;
+            for (int axis = 0; axis < 3; axis++) {
+                packet.v0[axis][lane] = triangle.v0[axis];
+                packet.edge1[axis][lane] = edge1[axis];
+                packet.edge2[axis][lane] = edge2[axis];
+            }
+            packet.triangleIndices[lane] = triangleIndex;
+        }
+        node.offset = (uint32_t)packets.size();
+        packets.push_back(packet);
+    }
+}
+
+void TriangleSet::Builder::buildNode(uint32_t begin, uint32_t end, int depth, std::vector<Node>& nodes) {
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (uint32_t i = begin; i < end; i++) {
+        bounds.grow(_triangleBounds[_order[i]]);
+        centroidBounds.grow(_centroids[_order[i]]);
+    }
+
+    uint32_t nodeIndex = (uint32_t)nodes.size();
+    nodes.emplace_back();
+    nodes[nodeIndex].minimum = bounds.minimum;
+    nodes[nodeIndex].maximum = bounds.maximum;
+
+    uint32_t count = end - begin;
+    if (count <= MAX_LEAF_TRIANGLES) {
+        // the leaf points into _order until build() packs it
+        nodes[nodeIndex].offset = begin;
+        nodes[nodeIndex].count = count;
+        return;
+    }
+
+    uint32_t middle = split(begin, end, depth, centroidBounds);
+
+    // the first child always follows its parent, the second is wherever the first one's subtree ends
+    if (count >= MIN_PARALLEL_BUILD_TRIANGLES && depth < MAX_PARALLEL_BUILD_DEPTH) {
+        std::vector<Node> secondNodes;
+        std::thread secondThread([&] {
+            buildNode(middle, end, depth + 1, secondNodes);
+        });
+        buildNode(begin, middle, depth + 1, nodes);
+        secondThread.join();
+
+        uint32_t secondIndex = (uint32_t)nodes.size();
+        for (auto node : secondNodes) {
+            if (!node.isLeaf()) {
+                node.offset += secondIndex;
+            }
+            nodes.push_back(node);
+        }
+        nodes[nodeIndex].offset = secondIndex;
+    } else {
+        buildNode(begin, middle, depth + 1, nodes);
+        nodes[nodeIndex].offset = (uint32_t)nodes.size();
+        buildNode(middle, end, depth + 1, nodes);
+    }
+}
+
+uint32_t TriangleSet::Builder::split(uint32_t begin, uint32_t end, int depth, const Bounds& centroidBounds) {
+    glm::vec3 centroidExtent = centroidBounds.maximum - centroidBounds.minimum;
+
+    if (depth < MAX_SAH_DEPTH) {
+        // binned surface area heuristic: the cost of a split is the area of each side times the triangles in it
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        int bestBin = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            if (centroidExtent[axis] <= 0.0f) {
+                continue;
+            }
+            float binScale = SAH_BINS / centroidExtent[axis];
+
+            Bounds binBounds[SAH_BINS];
+            uint32_t binCounts[SAH_BINS] = { 0 };
+            for (uint32_t i = begin; i < end; i++) {
+                uint32_t triangleIndex = _order[i];
+                int bin = std::min(SAH_BINS - 1, (int)((_centroids[triangleIndex][axis] - centroidBounds.minimum[axis]) * binScale));
+                binCounts[bin]++;
+                binBounds[bin].grow(_triangleBounds[triangleIndex]);
+            }
+
+            float rightCosts[SAH_BINS];
+            Bounds rightBounds;
+            uint32_t rightCount = 0;
+            for (int bin = SAH_BINS - 1; bin > 0; bin--) {
+                rightBounds.grow(binBounds[bin]);
+                rightCount += binCounts[bin];
+                rightCosts[bin] = rightCount > 0 ? rightCount * rightBounds.halfArea() : 0.0f;
+            }
+
+            Bounds leftBounds;
+            uint32_t leftCount = 0;
+            for (int bin = 1; bin < SAH_BINS; bin++) {
+                leftBounds.grow(binBounds[bin - 1]);
+                leftCount += binCounts[bin - 1];
+                if (leftCount == 0 || leftCount == end - begin) {
+                    continue;
+                }
+                float cost = leftCount * leftBounds.halfArea() + rightCosts[bin];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        if (bestAxis >= 0) {
+            float binScale = SAH_BINS / centroidExtent[bestAxis];
+            float minimum = centroidBounds.minimum[bestAxis];
+            auto middle = std::partition(_order.begin() + begin, _order.begin() + end, [&](uint32_t triangleIndex) {
+                return std::min(SAH_BINS - 1, (int)((_centroids[triangleIndex][bestAxis] - minimum) * binScale)) < bestBin;
+            });
+            uint32_t middleIndex = (uint32_t)(middle - _order.begin());
+            if (middleIndex > begin && middleIndex < end) {
+                return middleIndex;
+            }
+        }
+    }
+
+    // everything is in one place, or the tree is getting deep: split in half along the longest axis
+    int axis = 0;
+    if (centroidExtent.y > centroidExtent[axis]) {
+        axis = 1;
+    }
+    if (centroidExtent.z > centroidExtent[axis]) {
+        axis = 2;
+    }
+    uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(_order.begin() + begin, _order.begin() + middle, _order.begin() + end, [&](uint32_t left, uint32_t right) {
+        return _centroids[left][axis] < _centroids[right][axis];
+    });
+    return middle;
+}
 
 void TriangleSet::insert(const Triangle& t) {
     _isBalanced = false;
@@ -29,7 +245,8 @@ void TriangleSet::clear() {
     _bounds.clear();
     _isBalanced = false;
 
-    _triangleTree.clear();
+    _nodes.clear();
+    _packets.clear();
 }
 
 bool TriangleSet::convexHullContains(const glm::vec3& point) const {
@@ -52,18 +269,13 @@ bool TriangleSet::convexHullContains(const glm::vec3& point) const {
 void TriangleSet::debugDump() {
     qDebug() << __FUNCTION__;
     qDebug() << "bounds:" << getBounds();
-    qDebug() << "triangles:" << size() << "at top level....";
-    qDebug() << "----- _triangleTree -----";
-    _triangleTree.debugDump();
+    qDebug() << "triangles:" << size() << "nodes:" << _nodes.size() << "leaves:" << _packets.size();
+    qDebug() << "memory:" << (_triangles.capacity() * sizeof(Triangle) + _nodes.capacity() * sizeof(Node) +
+                              _packets.capacity() * sizeof(TrianglePacket)) << "bytes";
 }
 
 void TriangleSet::balanceTree() {
-    _triangleTree.reset(_bounds);
-
-    // insert all the triangles
-    for (size_t i = 0; i < _triangles.size(); i++) {
-        _triangleTree.insert(i);
-    }
+    Builder(_triangles).build(_nodes, _packets);
 
     _isBalanced = true;
 
@@ -72,255 +284,208 @@ void TriangleSet::balanceTree() {
 #endif
 }
 
-// With an octree: 8 ^ MAX_DEPTH = 4096 leaves
-//static const int MAX_DEPTH = 4;
-// With a k-d tree: 2 ^ MAX_DEPTH = 4096 leaves
-static const int MAX_DEPTH = 12;
-
-TriangleSet::TriangleTreeCell::TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth) :
-    _allTriangles(allTriangles)
-{
-    reset(bounds, depth);
-}
-
-void TriangleSet::TriangleTreeCell::clear() {
-    _population = 0;
-    _triangleIndices.clear();
-    _bounds.clear();
-    _children.first.reset();
-    _children.second.reset();
+static bool findRayNodeIntersection(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& origin,
+                                    const glm::vec3& invDirection, float maxDistance, float& distance) {
+    glm::vec3 t0 = (minimum - origin) * invDirection;
+    glm::vec3 t1 = (maximum - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    distance = enter;
+    return enter <= exit;
 }
 
-void TriangleSet::TriangleTreeCell::reset(const AABox& bounds, int depth) {
-    clear();
-    _bounds = bounds;
-    _depth = depth;
+static bool findParabolaNodeIntersection(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& origin,
+                                         const glm::vec3& velocity, const glm::vec3& acceleration, float& parabolicDistance) {
+    AABox box(minimum, maximum - minimum);
+    if (box.contains(origin)) {
+        parabolicDistance = 0.0f;
+        return true;
+    }
+    BoxFace face;
+    glm::vec3 surfaceNormal;
+    return box.findParabolaIntersection(origin, velocity, acceleration, parabolicDistance, face, surfaceNormal);
 }
 
-void TriangleSet::TriangleTreeCell::debugDump() {
-    qDebug() << __FUNCTION__;
-    qDebug() << "               bounds:" << getBounds();
-    qDebug() << "                depth:" << _depth;
-    qDebug() << "           population:" << _population << "this level or below"
-             << " ---- triangleIndices:" << _triangleIndices.size() << "in this cell";
-
-    int numChildren = 0;
-    if (_children.first) {
-        numChildren++;
-    } else if (_children.second) {
-        numChildren++;
+bool TriangleSet::findRayPacketIntersection(const TrianglePacket& packet, const glm::vec3& origin, const glm::vec3& direction,
+                                            bool allowBackface, float& distance, int& lane) {
+    // this is findRayTriangleIntersection() for four triangles at once
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    const __m128 ZERO = _mm_setzero_ps();
+    const __m128 ONE = _mm_set1_ps(1.0f);
+    const __m128 EPSILONS = _mm_set1_ps(EPSILON);
+
+    __m128 dx = _mm_set1_ps(direction.x);
+    __m128 dy = _mm_set1_ps(direction.y);
+    __m128 dz = _mm_set1_ps(direction.z);
+    __m128 e1x = _mm_loadu_ps(packet.edge1[0]);
+    __m128 e1y = _mm_loadu_ps(packet.edge1[1]);
+    __m128 e1z = _mm_loadu_ps(packet.edge1[2]);
+    __m128 e2x = _mm_loadu_ps(packet.edge2[0]);
+    __m128 e2y = _mm_loadu_ps(packet.edge2[1]);
+    __m128 e2z = _mm_loadu_ps(packet.edge2[2]);
+
+    // P = cross(direction, edge2)
+    __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+    __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+    __m128 valid = allowBackface ? _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), det), EPSILONS) : _mm_cmpge_ps(det, EPSILONS);
+    if (_mm_movemask_ps(valid) == 0) {
+        return false;
     }
-    qDebug() << "child cells:" << numChildren;
-    if (_depth < MAX_DEPTH) {
-        if (_children.first) {
-            qDebug() << "child: 0";
-            _children.first->debugDump();
-        }
-        if (_children.second) {
-            qDebug() << "child: 1";
-            _children.second->debugDump();
-        }
+    __m128 invDet = _mm_div_ps(ONE, det);
+
+    // T = origin - v0
+    __m128 tx = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_loadu_ps(packet.v0[0]));
+    __m128 ty = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_loadu_ps(packet.v0[1]));
+    __m128 tz = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_loadu_ps(packet.v0[2]));
+    __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, ZERO), _mm_cmple_ps(u, ONE)));
+
+    // Q = cross(T, edge1)
+    __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+    __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+    __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+    __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, ZERO), _mm_cmple_ps(_mm_add_ps(u, v), ONE)));
+
+    __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(t, EPSILONS), _mm_cmplt_ps(t, _mm_set1_ps(distance))));
+
+    int hits = _mm_movemask_ps(valid);
+    if (hits == 0) {
+        return false;
     }
-}
-
-std::pair<AABox, AABox> TriangleSet::TriangleTreeCell::getTriangleTreeCellChildBounds() {
-    std::pair<AABox, AABox> toReturn;
-    int axis = 0;
-    // find biggest axis
-    glm::vec3 dimensions = _bounds.getDimensions();
-    for (int i = 0; i < 3; i++) {
-        if (dimensions[i] >= dimensions[(i + 1) % 3] && dimensions[i] >= dimensions[(i + 2) % 3]) {
-            axis = i;
-            break;
+    float distances[4];
+    _mm_storeu_ps(distances, t);
+    for (int i = 0; i < 4; i++) {
+        if ((hits & (1 << i)) && distances[i] < distance) {
+            distance = distances[i];
+            lane = i;
         }
     }
-
-    // The new boxes are half the size in the largest dimension
-    glm::vec3 newDimensions = dimensions;
-    newDimensions[axis] *= 0.5f;
-    toReturn.first.setBox(_bounds.getCorner(), newDimensions);
-    glm::vec3 offset = glm::vec3(0.0f);
-    offset[axis] = newDimensions[axis];
-    toReturn.second.setBox(_bounds.getCorner() + offset, newDimensions);
-    return toReturn;
-}
-
-void TriangleSet::TriangleTreeCell::insert(size_t triangleIndex) {
-    _population++;
-
-    // if we're not yet at the max depth, then check which child the triangle fits in
-    if (_depth < MAX_DEPTH) {
-        const Triangle& triangle = _allTriangles[triangleIndex];
-        auto childBounds = getTriangleTreeCellChildBounds();
-
-        auto insertOperator = [&](const AABox& childBound, std::shared_ptr<TriangleTreeCell>& child) {
-            // if the child AABox would contain the triangle...
-            if (childBound.contains(triangle)) {
-                // if the child cell doesn't yet exist, create it...
-                if (!child) {
-                    child = std::make_shared<TriangleTreeCell>(_allTriangles, childBound, _depth + 1);
-                }
-
-                // insert the triangleIndex in the child cell
-                child->insert(triangleIndex);
-                return true;
-            }
-            return false;
-        };
-        if (insertOperator(childBounds.first, _children.first) || insertOperator(childBounds.second, _children.second)) {
-            return;
+    return true;
+#else
+    bool hit = false;
+    for (int i = 0; i < 4; i++) {
+        glm::vec3 v0(packet.v0[0][i], packet.v0[1][i], packet.v0[2][i]);
+        glm::vec3 edge1(packet.edge1[0][i], packet.edge1[1][i], packet.edge1[2][i]);
+        glm::vec3 edge2(packet.edge2[0][i], packet.edge2[1][i], packet.edge2[2][i]);
+
+        glm::vec3 P = glm::cross(direction, edge2);
+        float det = glm::dot(edge1, P);
+        if (allowBackface ? fabsf(det) < EPSILON : det < EPSILON) {
+            continue;
+        }
+        float invDet = 1.0f / det;
+        glm::vec3 T = origin - v0;
+        float u = glm::dot(T, P) * invDet;
+        if (u < 0.0f || u > 1.0f) {
+            continue;
+        }
+        glm::vec3 Q = glm::cross(T, edge1);
+        float v = glm::dot(direction, Q) * invDet;
+        if (v < 0.0f || u + v > 1.0f) {
+            continue;
+        }
+        float t = glm::dot(edge2, Q) * invDet;
+        if (t > EPSILON && t < distance) {
+            distance = t;
+            lane = i;
+            hit = true;
         }
     }
-    // either we're at max depth, or the triangle doesn't fit in one of our
-    // children and so we want to just record it here
-    _triangleIndices.push_back(triangleIndex);
+    return hit;
+#endif
 }
 
+// Determine of the given ray (origin/direction) in model space intersects with any triangles
+// in the set. If an intersection occurs, the distance and surface normal will be provided.
+// Without precision, the bounds of the nearest leaf the ray hits stand in for its triangles.
 bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
                                       BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
     if (!_isBalanced) {
         balanceTree();
     }
 
-    float localDistance = distance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findRayIntersection(origin, direction, invDirection, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        distance = localDistance;
-    }
+    struct StackEntry {
+        uint32_t nodeIndex;
+        float distance;
+    };
+    StackEntry stack[MAX_TRAVERSAL_DEPTH];
+    int stackSize = 0;
 
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
+    float rootDistance;
+    if (_nodes.empty() || !findRayNodeIntersection(_nodes[0].minimum, _nodes[0].maximum, origin, invDirection, FLT_MAX, rootDistance)) {
+        return false;
     }
-#endif
-    return hit;
-}
+    stack[stackSize++] = { 0, rootDistance };
 
-// Determine of the given ray (origin/direction) in model space intersects with any triangles
-// in the set. If an intersection occurs, the distance and surface normal will be provided.
-bool TriangleSet::TriangleTreeCell::findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-                                                                  float& distance, BoxFace& face, Triangle& triangle, bool precision,
-                                                                  int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
     float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findRayTriangleIntersection(origin, direction, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
-            }
-        }
-    } else {
-        intersectedSomething = true;
-        bestDistance = distance;
-    }
-
-    if (intersectedSomething) {
-        distance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-                                                        float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-                                                        bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
-
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
+    BoxFace bestFace = UNKNOWN_FACE;
+    uint32_t bestTriangleIndex = 0;
     bool intersects = false;
 
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = distance;
-        BoxFace internalFace { UNKNOWN_FACE };
-        Triangle internalTriangle;
-        if (findRayIntersectionInternal(origin, direction, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        if (entry.distance >= bestDistance) {
+            continue;
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findRayIntersection(origin, direction, invDirection, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
-                }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
+        const Node& node = _nodes[entry.nodeIndex];
+
+        if (node.isLeaf()) {
+            if (precision) {
+                const TrianglePacket& packet = _packets[node.offset];
+                int lane = 0;
+                if (findRayPacketIntersection(packet, origin, direction, allowBackface, bestDistance, lane)) {
+                    bestFace = UNKNOWN_FACE;
+                    bestTriangleIndex = packet.triangleIndices[lane];
+                    intersects = true;
                 }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findRayIntersection(origin, direction, invDirection, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findRayIntersection(origin, direction, invDirection, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
+            } else {
+                AABox leafBounds(node.minimum, node.maximum - node.minimum);
+                float leafDistance = entry.distance;
+                BoxFace leafFace = UNKNOWN_FACE;
+                glm::vec3 leafNormal;
+                leafBounds.findRayIntersection(origin, direction, invDirection, leafDistance, leafFace, leafNormal);
+                if (leafDistance < bestDistance) {
+                    bestDistance = leafDistance;
+                    bestFace = leafFace;
                     intersects = true;
-                    break;
                 }
             }
+            continue;
+        }
+
+        // visit the nearer child first, so that its hits can cull the farther one
+        uint32_t firstIndex = entry.nodeIndex + 1;
+        uint32_t secondIndex = node.offset;
+        float firstDistance, secondDistance;
+        bool hitsFirst = findRayNodeIntersection(_nodes[firstIndex].minimum, _nodes[firstIndex].maximum, origin, invDirection,
+                                                 bestDistance, firstDistance);
+        bool hitsSecond = findRayNodeIntersection(_nodes[secondIndex].minimum, _nodes[secondIndex].maximum, origin, invDirection,
+                                                  bestDistance, secondDistance);
+        if (hitsFirst && hitsSecond) {
+            if (firstDistance < secondDistance) {
+                stack[stackSize++] = { secondIndex, secondDistance };
+                stack[stackSize++] = { firstIndex, firstDistance };
+            } else {
+                stack[stackSize++] = { firstIndex, firstDistance };
+                stack[stackSize++] = { secondIndex, secondDistance };
+            }
+        } else if (hitsFirst) {
+            stack[stackSize++] = { firstIndex, firstDistance };
+        } else if (hitsSecond) {
+            stack[stackSize++] = { secondIndex, secondDistance };
         }
     }
 
     if (intersects) {
-        distance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+        distance = bestDistance;
+        face = bestFace;
+        triangle = precision ? _triangles[bestTriangleIndex] : Triangle();
     }
     return intersects;
 }
@@ -331,145 +496,86 @@ bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::v
         balanceTree();
     }
 
-    float localDistance = parabolicDistance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findParabolaIntersection(origin, velocity, acceleration, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        parabolicDistance = localDistance;
-    }
+    struct StackEntry {
+        uint32_t nodeIndex;
+        float distance;
+    };
+    StackEntry stack[MAX_TRAVERSAL_DEPTH];
+    int stackSize = 0;
 
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
+    float rootDistance = FLT_MAX;
+    if (_nodes.empty() || !findParabolaNodeIntersection(_nodes[0].minimum, _nodes[0].maximum, origin, velocity, acceleration, rootDistance)) {
+        return false;
     }
-#endif
-    return hit;
-}
+    stack[stackSize++] = { 0, rootDistance };
 
-bool TriangleSet::TriangleTreeCell::findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity,
-                                                                       const glm::vec3& acceleration, float& parabolicDistance,
-                                                                       BoxFace& face, Triangle& triangle, bool precision,
-                                                                       int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
     float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
-            }
-        }
-    } else {
-        intersectedSomething = true;
-        bestDistance = parabolicDistance;
-    }
-
-    if (intersectedSomething) {
-        parabolicDistance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
-                                                               const glm::vec3& acceleration, float& parabolicDistance,
-                                                               BoxFace& face, Triangle& triangle, bool precision,
-                                                               int& trianglesTouched, bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
-
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
+    BoxFace bestFace = UNKNOWN_FACE;
+    uint32_t bestTriangleIndex = 0;
     bool intersects = false;
 
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = parabolicDistance;
-        BoxFace internalFace;
-        Triangle internalTriangle;
-        if (findParabolaIntersectionInternal(origin, velocity, acceleration, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        if (entry.distance >= bestDistance) {
+            continue;
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findParabolaIntersection(origin, velocity, acceleration, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
+        const Node& node = _nodes[entry.nodeIndex];
+
+        if (node.isLeaf()) {
+            if (precision) {
+                const TrianglePacket& packet = _packets[node.offset];
+                for (uint32_t lane = 0; lane < node.count; lane++) {
+                    float triangleDistance;
+                    const Triangle& thisTriangle = _triangles[packet.triangleIndices[lane]];
+                    if (findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, triangleDistance, allowBackface) &&
+                        triangleDistance < bestDistance) {
+                        bestDistance = triangleDistance;
+                        bestFace = UNKNOWN_FACE;
+                        bestTriangleIndex = packet.triangleIndices[lane];
+                        intersects = true;
                     }
                 }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findParabolaIntersection(origin, velocity, acceleration, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findParabolaIntersection(origin, velocity, acceleration, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
+            } else {
+                AABox leafBounds(node.minimum, node.maximum - node.minimum);
+                float leafDistance = entry.distance;
+                BoxFace leafFace = UNKNOWN_FACE;
+                glm::vec3 leafNormal;
+                leafBounds.findParabolaIntersection(origin, velocity, acceleration, leafDistance, leafFace, leafNormal);
+                if (leafDistance < bestDistance) {
+                    bestDistance = leafDistance;
+                    bestFace = leafFace;
                     intersects = true;
-                    break;
                 }
             }
+            continue;
+        }
+
+        uint32_t firstIndex = entry.nodeIndex + 1;
+        uint32_t secondIndex = node.offset;
+        float firstDistance = FLT_MAX, secondDistance = FLT_MAX;
+        bool hitsFirst = findParabolaNodeIntersection(_nodes[firstIndex].minimum, _nodes[firstIndex].maximum,
+                                                      origin, velocity, acceleration, firstDistance) && firstDistance < bestDistance;
+        bool hitsSecond = findParabolaNodeIntersection(_nodes[secondIndex].minimum, _nodes[secondIndex].maximum,
+                                                       origin, velocity, acceleration, secondDistance) && secondDistance < bestDistance;
+        if (hitsFirst && hitsSecond) {
+            if (firstDistance < secondDistance) {
+                stack[stackSize++] = { secondIndex, secondDistance };
+                stack[stackSize++] = { firstIndex, firstDistance };
+            } else {
+                stack[stackSize++] = { firstIndex, firstDistance };
+                stack[stackSize++] = { secondIndex, secondDistance };
+            }
+        } else if (hitsFirst) {
+            stack[stackSize++] = { firstIndex, firstDistance };
+        } else if (hitsSecond) {
+            stack[stackSize++] = { secondIndex, secondDistance };
         }
     }
 
     if (intersects) {
-        parabolicDistance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+        parabolicDistance = bestDistance;
+        face = bestFace;
+        triangle = precision ? _triangles[bestTriangleIndex] : Triangle();
     }
     return intersects;
 }
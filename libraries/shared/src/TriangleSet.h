@@ -19,51 +19,29 @@
 
 class TriangleSet {
 
-    class TriangleTreeCell {
-    public:
-        TriangleTreeCell(std::vector<Triangle>& allTriangles) : _allTriangles(allTriangles) {}
-        TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth);
-
-        void insert(size_t triangleIndex);
-        void reset(const AABox& bounds, int depth = 0);
-        void clear();
-
-        bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        const AABox& getBounds() const { return _bounds; }
-
-        void debugDump();
-
-    protected:
-        // checks our internal list of triangles
-        bool findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        std::pair<AABox, AABox> getTriangleTreeCellChildBounds();
-
-        std::vector<Triangle>& _allTriangles;
-        std::pair<std::shared_ptr<TriangleTreeCell>, std::shared_ptr<TriangleTreeCell>> _children;
-        int _depth { 0 };
-        int _population { 0 };
-        AABox _bounds;
-        std::vector<size_t> _triangleIndices;
-
-        friend class TriangleSet;
+    // A node of the flattened bounding volume hierarchy. Interior nodes keep their first child immediately after
+    // themselves and the index of their second child in offset. Leaves hold up to four triangles, packed into the
+    // TrianglePacket at offset.
+    struct Node {
+        glm::vec3 minimum;
+        uint32_t offset { 0 };
+        glm::vec3 maximum;
+        uint32_t count { 0 }; // triangles in a leaf, 0 for interior nodes
+
+        bool isLeaf() const { return count > 0; }
     };
 
-    using SortedTriangleCell = std::pair<float, std::shared_ptr<TriangleTreeCell>>;
+    // Four triangles as a vertex and two edges each, laid out so that they can be tested against a ray together.
+    // Unused lanes have zero edges, and so never intersect anything.
+    struct TrianglePacket {
+        float v0[3][4];
+        float edge1[3][4];
+        float edge2[3][4];
+        uint32_t triangleIndices[4];
+    };
 
 public:
-    TriangleSet() : _triangleTree(_triangles) {}
+    TriangleSet() {}
 
     void debugDump();
 
@@ -81,14 +59,21 @@ public:
     void clear();
 
     // Determine if a point is "inside" all the triangles of a convex hull. It is the responsibility of the caller to
-    // determine that the triangle set is indeed a convex hull. If the triangles added to this set are not in fact a 
+    // determine that the triangle set is indeed a convex hull. If the triangles added to this set are not in fact a
     // convex hull, the result of this method is meaningless and undetermined.
     bool convexHullContains(const glm::vec3& point) const;
     const AABox& getBounds() const { return _bounds; }
 
 protected:
+    class Builder;
+
+    // tests the ray against all four triangles of the packet, returning the nearest hit closer than distance
+    static bool findRayPacketIntersection(const TrianglePacket& packet, const glm::vec3& origin, const glm::vec3& direction,
+        bool allowBackface, float& distance, int& lane);
+
     bool _isBalanced { false };
     std::vector<Triangle> _triangles;
-    TriangleTreeCell _triangleTree;
+    std::vector<Node> _nodes;
+    std::vector<TrianglePacket> _packets;
     AABox _bounds;
 };
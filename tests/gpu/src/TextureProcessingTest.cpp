@@ -0,0 +1,126 @@
+//
+//  TextureProcessingTest.cpp
+//  tests/gpu/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTest.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QImage>
+
+#include <image/CubeMap.h>
+#include <image/TextureProcessing.h>
+
+QTEST_MAIN(TextureProcessingTest)
+
+static const int TEXTURE_SIZE = 2048;
+static const int PROCESS_COUNT = 4;
+
+// a texture with enough detail that the compressors can't take shortcuts on flat blocks
+static QImage createTestImage(bool withAlpha) {
+    QImage image(TEXTURE_SIZE, TEXTURE_SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < TEXTURE_SIZE; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < TEXTURE_SIZE; x++) {
+            int red = (x * 255) / TEXTURE_SIZE;
+            int green = (y * 255) / TEXTURE_SIZE;
+            int blue = ((x ^ y) * 37) & 0xFF;
+            int alpha = withAlpha ? ((x / 16 + y / 16) & 1 ? 255 : (x + y) & 0xFF) : 255;
+            line[x] = qRgba(red, green, blue, alpha);
+        }
+    }
+    return image;
+}
+
+void TextureProcessingTest::initTestCase() {
+    qDebug() << "Texture processing concurrency" << image::getTextureProcessingConcurrency();
+}
+
+void TextureProcessingTest::benchmarkTextureProcessing_data() {
+    QTest::addColumn<int>("textureType");
+    QTest::addColumn<bool>("withAlpha");
+    QTest::addColumn<bool>("compress");
+
+    QTest::newRow("BC1") << (int)image::TextureUsage::ALBEDO_TEXTURE << false << true;
+    QTest::newRow("BC3") << (int)image::TextureUsage::ALBEDO_TEXTURE << true << true;
+    QTest::newRow("BC4") << (int)image::TextureUsage::ROUGHNESS_TEXTURE << false << true;
+    QTest::newRow("BC5") << (int)image::TextureUsage::NORMAL_TEXTURE << false << true;
+    QTest::newRow("SRGBA_32") << (int)image::TextureUsage::ALBEDO_TEXTURE << false << false;
+}
+
+void TextureProcessingTest::benchmarkTextureProcessing() {
+    QFETCH(int, textureType);
+    QFETCH(bool, withAlpha);
+    QFETCH(bool, compress);
+
+    auto loader = image::TextureUsage::getTextureLoaderForType((image::TextureUsage::Type)textureType);
+    const QImage sourceImage = createTestImage(withAlpha);
+    const std::atomic<bool> abortProcessing { false };
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < PROCESS_COUNT; i++) {
+        auto texture = loader(image::Image(sourceImage), "test", compress, gpu::BackendTarget::GL45, abortProcessing);
+        QVERIFY(texture);
+        QVERIFY(texture->getNumMips() > 1);
+    }
+    qint64 elapsedMsecs = std::max(timer.elapsed(), (qint64)1);
+
+    float megapixels = (float)PROCESS_COUNT * TEXTURE_SIZE * TEXTURE_SIZE / 1.0e6f;
+    qDebug() << QTest::currentDataTag() << "-" << megapixels * 1000.0f / elapsedMsecs << "megapixels per second";
+}
+
+void TextureProcessingTest::testConvolveForGGX() {
+    static const int CUBE_FACE_SIZE = 16;
+    static const int CUBE_MIP_COUNT = 5;
+    static const unsigned int SAMPLES_SEED = 1;
+    static const float EPSILON = 1.0e-4f;
+
+    // a different gradient on each face, so that samples crossing faces and mips show up in the result
+    std::vector<image::Image> faces;
+    for (int face = 0; face < 6; face++) {
+        QImage faceImage(CUBE_FACE_SIZE, CUBE_FACE_SIZE, QImage::Format_ARGB32);
+        for (int y = 0; y < CUBE_FACE_SIZE; y++) {
+            QRgb* line = reinterpret_cast<QRgb*>(faceImage.scanLine(y));
+            for (int x = 0; x < CUBE_FACE_SIZE; x++) {
+                line[x] = qRgba((x * 255) / CUBE_FACE_SIZE, (y * 255) / CUBE_FACE_SIZE, face * 40, 255);
+            }
+        }
+        faces.emplace_back(faceImage);
+    }
+
+    const std::atomic<bool> abortProcessing { false };
+    image::CubeMap source(faces, CUBE_MIP_COUNT, abortProcessing);
+    image::CubeMap output(CUBE_FACE_SIZE, CUBE_FACE_SIZE, CUBE_MIP_COUNT);
+    image::CubeMap expected(CUBE_FACE_SIZE, CUBE_FACE_SIZE, CUBE_MIP_COUNT);
+
+    // both draw the GGX samples from rand(), so they get the same ones from the same seed
+    srand(SAMPLES_SEED);
+    source.convolveForGGX(output, abortProcessing);
+    srand(SAMPLES_SEED);
+    source.convolveForGGXWithFetchLod(expected);
+
+    for (gpu::uint16 mipLevel = 0; mipLevel < CUBE_MIP_COUNT; mipLevel++) {
+        const auto mipDimensions = output.getMipDimensions(mipLevel);
+        const auto lineStride = output.getMipLineStride(mipLevel);
+        for (int face = 0; face < 6; face++) {
+            const glm::vec4* outputPixels = output.getFace(mipLevel, face);
+            const glm::vec4* expectedPixels = expected.getFace(mipLevel, face);
+            for (int y = 0; y < mipDimensions.y; y++) {
+                for (int x = 0; x < mipDimensions.x; x++) {
+                    const glm::vec4& pixel = outputPixels[x + y * lineStride];
+                    const glm::vec4& expectedPixel = expectedPixels[x + y * lineStride];
+                    for (int component = 0; component < 4; component++) {
+                        QVERIFY2(std::abs(pixel[component] - expectedPixel[component]) < EPSILON,
+                                 qPrintable(QString("mip %1 face %2 texel %3,%4").arg(mipLevel).arg(face).arg(x).arg(y)));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+//
+//  TextureProcessingTest.h
+//  tests/gpu/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TextureProcessingTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchmarkTextureProcessing_data();
+    void benchmarkTextureProcessing();
+    void testConvolveForGGX();
+};
@@ -0,0 +1,158 @@
+//
+//  AssetCacheTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetCacheTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <AssetCache.h>
+
+QTEST_MAIN(AssetCacheTests)
+
+static const qint64 MAXIMUM_SIZE = 1000;
+
+static QByteArray makeAsset(char fill, int size) {
+    return QByteArray(size, fill);
+}
+
+static AssetUtils::AssetHash hashOf(const QByteArray& data) {
+    return AssetUtils::hashData(data).toHex();
+}
+
+void AssetCacheTests::saveAndLoad() {
+    QTemporaryDir directory;
+    AssetCache cache { directory.path(), MAXIMUM_SIZE };
+
+    auto asset = makeAsset('a', 100);
+    auto hash = hashOf(asset);
+
+    QVERIFY(!cache.contains(hash));
+    QVERIFY(cache.load(hash).isNull());
+
+    QVERIFY(cache.save(hash, asset));
+    QVERIFY(cache.contains(hash));
+    QCOMPARE(cache.load(hash), asset);
+    QCOMPARE(cache.getSize(), (qint64)asset.size());
+
+    // The same asset is only kept once
+    QVERIFY(cache.save(hash, asset));
+    QCOMPARE(cache.getSize(), (qint64)asset.size());
+
+    cache.clear();
+    QVERIFY(!cache.contains(hash));
+    QCOMPARE(cache.getSize(), (qint64)0);
+}
+
+void AssetCacheTests::reopen() {
+    QTemporaryDir directory;
+    auto asset = makeAsset('b', 200);
+    auto hash = hashOf(asset);
+
+    {
+        AssetCache cache { directory.path(), MAXIMUM_SIZE };
+        QVERIFY(cache.save(hash, asset));
+    }
+
+    AssetCache cache { directory.path(), MAXIMUM_SIZE };
+    QVERIFY(cache.contains(hash));
+    QCOMPARE(cache.getSize(), (qint64)asset.size());
+    QCOMPARE(cache.load(hash), asset);
+}
+
+void AssetCacheTests::evictLeastRecentlyUsed() {
+    QTemporaryDir directory;
+    AssetCache cache { directory.path(), MAXIMUM_SIZE };
+
+    auto first = makeAsset('c', 400);
+    auto second = makeAsset('d', 400);
+    auto third = makeAsset('e', 400);
+
+    QVERIFY(cache.save(hashOf(first), first));
+    QTest::qWait(10);
+    QVERIFY(cache.save(hashOf(second), second));
+    QTest::qWait(10);
+
+    // Using the first makes the second the least recently used
+    QCOMPARE(cache.load(hashOf(first)), first);
+    QTest::qWait(10);
+
+    QVERIFY(cache.save(hashOf(third), third));
+    QVERIFY(cache.contains(hashOf(first)));
+    QVERIFY(!cache.contains(hashOf(second)));
+    QVERIFY(cache.contains(hashOf(third)));
+    QVERIFY(cache.getSize() <= MAXIMUM_SIZE);
+}
+
+void AssetCacheTests::partialRanges() {
+    QTemporaryDir directory;
+    AssetCache cache { directory.path(), MAXIMUM_SIZE };
+
+    const uint64_t RANGE_SIZE = 64;
+    QByteArray asset;
+    for (int i = 0; i < 150; ++i) {
+        asset.append((char)i);
+    }
+    auto hash = hashOf(asset);
+
+    QByteArray data;
+    QBitArray receivedRanges;
+    QVERIFY(!cache.loadPartial(hash, asset.size(), RANGE_SIZE, data, receivedRanges));
+
+    // The last range first, then the first, as they might arrive
+    QBitArray ranges { 3 };
+    ranges.setBit(2);
+    QVERIFY(cache.savePartialRange(hash, asset.size(), RANGE_SIZE, 2, asset.mid(128), ranges));
+    ranges.setBit(0);
+    QVERIFY(cache.savePartialRange(hash, asset.size(), RANGE_SIZE, 0, asset.mid(0, 64), ranges));
+
+    QVERIFY(cache.loadPartial(hash, asset.size(), RANGE_SIZE, data, receivedRanges));
+    QCOMPARE(receivedRanges, ranges);
+    QCOMPARE(data.size(), asset.size());
+    QCOMPARE(data.mid(0, 64), asset.mid(0, 64));
+    QCOMPARE(data.mid(64, 64), QByteArray(64, '\0'));
+    QCOMPARE(data.mid(128), asset.mid(128));
+
+    cache.removePartial(hash);
+    QVERIFY(!cache.loadPartial(hash, asset.size(), RANGE_SIZE, data, receivedRanges));
+}
+
+void AssetCacheTests::partialMismatch() {
+    QTemporaryDir directory;
+    AssetCache cache { directory.path(), MAXIMUM_SIZE };
+
+    auto asset = makeAsset('f', 100);
+    auto hash = hashOf(asset);
+
+    QBitArray ranges { 2 };
+    ranges.setBit(0);
+    QVERIFY(cache.savePartialRange(hash, asset.size(), 64, 0, asset.mid(0, 64), ranges));
+
+    // A download with different ranges starts over
+    QByteArray data;
+    QBitArray receivedRanges;
+    QVERIFY(!cache.loadPartial(hash, asset.size(), 32, data, receivedRanges));
+    QVERIFY(!cache.loadPartial(hash, asset.size(), 64, data, receivedRanges));
+}
+
+void AssetCacheTests::claimPartial() {
+    QTemporaryDir directory;
+    AssetCache cache { directory.path(), MAXIMUM_SIZE };
+
+    auto hash = hashOf(makeAsset('g', 100));
+    auto otherHash = hashOf(makeAsset('h', 100));
+
+    // One download of an asset at a time holds its partial file
+    QVERIFY(cache.claimPartial(hash));
+    QVERIFY(!cache.claimPartial(hash));
+    QVERIFY(cache.claimPartial(otherHash));
+
+    cache.releasePartial(hash);
+    QVERIFY(cache.claimPartial(hash));
+}
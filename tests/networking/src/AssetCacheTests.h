@@ -0,0 +1,27 @@
+//
+//  AssetCacheTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetCacheTests_h
+#define hifi_AssetCacheTests_h
+
+#include <QtTest/QtTest>
+
+class AssetCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void saveAndLoad();
+    void reopen();
+    void evictLeastRecentlyUsed();
+    void partialRanges();
+    void partialMismatch();
+    void claimPartial();
+};
+
+#endif // hifi_AssetCacheTests_h
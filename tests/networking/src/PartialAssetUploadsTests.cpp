@@ -0,0 +1,126 @@
+//
+//  PartialAssetUploadsTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PartialAssetUploadsTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <AssetUtils.h>
+#include <PartialAssetUploads.h>
+#include <UUID.h>
+
+QTEST_MAIN(PartialAssetUploadsTests)
+
+static QByteArray makeUploadData() {
+    QByteArray data;
+    for (int i = 0; i < 3000; i++) {
+        data.append((char)(i * 7));
+    }
+    return data;
+}
+
+static bool makeDirs(const QTemporaryDir& tempDir, QDir& spoolDir, QDir& filesDir) {
+    QDir root { tempDir.path() };
+    if (!root.mkpath("uploads") || !root.mkpath("files")) {
+        return false;
+    }
+    spoolDir = QDir(root.filePath("uploads"));
+    filesDir = QDir(root.filePath("files"));
+    return true;
+}
+
+void PartialAssetUploadsTests::resumeAfterPartialUpload() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QDir spoolDir;
+    QDir filesDir;
+    QVERIFY(makeDirs(tempDir, spoolDir, filesDir));
+
+    QByteArray data = makeUploadData();
+    QByteArray expectedHash = AssetUtils::hashData(data);
+    QUuid uploadID = QUuid::createUuid();
+    uint64_t size = data.size();
+    uint64_t bytesReceived = 0;
+    QByteArray hash;
+
+    {
+        PartialAssetUploads uploads { spoolDir, filesDir };
+        auto error = uploads.receiveChunk(uploadID, expectedHash, size, 0, data.left(1000), bytesReceived, hash);
+        QVERIFY(error == AssetUtils::AssetServerError::NoError);
+        QCOMPARE(bytesReceived, (uint64_t)1000);
+        QVERIFY(hash.isEmpty());
+    }
+
+    // A restarted server picks the upload up from its spool file, and points a client that skips ahead back to it
+    PartialAssetUploads uploads { spoolDir, filesDir };
+    auto error = uploads.receiveChunk(uploadID, expectedHash, size, 2000, data.mid(2000), bytesReceived, hash);
+    QVERIFY(error == AssetUtils::AssetServerError::InvalidByteRange);
+    QCOMPARE(bytesReceived, (uint64_t)1000);
+
+    error = uploads.receiveChunk(uploadID, expectedHash, size, 1000, data.mid(1000), bytesReceived, hash);
+    QVERIFY(error == AssetUtils::AssetServerError::NoError);
+    QCOMPARE(bytesReceived, size);
+    QCOMPARE(hash, expectedHash);
+
+    QFile file { filesDir.filePath(QString(expectedHash.toHex())) };
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), data);
+    QVERIFY(spoolDir.entryList(QDir::Files).isEmpty());
+}
+
+void PartialAssetUploadsTests::rejectHashMismatch() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QDir spoolDir;
+    QDir filesDir;
+    QVERIFY(makeDirs(tempDir, spoolDir, filesDir));
+
+    QByteArray data = makeUploadData();
+    QByteArray expectedHash = AssetUtils::hashData("some other data");
+    uint64_t bytesReceived = 0;
+    QByteArray hash;
+
+    PartialAssetUploads uploads { spoolDir, filesDir };
+    auto error = uploads.receiveChunk(QUuid::createUuid(), expectedHash, data.size(), 0, data, bytesReceived, hash);
+    QVERIFY(error == AssetUtils::AssetServerError::HashVerificationFailed);
+
+    // Nothing is committed, and the spool is thrown away
+    QVERIFY(filesDir.entryList(QDir::Files).isEmpty());
+    QVERIFY(spoolDir.entryList(QDir::Files).isEmpty());
+}
+
+void PartialAssetUploadsTests::removeAbandonedUploads() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QDir spoolDir;
+    QDir filesDir;
+    QVERIFY(makeDirs(tempDir, spoolDir, filesDir));
+
+    PartialAssetUploads uploads { spoolDir, filesDir };
+
+    QString abandonedName = uuidStringWithoutCurlyBraces(QUuid::createUuid());
+    QString recentName = uuidStringWithoutCurlyBraces(QUuid::createUuid());
+    for (const auto& name : { abandonedName, recentName }) {
+        QFile file { spoolDir.filePath(name) };
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("partial");
+        file.close();
+    }
+
+    QFile abandoned { spoolDir.filePath(abandonedName) };
+    QVERIFY(abandoned.open(QIODevice::ReadWrite));
+    QVERIFY(abandoned.setFileTime(QDateTime::currentDateTime().addDays(-8), QFileDevice::FileModificationTime));
+    abandoned.close();
+
+    uploads.removeAbandonedUploads();
+
+    QVERIFY(!QFile::exists(spoolDir.filePath(abandonedName)));
+    QVERIFY(QFile::exists(spoolDir.filePath(recentName)));
+}
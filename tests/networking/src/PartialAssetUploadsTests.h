@@ -0,0 +1,24 @@
+//
+//  PartialAssetUploadsTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PartialAssetUploadsTests_h
+#define hifi_PartialAssetUploadsTests_h
+
+#include <QtTest/QtTest>
+
+class PartialAssetUploadsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void resumeAfterPartialUpload();
+    void rejectHashMismatch();
+    void removeAbandonedUploads();
+};
+
+#endif // hifi_PartialAssetUploadsTests_h
@@ -0,0 +1,125 @@
+//
+//  EntityEditPacketTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditPacketTests.h"
+
+#include <EntityItemProperties.h>
+#include <NLPacket.h>
+
+QTEST_MAIN(EntityEditPacketTests)
+
+static const EntityItemID ENTITY_ID { QUuid("{8c5b7b1e-5d46-4e3a-9a3c-2c1b8e0d6f01}") };
+static const QUuid PARENT_ID { "{0b1f4b7e-9a65-4c5c-8a53-1a2b3c4d5e6f}" };
+static const int NUM_JOINTS = 20;
+
+// The kind of edit a script moving a model around sends many times a second
+static EntityItemProperties makeEditProperties() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Model);
+    properties.setLastEdited(usecTimestampNow());
+    properties.setName("chair");
+    properties.setUserData("{\"grabbableKey\":{\"grabbable\":true,\"kinematic\":true}}");
+    properties.setParentID(PARENT_ID);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    properties.setRotation(glm::quat(0.0f, 0.0f, 1.0f, 0.0f));
+    properties.setVelocity(glm::vec3(0.0f, -1.0f, 0.0f));
+    properties.setRenderWithZones({ QUuid::createUuid(), QUuid::createUuid() });
+
+    QVector<glm::quat> jointRotations;
+    QVector<bool> jointRotationsSet;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        jointRotations.push_back(glm::quat());
+        jointRotationsSet.push_back(i % 3 == 0);
+    }
+    properties.setJointRotations(jointRotations);
+    properties.setJointRotationsSet(jointRotationsSet);
+    return properties;
+}
+
+static QByteArray encode(const EntityItemProperties& properties) {
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    EntityPropertyFlags didntFit;
+    auto appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, ENTITY_ID, properties, buffer,
+                                                                    properties.getChangedProperties(), didntFit);
+    if (appendState != OctreeElement::COMPLETED) {
+        return QByteArray();
+    }
+    return buffer;
+}
+
+static bool decode(const QByteArray& buffer, EntityItemID& entityID, EntityItemProperties& properties) {
+    int processedBytes = 0;
+    return EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                        buffer.size(), processedBytes, entityID, properties);
+}
+
+void EntityEditPacketTests::encodeDecodeRoundTrip() {
+    auto properties = makeEditProperties();
+    QByteArray buffer = encode(properties);
+    QVERIFY(!buffer.isEmpty());
+
+    EntityItemID entityID;
+    EntityItemProperties decoded;
+    QVERIFY(decode(buffer, entityID, decoded));
+
+    QCOMPARE(entityID, ENTITY_ID);
+    QCOMPARE(decoded.getType(), EntityTypes::Model);
+    QCOMPARE(decoded.getLastEdited(), properties.getLastEdited());
+    QCOMPARE(decoded.getName(), properties.getName());
+    QCOMPARE(decoded.getUserData(), properties.getUserData());
+    QCOMPARE(decoded.getParentID(), PARENT_ID);
+    QCOMPARE(decoded.getPosition(), properties.getPosition());
+    QCOMPARE(decoded.getVelocity(), properties.getVelocity());
+    QCOMPARE(decoded.getRenderWithZones(), properties.getRenderWithZones());
+    QCOMPARE(decoded.getJointRotationsSet(), properties.getJointRotationsSet());
+    QCOMPARE(decoded.getJointRotations().size(), NUM_JOINTS);
+
+    // Encoding again on the same thread reuses its packet data, which mustn't carry anything over
+    QCOMPARE(encode(properties), buffer);
+}
+
+void EntityEditPacketTests::nonAsciiStrings() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName(QString::fromUtf8("caf\xC3\xA9 \xE2\x98\x95 \xF0\x9F\x8D\xB0"));
+    properties.setDescription(QString());
+    properties.setParentID(QUuid());
+    QByteArray buffer = encode(properties);
+    QVERIFY(!buffer.isEmpty());
+
+    EntityItemID entityID;
+    EntityItemProperties decoded;
+    QVERIFY(decode(buffer, entityID, decoded));
+    QCOMPARE(decoded.getName(), properties.getName());
+    QVERIFY(decoded.getDescription().isEmpty());
+    QVERIFY(decoded.getParentID().isNull());
+}
+
+void EntityEditPacketTests::encodeBenchmark() {
+    auto properties = makeEditProperties();
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    auto requestedProperties = properties.getChangedProperties();
+    EntityPropertyFlags didntFit;
+    QBENCHMARK {
+        buffer.resize(NLPacket::maxPayloadSize(PacketType::EntityEdit));
+        EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, ENTITY_ID, properties, buffer,
+                                                     requestedProperties, didntFit);
+    }
+}
+
+void EntityEditPacketTests::decodeBenchmark() {
+    QByteArray buffer = encode(makeEditProperties());
+    QVERIFY(!buffer.isEmpty());
+    QBENCHMARK {
+        EntityItemID entityID;
+        EntityItemProperties decoded;
+        decode(buffer, entityID, decoded);
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  EntityEditPacketTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditPacketTests_h
+#define hifi_EntityEditPacketTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditPacketTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void encodeDecodeRoundTrip();
+    void nonAsciiStrings();
+    void encodeBenchmark();
+    void decodeBenchmark();
+};
+
+#endif // hifi_EntityEditPacketTests_h
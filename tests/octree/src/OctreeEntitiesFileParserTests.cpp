@@ -0,0 +1,78 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+static const QByteArray ENTITIES_JSON(
+    "{\n"
+    "    \"DataVersion\": 3,\n"
+    "    \"Entities\": [\n"
+    "        { \"id\": \"{8c5b7b1e-5d46-4e3a-9a3c-2c1b8e0d6f01}\", \"type\": \"Box\", \"name\": \"a {brace} \\\"quoted\\\"\" },\n"
+    "        { \"id\": \"{8c5b7b1e-5d46-4e3a-9a3c-2c1b8e0d6f02}\", \"type\": \"Model\", \"modelURL\": \"./models/chair.fbx\",\n"
+    "          \"animation\": { \"url\": \"../animations/sit.fbx\" } }\n"
+    "    ],\n"
+    "    \"Id\": \"{0b1f4b7e-9a65-4c5c-8a53-1a2b3c4d5e6f}\",\n"
+    "    \"Version\": 120\n"
+    "}\n");
+
+void OctreeEntitiesFileParserTests::deferredEntitiesMatchParsedEntities() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+    QVariantList entities = parsed["Entities"].toList();
+    QCOMPARE(entities.size(), 2);
+
+    OctreeEntitiesFileParser deferredParser;
+    deferredParser.setEntitiesString(ENTITIES_JSON);
+    QVariantMap header;
+    QVERIFY(deferredParser.parseEntitiesHeader(header));
+    QVERIFY(!header.contains("Entities"));
+    QCOMPARE(header["Version"].toInt(), 120);
+    QCOMPARE(header["DataVersion"].toInt(), 3);
+    QCOMPARE(header["Id"].toUuid(), parsed["Id"].toUuid());
+
+    QCOMPARE(deferredParser.getNumEntities(), 2);
+    for (int i = 0; i < deferredParser.getNumEntities(); i++) {
+        QJsonObject entityObject;
+        QVERIFY(deferredParser.parseEntity(i, entityObject));
+        QCOMPARE(entityObject.toVariantMap(), entities[i].toMap());
+    }
+}
+
+void OctreeEntitiesFileParserTests::deferredEntitiesResolveRelativeURLs() {
+    OctreeEntitiesFileParser parser;
+    parser.setRelativeURL(QUrl("file:///content/domain/"));
+    parser.setEntitiesString(ENTITIES_JSON);
+    QVariantMap header;
+    QVERIFY(parser.parseEntitiesHeader(header));
+
+    QJsonObject entityObject;
+    QVERIFY(parser.parseEntity(1, entityObject));
+    QCOMPARE(entityObject["modelURL"].toString(), QString("file:///content/domain/models/chair.fbx"));
+    QCOMPARE(entityObject["animation"].toObject()["url"].toString(), QString("file:///content/animations/sit.fbx"));
+}
+
+void OctreeEntitiesFileParserTests::deferredEntityIllFormed() {
+    // only the braces are checked up front, so a bad entity is reported when it's parsed
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString("{ \"Entities\": [ { \"type\": \"Box\" }, { \"type\" \"Sphere\" } ], \"Version\": 120 }");
+    QVariantMap header;
+    QVERIFY(parser.parseEntitiesHeader(header));
+    QCOMPARE(parser.getNumEntities(), 2);
+
+    QJsonObject entityObject;
+    QVERIFY(parser.parseEntity(0, entityObject));
+    QVERIFY(!parser.parseEntity(1, entityObject));
+}
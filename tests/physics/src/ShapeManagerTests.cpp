@@ -13,6 +13,8 @@
 
 #include <iostream>
 
+#include <QTemporaryDir>
+
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +246,59 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::loadCompoundShapeFromDiskCache() {
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const std::string cachePath = cacheDir.path().toStdString();
+
+    // two tetrahedral hulls side by side
+    ShapeInfo::PointCollection pointCollection;
+    Extents extents;
+    for (int i = 0; i < 2; ++i) {
+        glm::vec3 offset((float)i, 0.0f, 0.0f);
+        ShapeInfo::PointList pointList;
+        pointList.push_back(glm::vec3(1.0f, 1.0f, 1.0f) + offset);
+        pointList.push_back(glm::vec3(1.0f, -1.0f, -1.0f) + offset);
+        pointList.push_back(glm::vec3(-1.0f, 1.0f, -1.0f) + offset);
+        pointList.push_back(glm::vec3(-1.0f, -1.0f, 1.0f) + offset);
+        for (const auto& point : pointList) {
+            extents.addPoint(point);
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, 0.5f * (extents.maximum - extents.minimum));
+    info.setPointCollection(pointCollection);
+
+    btVector3 expectedMin, expectedMax;
+    {
+        // first session: shape is built and written to disk
+        ShapeManager shapeManager;
+        shapeManager.setDiskCacheDirectory(cachePath);
+        const btCollisionShape* shape = shapeManager.getShape(info);
+        QVERIFY(shape != nullptr);
+        shape->getAabb(btTransform::getIdentity(), expectedMin, expectedMax);
+        QCOMPARE(shapeManager.getDiskCache()->getMissCount(), (uint32_t)1);
+        QCOMPARE(shapeManager.getDiskCache()->getStoreCount(), (uint32_t)1);
+        shapeManager.releaseShape(shape);
+    }
+
+    // second session: shape is loaded from disk
+    ShapeManager shapeManager;
+    shapeManager.setDiskCacheDirectory(cachePath);
+    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getDiskCache()->getHitCount(), (uint32_t)1);
+    QCOMPARE(shapeManager.getDiskCache()->getMissCount(), (uint32_t)0);
+
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* compoundShape = static_cast<const btCompoundShape*>(shape);
+    QCOMPARE(compoundShape->getNumChildShapes(), pointCollection.size());
+
+    btVector3 aabbMin, aabbMax;
+    shape->getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+    QVERIFY(aabbMin == expectedMin);
+    QVERIFY(aabbMax == expectedMax);
+    shapeManager.releaseShape(shape);
+}
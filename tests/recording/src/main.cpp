@@ -16,6 +16,7 @@
 
 #include <QtGlobal>
 #include <QtTest/QtTest>
+#include <QtCore/QBuffer>
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QString>
 
@@ -29,7 +30,10 @@
 
 #include <recording/Clip.h>
 #include <recording/Frame.h>
+#include <recording/impl/PointerClip.h>
 
+#include <AvatarData.h>
+#include <GLMHelpers.h>
 #include <SharedUtil.h>
 
 #include "Constants.h"
@@ -119,10 +123,115 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+QByteArray writeIndexedClip() {
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < 10; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, QByteArray(i * 10, (char)i)));
+    }
+    QByteArray clipData;
+    QBuffer buffer(&clipData);
+    buffer.open(QIODevice::WriteOnly);
+    writeClip->write(buffer);
+    return clipData;
+}
+
+void testFrameIndex() {
+    QByteArray clipData = writeIndexedClip();
+    QVERIFY(!clipData.isEmpty());
+    auto data = (uchar*)clipData.data();
+    size_t size = clipData.size();
+
+    // Indexed clips give the same frame table as walking the frames, less the index frames themselves
+    auto indexed = parseFrameIndex(data, size);
+    auto walked = parseFrameHeaders(data, size);
+    QVERIFY(indexed.size() == 11);
+    QVERIFY(walked.size() > indexed.size());
+    QVERIFY(std::equal(indexed.begin(), indexed.end(), walked.begin(),
+        [](const PointerFrameHeader& a, const PointerFrameHeader& b) {
+            return a.type == b.type && a.timeOffset == b.timeOffset && a.size == b.size && a.fileOffset == b.fileOffset;
+        }));
+    QVERIFY(walked.back().type == Frame::TYPE_INDEX_LOCATOR);
+
+    // Clips without an index, as written by older versions, have no locator to find
+    quint64 indexOffset;
+    const size_t locatorFrameSize = PointerClip::MINIMUM_FRAME_SIZE + PointerClip::FRAME_INDEX_LOCATOR_SIZE;
+    memcpy(&indexOffset, data + size - PointerClip::FRAME_INDEX_LOCATOR_SIZE, sizeof(quint64));
+    QVERIFY(indexOffset < size - locatorFrameSize);
+    QVERIFY(parseFrameIndex(data, indexOffset).empty());
+    QVERIFY(parseFrameHeaders(data, indexOffset).size() == indexed.size());
+
+    // Corrupted locators are ignored rather than trusted
+    QByteArray badOffset = clipData;
+    quint64 pastEnd = size;
+    memcpy(badOffset.data() + size - PointerClip::FRAME_INDEX_LOCATOR_SIZE, &pastEnd, sizeof(quint64));
+    QVERIFY(parseFrameIndex((uchar*)badOffset.data(), size).empty());
+
+    QByteArray badCount = clipData;
+    uint32_t tooMany = 1000;
+    memcpy(badCount.data() + size - sizeof(uint32_t), &tooMany, sizeof(uint32_t));
+    QVERIFY(parseFrameIndex((uchar*)badCount.data(), size).empty());
+
+    QByteArray badType = clipData;
+    FrameType notALocator = TEST_FRAME_TYPE;
+    memcpy(badType.data() + size - locatorFrameSize, &notALocator, sizeof(FrameType));
+    QVERIFY(parseFrameIndex((uchar*)badType.data(), size).empty());
+
+    QVERIFY(parseFrameIndex(data, locatorFrameSize - 1).empty());
+}
+
+void testAvatarFrameRoundTrip() {
+    AvatarData avatar;
+    avatar.setWorldPosition(glm::vec3(1.0f, 2.0f, -3.0f));
+    avatar.setWorldOrientation(glm::angleAxis(0.5f, Vectors::UNIT_Y));
+
+    QVector<JointData> joints(3);
+    joints[0].rotation = glm::angleAxis(0.3f, Vectors::UNIT_X);
+    joints[0].rotationIsDefaultPose = false;
+    joints[0].translation = glm::vec3(0.1f, 0.2f, -0.3f);
+    joints[0].translationIsDefaultPose = false;
+    joints[2].rotation = glm::angleAxis(-1.2f, Vectors::UNIT_Z);
+    joints[2].rotationIsDefaultPose = false;
+    avatar.setRawJointData(joints);
+
+    QByteArray frameData = AvatarData::toFrame(avatar);
+    QVERIFY(!AvatarData::frameHasSkeleton(frameData));
+
+    AvatarData result;
+    AvatarData::fromFrame(frameData, result);
+    QVERIFY(glm::distance(result.getWorldPosition(), avatar.getWorldPosition()) < 0.001f);
+    QVERIFY(fabsf(glm::dot(result.getWorldOrientation(), avatar.getWorldOrientation())) > 0.9999f);
+
+    auto resultJoints = result.getRawJointData();
+    QVERIFY(resultJoints.size() == joints.size());
+    for (int i = 0; i < joints.size(); ++i) {
+        QVERIFY(resultJoints[i].rotationIsDefaultPose == joints[i].rotationIsDefaultPose);
+        QVERIFY(resultJoints[i].translationIsDefaultPose == joints[i].translationIsDefaultPose);
+        if (!joints[i].rotationIsDefaultPose) {
+            QVERIFY(fabsf(glm::dot(resultJoints[i].rotation, joints[i].rotation)) > 0.9999f);
+        }
+        if (!joints[i].translationIsDefaultPose) {
+            QVERIFY(glm::distance(resultJoints[i].translation, joints[i].translation) < 0.001f);
+        }
+    }
+
+    // The skeleton travels in its own frame, shared by the whole clip
+    const QUrl skeletonModelURL("http://example.com/avatar.fst");
+    const QString displayName = QString::fromUtf8("Recorded \xC3\xA9");
+    avatar.setSkeletonModelURL(skeletonModelURL);
+    avatar.setDisplayName(displayName);
+    AvatarData::fromFrame(AvatarData::toFrame(avatar), result);
+    QVERIFY(result.getSkeletonModelURL() != skeletonModelURL);
+    AvatarData::fromSkeletonFrame(AvatarData::toSkeletonFrame(avatar), result);
+    QVERIFY(result.getSkeletonModelURL() == skeletonModelURL);
+    QVERIFY(result.getDisplayName() == displayName);
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testFrameIndex();
+    testAvatarFrameRoundTrip();
 }
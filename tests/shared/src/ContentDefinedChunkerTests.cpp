@@ -0,0 +1,102 @@
+//
+//  ContentDefinedChunkerTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentDefinedChunkerTests.h"
+
+#include <random>
+
+#include <ContentDefinedChunker.h>
+
+QTEST_MAIN(ContentDefinedChunkerTests)
+
+static const int TEST_DATA_SIZE = 4 * 1024 * 1024;
+
+static QByteArray makeData(int size) {
+    // Seeded so that the chunks are the same from run to run
+    std::mt19937 generator(1);
+    QByteArray data(size, 0);
+    for (int i = 0; i < size; i++) {
+        data[i] = (char)(generator() & 0xFF);
+    }
+    return data;
+}
+
+static QList<QByteArray> chunkData(const QByteArray& data) {
+    QList<QByteArray> chunks;
+    int offset = 0;
+    while (offset < data.size()) {
+        int length = ContentDefinedChunker::nextChunkLength(data.constData() + offset, data.size() - offset);
+        if (length <= 0) {
+            break;
+        }
+        chunks.push_back(data.mid(offset, length));
+        offset += length;
+    }
+    return chunks;
+}
+
+void ContentDefinedChunkerTests::chunkRoundTrip() {
+    QByteArray data = makeData(TEST_DATA_SIZE);
+    QList<QByteArray> chunks = chunkData(data);
+    QVERIFY(chunks.size() > 1);
+
+    QByteArray reassembled;
+    for (const auto& chunk : chunks) {
+        reassembled.append(chunk);
+    }
+    QCOMPARE(reassembled, data);
+
+    // Data shorter than a chunk is a single chunk
+    QByteArray small = data.left(ContentDefinedChunker::MIN_CHUNK_SIZE / 2);
+    QCOMPARE(chunkData(small).size(), 1);
+    QCOMPARE(chunkData(small).front(), small);
+}
+
+void ContentDefinedChunkerTests::chunkSizesWithinBounds() {
+    QList<QByteArray> chunks = chunkData(makeData(TEST_DATA_SIZE));
+    for (int i = 0; i < chunks.size(); i++) {
+        QVERIFY(chunks[i].size() <= ContentDefinedChunker::MAX_CHUNK_SIZE);
+        // Only the last chunk can be shorter than the minimum
+        if (i < chunks.size() - 1) {
+            QVERIFY(chunks[i].size() >= ContentDefinedChunker::MIN_CHUNK_SIZE);
+        }
+    }
+}
+
+void ContentDefinedChunkerTests::boundariesStableUnderInsertion() {
+    QByteArray data = makeData(TEST_DATA_SIZE);
+    QByteArray edited = data;
+    const int insertionOffset = TEST_DATA_SIZE / 2 + 17;
+    edited.insert(insertionOffset, QByteArray(100, 'x'));
+
+    QList<QByteArray> originalChunks = chunkData(data);
+    QList<QByteArray> editedChunks = chunkData(edited);
+
+    // The chunks before the insertion are unchanged
+    int offset = 0;
+    int i = 0;
+    while (offset + originalChunks[i].size() <= insertionOffset) {
+        QCOMPARE(editedChunks[i], originalChunks[i]);
+        offset += originalChunks[i].size();
+        i++;
+    }
+
+    // and the boundaries after it line up again within a few chunks, so nearly every chunk is shared
+    QSet<QByteArray> originalSet = originalChunks.toSet();
+    int newChunks = 0;
+    for (const auto& chunk : editedChunks) {
+        if (!originalSet.contains(chunk)) {
+            newChunks++;
+        }
+    }
+    QVERIFY(newChunks >= 1);
+    QVERIFY(newChunks <= 3);
+    QCOMPARE(editedChunks.back(), originalChunks.back());
+}
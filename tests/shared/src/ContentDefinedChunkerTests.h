@@ -0,0 +1,24 @@
+//
+//  ContentDefinedChunkerTests.h
+//  tests/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContentDefinedChunkerTests_h
+#define hifi_ContentDefinedChunkerTests_h
+
+#include <QtTest/QtTest>
+
+class ContentDefinedChunkerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void chunkRoundTrip();
+    void chunkSizesWithinBounds();
+    void boundariesStableUnderInsertion();
+};
+
+#endif // hifi_ContentDefinedChunkerTests_h
@@ -0,0 +1,93 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+static const QByteArray TEST_DICTIONARY("\"grabbableKey\":{\"grabbable\":false}https://.fbx.js");
+
+static QByteArray makePayload(int copies) {
+    QByteArray payload;
+    for (int i = 0; i < copies; i++) {
+        payload += "{\"grabbableKey\":{\"grabbable\":false}}";
+        payload += QByteArray::number(i);
+        payload += "https://example.com/model.fbx";
+    }
+    return payload;
+}
+
+void GzipTests::gzipRoundTrip() {
+    QByteArray payload = makePayload(100);
+    QByteArray compressed;
+    QVERIFY(gzip(payload, compressed));
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QCOMPARE(uncompressed, payload);
+}
+
+void GzipTests::zlibDictionaryRoundTrip() {
+    ZlibCompressor plain(1);
+    ZlibCompressor primed(1, TEST_DICTIONARY);
+    QByteArray buffer(4096, 0);
+
+    // reuse each compressor to make sure the stream is reset between calls
+    for (int copies : { 1, 3, 0, 20 }) {
+        QByteArray payload = makePayload(copies);
+
+        int plainSize = plain.compress((const unsigned char*)payload.constData(), payload.size(),
+                                       (unsigned char*)buffer.data(), buffer.size());
+        QVERIFY(plainSize > 0);
+        QByteArray uncompressed;
+        QVERIFY(zlibUncompress((const unsigned char*)buffer.constData(), plainSize, uncompressed));
+        QCOMPARE(uncompressed, payload);
+
+        int primedSize = primed.compress((const unsigned char*)payload.constData(), payload.size(),
+                                         (unsigned char*)buffer.data(), buffer.size());
+        QVERIFY(primedSize > 0);
+        if (copies == 1) {
+            QVERIFY(primedSize < plainSize);
+        }
+        QVERIFY(!zlibUncompress((const unsigned char*)buffer.constData(), primedSize, uncompressed));
+        QVERIFY(zlibUncompress((const unsigned char*)buffer.constData(), primedSize, uncompressed, TEST_DICTIONARY));
+        QCOMPARE(uncompressed, payload);
+    }
+
+    // a destination that is too small fails instead of truncating
+    QByteArray payload = makePayload(20);
+    QCOMPARE(primed.compress((const unsigned char*)payload.constData(), payload.size(),
+                             (unsigned char*)buffer.data(), 8), -1);
+}
+
+void GzipTests::zlibReadsQCompress() {
+    QByteArray payload = makePayload(10);
+    QByteArray compressed = qCompress(payload, 9);
+    QByteArray uncompressed;
+    QVERIFY(zlibUncompress((const unsigned char*)compressed.constData(), compressed.size(), uncompressed, TEST_DICTIONARY));
+    QCOMPARE(uncompressed, payload);
+
+    ZlibCompressor compressor(9);
+    QByteArray buffer(4096, 0);
+    int size = compressor.compress((const unsigned char*)payload.constData(), payload.size(),
+                                   (unsigned char*)buffer.data(), buffer.size());
+    QVERIFY(size > 0);
+    QCOMPARE(qUncompress((const uchar*)buffer.constData(), size), payload);
+}
+
+void GzipTests::zlibRejectsTruncatedData() {
+    QByteArray payload = makePayload(10);
+    QByteArray compressed = qCompress(payload);
+    QByteArray uncompressed;
+    QVERIFY(!zlibUncompress((const unsigned char*)compressed.constData(), compressed.size() / 2, uncompressed));
+    QVERIFY(uncompressed.isEmpty());
+    QVERIFY(!zlibUncompress(nullptr, 0, uncompressed));
+}
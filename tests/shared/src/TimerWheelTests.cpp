@@ -0,0 +1,153 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <map>
+#include <random>
+
+#include <TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using Wheel = TimerWheel<int>;
+
+void TimerWheelTests::expiryTest() {
+    Wheel wheel;
+    std::vector<Wheel::Expired> expired;
+
+    auto late = wheel.add(2, 20);
+    auto early = wheel.add(1, 10);
+    auto sameTick = wheel.add(3, 20);
+    // Already due, so it expires on the next tick
+    auto overdue = wheel.add(0, 0);
+    QCOMPARE(wheel.size(), (size_t)4);
+    QCOMPARE(wheel.nextExpiry(), (uint64_t)1);
+
+    wheel.advance(9, expired);
+    QCOMPARE(expired.size(), (size_t)1);
+    QCOMPARE(expired[0].id, overdue);
+    QCOMPARE(expired[0].expiry, (uint64_t)1);
+    QCOMPARE(wheel.nextExpiry(), (uint64_t)10);
+
+    expired.clear();
+    wheel.advance(20, expired);
+    QCOMPARE(expired.size(), (size_t)3);
+    QCOMPARE(expired[0].id, early);
+    QCOMPARE(expired[1].id, late);
+    QCOMPARE(expired[2].id, sameTick);
+
+    // Expired timers are kept until they are removed
+    QCOMPARE(*wheel.find(late), 2);
+    QVERIFY(wheel.remove(late));
+    QVERIFY(!wheel.find(late));
+    QCOMPARE(wheel.nextExpiry(), std::numeric_limits<uint64_t>::max());
+}
+
+void TimerWheelTests::removeTest() {
+    Wheel wheel;
+    std::vector<Wheel::Expired> expired;
+
+    auto first = wheel.add(1, 5);
+    auto second = wheel.add(2, 5);
+    auto third = wheel.add(3, 5);
+    QVERIFY(wheel.remove(second));
+    QVERIFY(!wheel.remove(second));
+
+    wheel.advance(5, expired);
+    QCOMPARE(expired.size(), (size_t)2);
+    QCOMPARE(expired[0].id, first);
+    QCOMPARE(expired[1].id, third);
+}
+
+void TimerWheelTests::rescheduleTest() {
+    Wheel wheel;
+    std::vector<Wheel::Expired> expired;
+
+    // An interval of 10 ticks
+    auto interval = wheel.add(0, 10);
+    for (uint64_t tick = 10; tick <= 1000; tick += 10) {
+        expired.clear();
+        wheel.advance(tick, expired);
+        QCOMPARE(expired.size(), (size_t)1);
+        QCOMPARE(expired[0].id, interval);
+        QCOMPARE(expired[0].expiry, tick);
+        QVERIFY(wheel.reschedule(interval, tick + 10));
+    }
+    QCOMPARE(wheel.size(), (size_t)1);
+}
+
+void TimerWheelTests::cascadeTest() {
+    Wheel wheel(12345);
+    std::vector<Wheel::Expired> expired;
+
+    // One timer for each level, and one beyond the range of the wheel
+    std::vector<uint64_t> expiries { 12345 + 63, 12345 + 64, 12345 + 5000, 12345 + 300000, 12345 + 20000000,
+                                     12345 + 40000000 };
+    for (auto expiry : expiries) {
+        wheel.add(0, expiry);
+    }
+
+    uint64_t tick = 12345;
+    while (!wheel.empty()) {
+        uint64_t nextExpiry = wheel.nextExpiry();
+        QVERIFY(nextExpiry > tick);
+        expired.clear();
+        wheel.advance(nextExpiry, expired);
+        tick = nextExpiry;
+        for (const auto& timer : expired) {
+            QCOMPARE(timer.expiry, tick);
+            QCOMPARE(timer.expiry, expiries.front());
+            expiries.erase(expiries.begin());
+            wheel.remove(timer.id);
+        }
+    }
+    QVERIFY(expiries.empty());
+}
+
+void TimerWheelTests::randomTest() {
+    Wheel wheel;
+    std::vector<Wheel::Expired> expired;
+    std::map<Wheel::TimerID, uint64_t> scheduled;
+    std::mt19937 random(7);
+    uint64_t tick = 0;
+
+    for (int i = 0; i < 100000; ++i) {
+        auto operation = random() % 10;
+        if (operation < 5) {
+            uint64_t expiry = tick + ((random() % 4) ? random() % 5000 : random() % 30000000);
+            scheduled[wheel.add(i, expiry)] = std::max(expiry, tick + 1);
+        } else if (operation < 7 && !scheduled.empty()) {
+            auto itr = scheduled.begin();
+            std::advance(itr, random() % scheduled.size());
+            QVERIFY(wheel.remove(itr->first));
+            scheduled.erase(itr);
+        } else {
+            uint64_t nextExpiry = wheel.nextExpiry();
+            uint64_t advanceTo = tick + ((random() % 3) ? random() % 100 : random() % 2000000);
+            expired.clear();
+            wheel.advance(advanceTo, expired);
+            uint64_t previousExpiry = tick;
+            for (const auto& timer : expired) {
+                QVERIFY(timer.expiry >= nextExpiry);
+                QVERIFY(timer.expiry >= previousExpiry && timer.expiry <= advanceTo);
+                QCOMPARE(scheduled[timer.id], timer.expiry);
+                previousExpiry = timer.expiry;
+                scheduled.erase(timer.id);
+                wheel.remove(timer.id);
+            }
+            for (const auto& timer : scheduled) {
+                QVERIFY(timer.second > advanceTo);
+            }
+            tick = advanceTo;
+        }
+    }
+    QCOMPARE(wheel.size(), scheduled.size());
+}
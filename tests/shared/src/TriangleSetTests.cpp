@@ -0,0 +1,141 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <random>
+
+#include <GLMHelpers.h>
+#include <TriangleSet.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+// enough triangles that the tree is built on several threads
+static const int NUM_TRIANGLES = 20000;
+static const int NUM_RAYS = 500;
+
+static std::vector<Triangle> makeTriangles(std::mt19937& generator, int count) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < count; i++) {
+        glm::vec3 center(position(generator), position(generator), position(generator));
+        triangles.push_back({ center + glm::vec3(offset(generator), offset(generator), offset(generator)),
+                              center + glm::vec3(offset(generator), offset(generator), offset(generator)),
+                              center + glm::vec3(offset(generator), offset(generator), offset(generator)) });
+    }
+    return triangles;
+}
+
+static void makeRay(std::mt19937& generator, glm::vec3& origin, glm::vec3& direction) {
+    std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+    origin = glm::vec3(position(generator), position(generator), position(generator));
+    glm::vec3 target(position(generator), position(generator), position(generator));
+    direction = glm::normalize(target - origin);
+}
+
+void TriangleSetTests::emptySet() {
+    TriangleSet triangleSet;
+    float distance = FLT_MAX;
+    BoxFace face;
+    Triangle triangle;
+    QVERIFY(!triangleSet.findRayIntersection(glm::vec3(0.0f), Vectors::UNIT_X, 1.0f / Vectors::UNIT_X, distance, face,
+                                             triangle, true));
+}
+
+void TriangleSetTests::rayMatchesBruteForce() {
+    std::mt19937 generator(1);
+    std::vector<Triangle> triangles = makeTriangles(generator, NUM_TRIANGLES);
+    TriangleSet triangleSet;
+    triangleSet.reserve(triangles.size());
+    for (const auto& triangle : triangles) {
+        triangleSet.insert(triangle);
+    }
+
+    int hits = 0;
+    for (int i = 0; i < NUM_RAYS; i++) {
+        glm::vec3 origin, direction;
+        makeRay(generator, origin, direction);
+        for (bool allowBackface : { false, true }) {
+            float expectedDistance = FLT_MAX;
+            bool expectedHit = false;
+            for (const auto& triangle : triangles) {
+                float distance;
+                if (findRayTriangleIntersection(origin, direction, triangle, distance, allowBackface) && distance < expectedDistance) {
+                    expectedDistance = distance;
+                    expectedHit = true;
+                }
+            }
+
+            float distance = FLT_MAX;
+            BoxFace face;
+            Triangle triangle;
+            bool hit = triangleSet.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true, allowBackface);
+            QCOMPARE(hit, expectedHit);
+            if (hit) {
+                QVERIFY(fabsf(distance - expectedDistance) < EPSILON * 100.0f);
+                float triangleDistance;
+                QVERIFY(findRayTriangleIntersection(origin, direction, triangle, triangleDistance, allowBackface));
+                hits++;
+            }
+        }
+    }
+    QVERIFY(hits > 0);
+}
+
+void TriangleSetTests::parabolaMatchesBruteForce() {
+    std::mt19937 generator(2);
+    std::vector<Triangle> triangles = makeTriangles(generator, NUM_TRIANGLES / 10);
+    TriangleSet triangleSet;
+    for (const auto& triangle : triangles) {
+        triangleSet.insert(triangle);
+    }
+
+    const glm::vec3 acceleration(0.0f, -1.0f, 0.0f);
+    for (int i = 0; i < NUM_RAYS / 10; i++) {
+        glm::vec3 origin, velocity;
+        makeRay(generator, origin, velocity);
+        velocity *= 5.0f;
+
+        float expectedDistance = FLT_MAX;
+        bool expectedHit = false;
+        for (const auto& triangle : triangles) {
+            float distance;
+            if (findParabolaTriangleIntersection(origin, velocity, acceleration, triangle, distance) && distance < expectedDistance) {
+                expectedDistance = distance;
+                expectedHit = true;
+            }
+        }
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = triangleSet.findParabolaIntersection(origin, velocity, acceleration, distance, face, triangle, true);
+        QCOMPARE(hit, expectedHit);
+        if (hit) {
+            QVERIFY(fabsf(distance - expectedDistance) < EPSILON * 100.0f);
+        }
+    }
+}
+
+void TriangleSetTests::impreciseRayHitsBounds() {
+    TriangleSet triangleSet;
+    triangleSet.insert({ glm::vec3(-1.0f, -1.0f, 5.0f), glm::vec3(1.0f, -1.0f, 5.0f), glm::vec3(0.0f, 1.0f, 5.0f) });
+
+    // without precision the triangle's bounds are hit, even where the triangle isn't
+    glm::vec3 origin(0.9f, 0.9f, 0.0f);
+    glm::vec3 direction = Vectors::UNIT_Z;
+    float distance = FLT_MAX;
+    BoxFace face;
+    Triangle triangle;
+    QVERIFY(!triangleSet.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true));
+    QVERIFY(triangleSet.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, false));
+    QCOMPARE(distance, 5.0f);
+}
@@ -0,0 +1,25 @@
+//
+//  TriangleSetTests.h
+//  tests/shared/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleSetTests_h
+#define hifi_TriangleSetTests_h
+
+#include <QtTest/QtTest>
+
+class TriangleSetTests : public QObject {
+    Q_OBJECT
+private slots:
+    void emptySet();
+    void rayMatchesBruteForce();
+    void parabolaMatchesBruteForce();
+    void impreciseRayHitsBounds();
+};
+
+#endif // hifi_TriangleSetTests_h
@@ -37,6 +37,9 @@ Oven::Oven() {
     // setup our worker threads
     setupWorkerThreads(QThread::idealThreadCount());
 
+    // the bakers share every core for texture compression, there's no render thread to leave room for
+    image::setTextureProcessingConcurrency(QThread::idealThreadCount());
+
     // Initialize dependencies for OBJ Baker
     DependencyManager::set<StatTracker>();
     DependencyManager::set<ResourceManager>(false);
@@ -0,0 +1,25 @@
+//
+//  AllocationCounter.h
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AllocationCounter_h
+#define hifi_AllocationCounter_h
+
+#include <stdint.h>
+
+// The render-bench executable replaces the global operator new / delete so the number of heap allocations made
+// while running the render engine can be reported per frame.
+// Only allocations going through operator new are seen: Qt containers that call malloc directly are not counted,
+// and on Windows allocations made inside other DLLs are not counted either.
+namespace AllocationCounter {
+    uint64_t getAllocationCount();
+    uint64_t getAllocatedBytes();
+}
+
+#endif // hifi_AllocationCounter_h
@@ -0,0 +1,185 @@
+//
+//  BenchScene.cpp
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BenchScene.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <Gzip.h>
+#include <RegisteredMetaTypes.h>
+#include <gpu/Batch.h>
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const BenchShape::Pointer& shape) {
+        return shape->key;
+    }
+
+    template <> const Item::Bound payloadGetBound(const BenchShape::Pointer& shape, RenderArgs* args) {
+        return shape->bound;
+    }
+
+    template <> void payloadRender(const BenchShape::Pointer& shape, RenderArgs* args) {
+        if (args->_batch) {
+            // What a simple shape entity records: its model transform and one draw of a unit cube
+            const uint32_t NUM_CUBE_VERTICES = 36;
+            args->_batch->setModelTransform(shape->transform);
+            args->_batch->draw(gpu::TRIANGLES, NUM_CUBE_VERTICES, 0);
+        }
+    }
+
+    template <> const ShapeKey shapeGetShapeKey(const BenchShape::Pointer& shape) {
+        return shape->shapeKey;
+    }
+}
+
+namespace {
+    struct LocalPose {
+        QString parentID;
+        glm::vec3 position;
+        glm::quat rotation;
+    };
+    using LocalPoses = QHash<QString, LocalPose>;
+
+    const int MAX_PARENT_DEPTH = 16;
+
+    // Entities exported with a parent store their position and rotation relative to that parent.
+    // Parents that are not part of the file (avatars, deleted entities) are treated as the world frame.
+    void evalWorldPose(const LocalPoses& poses, const LocalPose& pose, glm::vec3& position, glm::quat& rotation) {
+        position = pose.position;
+        rotation = pose.rotation;
+        auto parent = poses.find(pose.parentID);
+        int depth = 0;
+        while (parent != poses.end() && depth < MAX_PARENT_DEPTH) {
+            position = parent->position + parent->rotation * position;
+            rotation = parent->rotation * rotation;
+            parent = poses.find(parent->parentID);
+            ++depth;
+        }
+    }
+
+    glm::vec3 vec3Property(const QVariantMap& properties, const QString& name, const glm::vec3& defaultValue) {
+        bool valid = false;
+        glm::vec3 result = vec3FromVariant(properties.value(name), valid);
+        return valid ? result : defaultValue;
+    }
+
+    glm::quat quatProperty(const QVariantMap& properties, const QString& name) {
+        bool valid = false;
+        glm::quat result = quatFromVariant(properties.value(name), valid);
+        return valid ? result : glm::quat();
+    }
+}
+
+bool BenchScene::load(const QString& filename, QString& error) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Failed to open " + filename;
+        return false;
+    }
+    QByteArray data = file.readAll();
+    if (filename.endsWith(".gz", Qt::CaseInsensitive)) {
+        QByteArray uncompressed;
+        if (!gunzip(data, uncompressed)) {
+            error = "Failed to decompress " + filename;
+            return false;
+        }
+        data = uncompressed;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        error = "Failed to parse " + filename + ": " + parseError.errorString();
+        return false;
+    }
+    const QJsonArray entities = document.object()["Entities"].toArray();
+
+    LocalPoses poses;
+    poses.reserve(entities.size());
+    for (const auto& entity : entities) {
+        const QVariantMap properties = entity.toObject().toVariantMap();
+        LocalPose pose;
+        pose.parentID = properties.value("parentID").toString();
+        pose.position = vec3Property(properties, "position", glm::vec3(0.0f));
+        pose.rotation = quatProperty(properties, "rotation");
+        poses[properties.value("id").toString()] = pose;
+    }
+
+    const glm::vec3 DEFAULT_DIMENSIONS { 0.1f };
+    const glm::vec3 DEFAULT_REGISTRATION_POINT { 0.5f };
+
+    _shapes.clear();
+    _shapes.reserve(entities.size());
+    _bounds = AABox();
+    _numOpaqueShapes = 0;
+    _numTransparentShapes = 0;
+    _numLights = 0;
+
+    for (const auto& entity : entities) {
+        const QVariantMap properties = entity.toObject().toVariantMap();
+        const QString type = properties.value("type").toString();
+        if (type == "Zone" || type == "Material" || !properties.value("visible", true).toBool()) {
+            continue;
+        }
+
+        glm::vec3 position;
+        glm::quat rotation;
+        auto pose = poses.find(properties.value("id").toString());
+        if (pose != poses.end()) {
+            evalWorldPose(poses, pose.value(), position, rotation);
+        }
+        glm::vec3 dimensions = vec3Property(properties, "dimensions", DEFAULT_DIMENSIONS);
+        glm::vec3 registrationPoint = vec3Property(properties, "registrationPoint", DEFAULT_REGISTRATION_POINT);
+
+        auto shape = std::make_shared<BenchShape>();
+        // Meshes draw with the material pipelines, everything else with the simple ones
+        render::ShapeKey::Builder shapeKey;
+        if (type == "Model" || type == "PolyLine" || type == "PolyVox") {
+            shapeKey.withMaterial();
+        }
+        if (type == "Light") {
+            shape->key = render::ItemKey::Builder::light().build();
+            ++_numLights;
+        } else if (type == "ParticleEffect" || properties.value("alpha", 1.0f).toFloat() < 1.0f) {
+            shape->key = render::ItemKey::Builder::transparentShape().build();
+            shapeKey.withTranslucent();
+            ++_numTransparentShapes;
+        } else {
+            shape->key = render::ItemKey::Builder::opaqueShape().build();
+            ++_numOpaqueShapes;
+        }
+        shape->shapeKey = shapeKey.build();
+
+        shape->bound = AABox(-dimensions * registrationPoint, dimensions);
+        shape->bound.rotate(rotation);
+        shape->bound.translate(position);
+        shape->transform.setTranslation(position);
+        shape->transform.setRotation(rotation);
+        shape->transform.setScale(dimensions);
+
+        _bounds += shape->bound;
+        _shapes.push_back(shape);
+    }
+    return true;
+}
+
+void BenchScene::populate(const render::ScenePointer& scene) const {
+    render::Transaction transaction;
+    for (const auto& shape : _shapes) {
+        auto renderPayload = std::make_shared<render::Payload<BenchShape>>(shape);
+        transaction.resetItem(scene->allocateID(), renderPayload);
+    }
+    scene->enqueueTransaction(transaction);
+    scene->processTransactionQueue();
+}
@@ -0,0 +1,66 @@
+//
+//  BenchScene.h
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BenchScene_h
+#define hifi_BenchScene_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <AABox.h>
+#include <Transform.h>
+#include <render/Scene.h>
+#include <render/ShapePipeline.h>
+
+// A stand-in for a rendered entity: the item key and world bound are what fetch / cull / sort work from,
+// the shape key picks its pipeline and the transform is what gets recorded into the batch when the item is rendered.
+class BenchShape {
+public:
+    using Pointer = std::shared_ptr<BenchShape>;
+
+    render::ItemKey key;
+    render::ShapeKey shapeKey;
+    AABox bound;
+    Transform transform;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const BenchShape::Pointer& shape);
+    template <> const Item::Bound payloadGetBound(const BenchShape::Pointer& shape, RenderArgs* args);
+    template <> void payloadRender(const BenchShape::Pointer& shape, RenderArgs* args);
+    template <> const ShapeKey shapeGetShapeKey(const BenchShape::Pointer& shape);
+}
+
+// Loads an entities JSON file (as written by "Export Entities" or found in a domain's models.json.gz)
+// and turns every renderable entity into a BenchShape.
+// Models and other meshes are approximated by their entity bounding box, which keeps the item counts
+// and spatial distribution of the scene without needing the model files or a GPU to load them.
+class BenchScene {
+public:
+    bool load(const QString& filename, QString& error);
+
+    void populate(const render::ScenePointer& scene) const;
+
+    const AABox& getBounds() const { return _bounds; }
+    size_t getNumOpaqueShapes() const { return _numOpaqueShapes; }
+    size_t getNumTransparentShapes() const { return _numTransparentShapes; }
+    size_t getNumLights() const { return _numLights; }
+
+private:
+    std::vector<BenchShape::Pointer> _shapes;
+    AABox _bounds;
+    size_t _numOpaqueShapes { 0 };
+    size_t _numTransparentShapes { 0 };
+    size_t _numLights { 0 };
+};
+
+#endif // hifi_BenchScene_h
@@ -0,0 +1,116 @@
+//
+//  BenchTask.cpp
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BenchTask.h"
+
+#include <gpu/Context.h>
+#include <render/DrawTask.h>
+#include <shaders/Shaders.h>
+
+using namespace render;
+
+// The same variants addPlumberPipeline() in render-utils adds for each key: depth biased, wireframe and every cull mode
+static void addBenchPipeline(ShapePlumber& plumber, const ShapeKey& key, uint32_t programId) {
+    gpu::ShaderPointer program = gpu::Shader::createProgram(programId);
+
+    for (int i = 0; i < 4; i++) {
+        bool isBiased = (i & 1);
+        bool isWireframed = (i & 2);
+        for (int cullFaceMode = graphics::MaterialKey::CullFaceMode::CULL_NONE; cullFaceMode < graphics::MaterialKey::CullFaceMode::NUM_CULL_FACE_MODES; cullFaceMode++) {
+            auto state = std::make_shared<gpu::State>();
+            state->setDepthTest(true, !key.isTranslucent(), gpu::LESS_EQUAL);
+            state->setBlendFunction(key.isTranslucent(),
+                    gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::INV_SRC_ALPHA,
+                    gpu::State::FACTOR_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::ONE);
+
+            ShapeKey::Builder builder(key);
+            builder.withCullFaceMode((graphics::MaterialKey::CullFaceMode)cullFaceMode);
+            state->setCullMode((gpu::State::CullMode)cullFaceMode);
+            if (isWireframed) {
+                builder.withWireframe();
+                state->setFillMode(gpu::State::FILL_LINE);
+            }
+            if (isBiased) {
+                builder.withDepthBias();
+                state->setDepthBias(1.0f);
+                state->setDepthBiasSlopeScale(1.0f);
+            }
+            plumber.addPipeline(builder.build(), program, state);
+        }
+    }
+}
+
+void initBenchPipelines(ShapePlumber& plumber) {
+    using namespace shader::render_utils::program;
+    using Key = ShapeKey;
+
+    std::vector<std::pair<ShapeKey::Builder, uint32_t>> pipelines = {
+        // Simple
+        { Key::Builder(), simple },
+        { Key::Builder().withTranslucent(), simple_translucent },
+        { Key::Builder().withUnlit(), simple_unlit },
+        { Key::Builder().withTranslucent().withUnlit(), simple_translucent_unlit },
+
+        // Unskinned
+        { Key::Builder().withMaterial(), model },
+        { Key::Builder().withMaterial().withTangents(), model_normalmap },
+        { Key::Builder().withMaterial().withTranslucent(), model_translucent },
+        { Key::Builder().withMaterial().withTangents().withTranslucent(), model_normalmap_translucent },
+    };
+
+    for (auto& pipeline : pipelines) {
+        addBenchPipeline(plumber, pipeline.first.build(), pipeline.second);
+    }
+}
+
+void RecordBatches::run(const RenderContextPointer& renderContext, const Inputs& inputs) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    const auto& items = inputs.get0();
+    const auto& opaques = items[RenderFetchCullSortTask::OPAQUE_SHAPE].get<ItemBounds>();
+    const auto& transparents = items[RenderFetchCullSortTask::TRANSPARENT_SHAPE].get<ItemBounds>();
+
+    glm::mat4 projMat;
+    Transform viewMat;
+    args->getViewFrustum().evalProjectionMatrix(projMat);
+    args->getViewFrustum().evalViewTransform(viewMat);
+
+    gpu::doInBatch("RecordBatches::opaque", args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+        batch.setProjectionTransform(projMat);
+        batch.setViewTransform(viewMat);
+
+        renderStateSortShapes(renderContext, _shapePlumber, opaques);
+        args->_batch = nullptr;
+    });
+
+    gpu::doInBatch("RecordBatches::transparent", args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+        batch.setProjectionTransform(projMat);
+        batch.setViewTransform(viewMat);
+
+        renderShapes(renderContext, _shapePlumber, transparents);
+        args->_batch = nullptr;
+    });
+}
+
+void RenderBenchTask::build(JobModel& task, const render::Varying& inputs, render::Varying& outputs, render::CullFunctor cullFunctor) {
+    auto shapePlumber = std::make_shared<ShapePlumber>();
+    initBenchPipelines(*shapePlumber);
+
+    const auto items = task.addJob<RenderFetchCullSortTask>("FetchCullSort", cullFunctor, render::ItemKey::TAG_BITS_ALL, render::ItemKey::TAG_BITS_NONE);
+    task.addJob<RecordBatches>("RecordBatches", items, shapePlumber);
+}
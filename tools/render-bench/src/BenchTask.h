@@ -0,0 +1,47 @@
+//
+//  BenchTask.h
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BenchTask_h
+#define hifi_BenchTask_h
+
+#include <render/Engine.h>
+#include <render/RenderFetchCullSortTask.h>
+#include <render/ShapePipeline.h>
+
+// Adds the simple and unskinned model pipelines of the deferred renderer, built from the same programs and states, so
+// that picking pipelines and state sorting cost what they do in the interface.  The batch setters that bind the
+// default textures and lighting buffers are left out, as they need the texture caches.
+void initBenchPipelines(render::ShapePlumber& plumber);
+
+// Records the sorted opaque and transparent buckets into frame batches through the shape plumber, as
+// DrawStateSortDeferred and DrawDeferred do.
+class RecordBatches {
+public:
+    using Inputs = RenderFetchCullSortTask::Output;
+    using JobModel = render::Job::ModelI<RecordBatches, Inputs>;
+
+    RecordBatches(render::ShapePlumberPointer shapePlumber) : _shapePlumber(shapePlumber) {}
+
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+private:
+    render::ShapePlumberPointer _shapePlumber;
+};
+
+// The part of RenderViewTask that does not depend on GPU resources: fetch, cull and sort the scene items,
+// then build the batches from them.
+class RenderBenchTask {
+public:
+    using JobModel = render::Task::Model<RenderBenchTask>;
+
+    void build(JobModel& task, const render::Varying& inputs, render::Varying& outputs, render::CullFunctor cullFunctor);
+};
+
+#endif // hifi_BenchTask_h
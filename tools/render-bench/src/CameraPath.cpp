@@ -0,0 +1,90 @@
+//
+//  CameraPath.cpp
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CameraPath.h"
+
+#include <algorithm>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <NumericalConstants.h>
+#include <RegisteredMetaTypes.h>
+
+bool CameraPath::load(const QString& filename, QString& error) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "Failed to open " + filename;
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        error = "Failed to parse " + filename + ": " + parseError.errorString();
+        return false;
+    }
+
+    _keyframes.clear();
+    for (const auto& value : document.array()) {
+        const QVariantMap keyframe = value.toObject().toVariantMap();
+        bool validPosition = false;
+        bool validOrientation = false;
+        Keyframe result;
+        result.position = vec3FromVariant(keyframe.value("position"), validPosition);
+        result.orientation = quatFromVariant(keyframe.value("orientation"), validOrientation);
+        if (!validPosition || !validOrientation) {
+            error = "Invalid keyframe " + QString::number(_keyframes.size()) + " in " + filename;
+            return false;
+        }
+        _keyframes.push_back(result);
+    }
+
+    if (_keyframes.empty()) {
+        error = "No keyframes in " + filename;
+        return false;
+    }
+    return true;
+}
+
+void CameraPath::makeOrbit(const AABox& bounds, int numKeyframes) {
+    const float MIN_ORBIT_RADIUS = 10.0f;
+    const float EYE_HEIGHT_RATIO = 0.25f;
+
+    glm::vec3 center = bounds.isInvalid() ? glm::vec3(0.0f) : bounds.calcCenter();
+    float radius = bounds.isInvalid() ? MIN_ORBIT_RADIUS : glm::max(0.75f * bounds.getLargestDimension(), MIN_ORBIT_RADIUS);
+
+    _keyframes.clear();
+    numKeyframes = std::max(numKeyframes, 2);
+    for (int i = 0; i < numKeyframes; ++i) {
+        float angle = TWO_PI * (float)i / (float)(numKeyframes - 1);
+        glm::vec3 eye = center + glm::vec3(radius * cosf(angle), EYE_HEIGHT_RATIO * radius, radius * sinf(angle));
+        // The view matrix is the inverse of the camera pose
+        glm::mat4 view = glm::lookAt(eye, center, Vectors::UP);
+        _keyframes.push_back({ eye, glm::inverse(glm::quat_cast(view)) });
+    }
+}
+
+CameraPath::Keyframe CameraPath::evaluate(float t) const {
+    if (_keyframes.size() < 2) {
+        return _keyframes.empty() ? Keyframe { glm::vec3(0.0f), glm::quat() } : _keyframes.front();
+    }
+
+    float position = glm::clamp(t, 0.0f, 1.0f) * (float)(_keyframes.size() - 1);
+    size_t index = std::min((size_t)position, _keyframes.size() - 2);
+    float alpha = position - (float)index;
+
+    const Keyframe& from = _keyframes[index];
+    const Keyframe& to = _keyframes[index + 1];
+    return { glm::mix(from.position, to.position, alpha), safeMix(from.orientation, to.orientation, alpha) };
+}
@@ -0,0 +1,42 @@
+//
+//  CameraPath.h
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CameraPath_h
+#define hifi_CameraPath_h
+
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <AABox.h>
+#include <GLMHelpers.h>
+
+// A scripted camera: keyframes evenly spread over the run, linearly interpolated.
+class CameraPath {
+public:
+    struct Keyframe {
+        glm::vec3 position;
+        glm::quat orientation;
+    };
+
+    // Reads a JSON array of { "position": { x, y, z }, "orientation": { x, y, z, w } } keyframes.
+    bool load(const QString& filename, QString& error);
+
+    // Circles the given bounds at eye height, looking at their center.
+    void makeOrbit(const AABox& bounds, int numKeyframes);
+
+    // t goes from 0 at the first keyframe to 1 at the last.
+    Keyframe evaluate(float t) const;
+
+private:
+    std::vector<Keyframe> _keyframes;
+};
+
+#endif // hifi_CameraPath_h
@@ -0,0 +1,259 @@
+//
+//  RenderBenchApp.cpp
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RenderBenchApp.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+#include <OctreeConstants.h>
+#include <ViewFrustum.h>
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/null/NullBackend.h>
+
+#include "AllocationCounter.h"
+#include "BenchTask.h"
+
+static const int DEFAULT_NUM_FRAMES = 600;
+static const int DEFAULT_NUM_WARMUP_FRAMES = 30;
+static const int NUM_ORBIT_KEYFRAMES = 17;
+static const glm::ivec4 BENCH_VIEWPORT { 0, 0, 1920, 1080 };
+
+// Same test as LODManager::shouldRender: drop bounds whose apparent size is below the LOD angle
+static bool shouldRender(const RenderArgs* args, const AABox& bounds) {
+    auto pos = args->getViewFrustum().getPosition() - bounds.calcCenter();
+    auto halfTanAdjacentSq = glm::dot(pos, pos);
+    auto dim = bounds.getDimensions();
+    auto halfTanOppositeSq = 0.25f * glm::dot(dim, dim);
+    return halfTanOppositeSq >= args->_lodAngleHalfTanSq * halfTanAdjacentSq;
+}
+
+void RenderBenchApp::Stats::add(double value) {
+    total += value;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    ++count;
+}
+
+QJsonObject RenderBenchApp::Stats::toJson() const {
+    QJsonObject result;
+    result["avg"] = average();
+    result["min"] = count > 0 ? min : 0.0;
+    result["max"] = max;
+    return result;
+}
+
+RenderBenchApp::RenderBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless benchmark of the fetch / cull / sort / batch recording render jobs");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption sceneOption("i", "entities JSON file to load, optionally gzipped", "models.json.gz");
+    parser.addOption(sceneOption);
+
+    const QCommandLineOption pathOption("p", "camera path JSON file, the default is an orbit around the scene", "path.json");
+    parser.addOption(pathOption);
+
+    const QCommandLineOption framesOption("f", "number of measured frames", "frames", QString::number(DEFAULT_NUM_FRAMES));
+    parser.addOption(framesOption);
+
+    const QCommandLineOption warmupOption("w", "number of frames run before measuring", "frames", QString::number(DEFAULT_NUM_WARMUP_FRAMES));
+    parser.addOption(warmupOption);
+
+    const QCommandLineOption outputOption("o", "write the report as JSON to this file", "report.json");
+    parser.addOption(outputOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(sceneOption)) {
+        qCritical() << "No scene given";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    QString error;
+    _sceneFilename = parser.value(sceneOption);
+    if (!_benchScene.load(_sceneFilename, error)) {
+        qCritical() << error;
+        _returnCode = 2;
+        return;
+    }
+
+    if (parser.isSet(pathOption)) {
+        if (!_cameraPath.load(parser.value(pathOption), error)) {
+            qCritical() << error;
+            _returnCode = 2;
+            return;
+        }
+    } else {
+        _cameraPath.makeOrbit(_benchScene.getBounds(), NUM_ORBIT_KEYFRAMES);
+    }
+
+    int numFrames = std::max(parser.value(framesOption).toInt(), 1);
+    int numWarmupFrames = std::max(parser.value(warmupOption).toInt(), 0);
+
+    gpu::Context::init<gpu::null::Backend>();
+    _gpuContext = std::make_shared<gpu::Context>();
+
+    _scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE);
+    _benchScene.populate(_scene);
+
+    _renderEngine = std::make_shared<render::RenderEngine>();
+    render::CullFunctor cullFunctor = shouldRender;
+    _renderEngine->addJob<RenderBenchTask>("RenderBench", cullFunctor);
+    _renderEngine->registerScene(_scene);
+
+    for (int i = 0; i < numWarmupFrames; ++i) {
+        renderFrame((float)i / (float)std::max(numWarmupFrames - 1, 1), false);
+    }
+    for (int i = 0; i < numFrames; ++i) {
+        renderFrame((float)i / (float)std::max(numFrames - 1, 1), true);
+    }
+
+    report(parser.value(outputOption));
+}
+
+RenderBenchApp::~RenderBenchApp() {
+    _renderEngine.reset();
+    _scene.reset();
+    if (_gpuContext) {
+        _gpuContext->shutdown();
+    }
+}
+
+void RenderBenchApp::renderFrame(float t, bool record) {
+    auto keyframe = _cameraPath.evaluate(t);
+    ViewFrustum viewFrustum;
+    viewFrustum.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, (float)BENCH_VIEWPORT.z / (float)BENCH_VIEWPORT.w,
+        DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    viewFrustum.setPosition(keyframe.position);
+    viewFrustum.setOrientation(keyframe.orientation);
+    viewFrustum.calculate();
+
+    RenderArgs renderArgs(_gpuContext);
+    renderArgs._viewport = BENCH_VIEWPORT;
+    renderArgs.setViewFrustum(viewFrustum);
+    renderArgs._scene = _scene;
+
+    _gpuContext->beginFrame();
+    _scene->processTransactionQueue();
+
+    uint64_t allocationsBefore = AllocationCounter::getAllocationCount();
+    uint64_t allocatedBytesBefore = AllocationCounter::getAllocatedBytes();
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    _renderEngine->getRenderContext()->args = &renderArgs;
+    _renderEngine->run();
+
+    auto runTime = std::chrono::high_resolution_clock::now() - startTime;
+    uint64_t allocations = AllocationCounter::getAllocationCount() - allocationsBefore;
+    uint64_t allocatedBytes = AllocationCounter::getAllocatedBytes() - allocatedBytesBefore;
+
+    auto frame = _gpuContext->endFrame();
+    size_t numBatches = frame->batches.size();
+    // The null backend draws nothing, but the frame must still be consumed to keep the buffer shadow copies in sync
+    _gpuContext->executeFrame(frame);
+    _gpuContext->recycle();
+    _renderEngine->getRenderContext()->args = nullptr;
+
+    if (record) {
+        _frameTimes.add(std::chrono::duration<double, std::milli>(runTime).count());
+        _frameAllocations.add((double)allocations);
+        _frameAllocatedBytes.add((double)allocatedBytes);
+        _frameBatches.add((double)numBatches);
+        collectJobTimes(_renderEngine->getConfiguration().get(), QString());
+    }
+}
+
+void RenderBenchApp::collectJobTimes(const task::JobConfig* config, const QString& path) {
+    for (auto child : config->getSubConfigs()) {
+        auto jobConfig = static_cast<const task::JobConfig*>(child);
+        if (!jobConfig->isEnabled()) {
+            continue;
+        }
+        QString jobPath = path.isEmpty() ? jobConfig->objectName() : path + "." + jobConfig->objectName();
+        auto stats = _jobTimes.find(jobPath);
+        if (stats == _jobTimes.end()) {
+            stats = _jobTimes.emplace(jobPath, Stats()).first;
+            _jobOrder.push_back(jobPath);
+        }
+        stats->second.add(jobConfig->getCPURunTime());
+        collectJobTimes(jobConfig, jobPath);
+    }
+}
+
+void RenderBenchApp::report(const QString& outputFilename) {
+    QTextStream out(stdout);
+    out << "Scene " << _sceneFilename << ": " << _benchScene.getNumOpaqueShapes() << " opaque, "
+        << _benchScene.getNumTransparentShapes() << " transparent, " << _benchScene.getNumLights() << " lights\n";
+    out << "Backend " << QString::fromStdString(_gpuContext->getBackendVersion()) << ", " << _frameTimes.count << " frames\n";
+    out << QString("%1 %2 %3 %4\n").arg("job", -64).arg("avg ms", 10).arg("min ms", 10).arg("max ms", 10);
+    out << QString("%1 %2 %3 %4\n").arg("frame", -64).arg(_frameTimes.average(), 10, 'f', 4)
+        .arg(_frameTimes.min, 10, 'f', 4).arg(_frameTimes.max, 10, 'f', 4);
+    for (const auto& jobPath : _jobOrder) {
+        const auto& stats = _jobTimes[jobPath];
+        int depth = jobPath.count('.');
+        QString name = QString(2 * depth, ' ') + jobPath.section('.', -1);
+        out << QString("%1 %2 %3 %4\n").arg(name, -64).arg(stats.average(), 10, 'f', 4)
+            .arg(stats.min, 10, 'f', 4).arg(stats.max, 10, 'f', 4);
+    }
+    out << "Allocations per frame: " << _frameAllocations.average() << " (max " << _frameAllocations.max << "), "
+        << _frameAllocatedBytes.average() << " bytes, " << _frameBatches.average() << " batches\n";
+    out.flush();
+
+    if (outputFilename.isEmpty()) {
+        return;
+    }
+
+    QJsonObject jobs;
+    for (const auto& jobTime : _jobTimes) {
+        jobs[jobTime.first] = jobTime.second.toJson();
+    }
+    QJsonObject items;
+    items["opaque"] = (qint64)_benchScene.getNumOpaqueShapes();
+    items["transparent"] = (qint64)_benchScene.getNumTransparentShapes();
+    items["lights"] = (qint64)_benchScene.getNumLights();
+
+    QJsonObject root;
+    root["scene"] = _sceneFilename;
+    root["frames"] = _frameTimes.count;
+    root["items"] = items;
+    root["frameTime"] = _frameTimes.toJson();
+    root["frameAllocations"] = _frameAllocations.toJson();
+    root["frameAllocatedBytes"] = _frameAllocatedBytes.toJson();
+    root["frameBatches"] = _frameBatches.toJson();
+    root["jobs"] = jobs;
+
+    QFile file(outputFilename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Failed to write report to" << outputFilename;
+        _returnCode = 3;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson());
+}
@@ -0,0 +1,71 @@
+//
+//  RenderBenchApp.h
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RenderBenchApp_h
+#define hifi_RenderBenchApp_h
+
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QJsonObject>
+
+#include <gpu/Forward.h>
+#include <render/Engine.h>
+
+#include "BenchScene.h"
+#include "CameraPath.h"
+
+// Runs the CPU side of the render pipeline (fetch, cull, sort and batch recording) over a loaded scene
+// against the null gpu backend, and reports per-job timings and per-frame allocations.
+class RenderBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    RenderBenchApp(int argc, char* argv[]);
+    ~RenderBenchApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    struct Stats {
+        double total { 0.0 };
+        double min { std::numeric_limits<double>::max() };
+        double max { 0.0 };
+        int count { 0 };
+
+        void add(double value);
+        double average() const { return count > 0 ? total / (double)count : 0.0; }
+        QJsonObject toJson() const;
+    };
+
+    void renderFrame(float t, bool record);
+    void collectJobTimes(const task::JobConfig* config, const QString& path);
+    void report(const QString& outputFilename);
+
+    int _returnCode { 0 };
+
+    gpu::ContextPointer _gpuContext;
+    render::ScenePointer _scene;
+    render::EnginePointer _renderEngine;
+
+    QString _sceneFilename;
+    BenchScene _benchScene;
+    CameraPath _cameraPath;
+
+    Stats _frameTimes;
+    Stats _frameAllocations;
+    Stats _frameAllocatedBytes;
+    Stats _frameBatches;
+    std::map<QString, Stats> _jobTimes;
+    std::vector<QString> _jobOrder;
+};
+
+#endif // hifi_RenderBenchApp_h
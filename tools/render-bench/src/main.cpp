@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/render-bench/src
+//
+//  Copyright 2020 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "RenderBenchApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Render Bench");
+
+    RenderBenchApp app(argc, argv);
+    return app.getReturnCode();
+}